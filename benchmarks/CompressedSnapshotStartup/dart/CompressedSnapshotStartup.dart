@@ -0,0 +1,110 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure the size of an AOT snapshot and the time it takes to start it, with
+// and without gen_snapshot --compress-snapshot.
+
+import 'dart:io';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+const int libraryCount = 50;
+const int classesPerLibrary = 20;
+
+String generateLibrary(int library) {
+  final buffer = StringBuffer();
+  if (library + 1 < libraryCount) {
+    buffer.writeln("import 'lib${library + 1}.dart';");
+  }
+  buffer.writeln('const messages$library = <String>[');
+  for (int i = 0; i < classesPerLibrary; i++) {
+    buffer.writeln("  'Message $i of library $library, as found in a UI',");
+  }
+  buffer.writeln('];');
+  for (int i = 0; i < classesPerLibrary; i++) {
+    buffer.writeln('class C${library}_$i {');
+    buffer.writeln('  final int value;');
+    buffer.writeln('  C${library}_$i(this.value);');
+    buffer.writeln('  int add(int other) => value + other;');
+    buffer.writeln(
+      "  String describe() => '\${messages$library[$i]}: \$value';",
+    );
+    buffer.writeln('}');
+  }
+  buffer.writeln('int run$library(List<String> args) {');
+  buffer.writeln('  var result = 0;');
+  for (int i = 0; i < classesPerLibrary; i++) {
+    buffer.writeln(
+      '  result += C${library}_$i(args.length).describe().length;',
+    );
+  }
+  if (library + 1 < libraryCount) {
+    buffer.writeln('  return result + run${library + 1}(args);');
+  } else {
+    buffer.writeln('  return result;');
+  }
+  buffer.writeln('}');
+  return buffer.toString();
+}
+
+class CompressedSnapshotStartup extends BenchmarkBase {
+  final String variant;
+  final List<String> genSnapshotOptions;
+  late Directory tempDir;
+  late String snapshotPath;
+  late String aotRuntime;
+
+  CompressedSnapshotStartup(this.variant, this.genSnapshotOptions)
+    : super('CompressedSnapshotStartup.$variant');
+
+  @override
+  void setup() {
+    tempDir = Directory.systemTemp.createTempSync();
+    for (int i = 0; i < libraryCount; i++) {
+      File('${tempDir.path}/lib$i.dart').writeAsStringSync(generateLibrary(i));
+    }
+    File('${tempDir.path}/main.dart').writeAsStringSync(
+      "import 'lib0.dart';\nvoid main(List<String> args) { run0(args); }\n",
+    );
+    snapshotPath = '${tempDir.path}/main.aot';
+    final result = Process.runSync(Platform.executable, [
+      'compile',
+      'aot-snapshot',
+      for (final option in genSnapshotOptions)
+        '--extra-gen-snapshot-options=$option',
+      '-o',
+      snapshotPath,
+      '${tempDir.path}/main.dart',
+    ]);
+    if (result.exitCode != 0) {
+      throw 'Failed to compile snapshot: ${result.stderr}';
+    }
+    final binDirIndex = Platform.resolvedExecutable.lastIndexOf(
+      Platform.pathSeparator,
+    );
+    aotRuntime =
+        '${Platform.resolvedExecutable.substring(0, binDirIndex)}'
+        '${Platform.pathSeparator}dartaotruntime';
+    final size = File(snapshotPath).lengthSync();
+    print('CompressedSnapshotStartup.$variant(CodeSize): $size');
+  }
+
+  @override
+  void teardown() {
+    tempDir.deleteSync(recursive: true);
+  }
+
+  @override
+  void run() {
+    final result = Process.runSync(aotRuntime, [snapshotPath]);
+    if (result.exitCode != 0) {
+      throw 'Program failed: ${result.stderr}';
+    }
+  }
+}
+
+void main() {
+  CompressedSnapshotStartup('Uncompressed', []).report();
+  CompressedSnapshotStartup('Compressed', ['--compress-snapshot']).report();
+}
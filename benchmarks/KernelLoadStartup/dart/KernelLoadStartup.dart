@@ -0,0 +1,91 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure the time it takes to start a JIT-mode program from a kernel binary
+// with many libraries, loading the kernel on the main thread only and with
+// the help of --kernel_loading_tasks.
+
+import 'dart:io';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+const int libraryCount = 200;
+const int classesPerLibrary = 20;
+
+String generateLibrary(int library) {
+  final buffer = StringBuffer();
+  if (library + 1 < libraryCount) {
+    buffer.writeln("import 'lib${library + 1}.dart';");
+  }
+  for (int i = 0; i < classesPerLibrary; i++) {
+    buffer.writeln('/// Documentation of class C${library}_$i, long enough to');
+    buffer.writeln('/// make the sources a large part of the kernel binary.');
+    buffer.writeln('class C${library}_$i {');
+    buffer.writeln('  final int value;');
+    buffer.writeln('  C${library}_$i(this.value);');
+    buffer.writeln('  int add(int other) => value + other;');
+    buffer.writeln("  String describe() => 'C${library}_$i(\$value)';");
+    buffer.writeln('}');
+  }
+  buffer.writeln('int run$library() {');
+  if (library + 1 < libraryCount) {
+    buffer.writeln('  return C${library}_0(1).add(run${library + 1}());');
+  } else {
+    buffer.writeln('  return C${library}_0(1).value;');
+  }
+  buffer.writeln('}');
+  return buffer.toString();
+}
+
+class KernelLoadStartup extends BenchmarkBase {
+  final List<String> vmOptions;
+  late Directory tempDir;
+  late String dillPath;
+
+  KernelLoadStartup(String name, this.vmOptions)
+    : super('KernelLoadStartup.$name');
+
+  @override
+  void setup() {
+    tempDir = Directory.systemTemp.createTempSync();
+    for (int i = 0; i < libraryCount; i++) {
+      File('${tempDir.path}/lib$i.dart').writeAsStringSync(generateLibrary(i));
+    }
+    File(
+      '${tempDir.path}/main.dart',
+    ).writeAsStringSync("import 'lib0.dart';\nvoid main() { run0(); }\n");
+    dillPath = '${tempDir.path}/main.dill';
+    final result = Process.runSync(Platform.executable, [
+      'compile',
+      'kernel',
+      '-o',
+      dillPath,
+      '${tempDir.path}/main.dart',
+    ]);
+    if (result.exitCode != 0) {
+      throw 'Failed to compile kernel: ${result.stderr}';
+    }
+  }
+
+  @override
+  void teardown() {
+    tempDir.deleteSync(recursive: true);
+  }
+
+  @override
+  void run() {
+    final result = Process.runSync(Platform.executable, [
+      ...vmOptions,
+      dillPath,
+    ]);
+    if (result.exitCode != 0) {
+      throw 'Program failed: ${result.stderr}';
+    }
+  }
+}
+
+void main() {
+  KernelLoadStartup('MainThread', ['--kernel_loading_tasks=0']).report();
+  KernelLoadStartup('Parallel', []).report();
+}
@@ -5,6 +5,8 @@
 // Reports the sizes of binary artifacts shipped with the SDK.
 
 import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
 
 const executables = <String>['dart', 'dartaotruntime'];
 
@@ -35,6 +37,41 @@ void reportFileSize(String path, String name) {
   }
 }
 
+// Compressed AOT snapshots (see gen_snapshot --compress-snapshot) consist of a
+// header followed by the snapshot compressed in chunks of this size.
+const compressedSnapshotChunkSize = 1024 * 1024;
+const compressedSnapshotHeaderSize = 32;
+const elfMagic = <int>[0x7f, 0x45, 0x4c, 0x46];
+
+bool isElf(Uint8List bytes) {
+  if (bytes.length < elfMagic.length) return false;
+  for (var i = 0; i < elfMagic.length; i++) {
+    if (bytes[i] != elfMagic[i]) return false;
+  }
+  return true;
+}
+
+// Reports the size an ELF snapshot would have if it were compressed.
+void reportCompressedSnapshotSize(String path, String name) {
+  Uint8List bytes;
+  try {
+    bytes = File(path).readAsBytesSync();
+  } on FileSystemException {
+    bytes = Uint8List(0);
+  }
+  // Report dummy data for snapshots that are not ELF snapshots.
+  var size = 0;
+  if (isElf(bytes)) {
+    final codec = ZLibCodec(level: ZLibOption.maxLevel);
+    size = compressedSnapshotHeaderSize;
+    for (var i = 0; i < bytes.length; i += compressedSnapshotChunkSize) {
+      final end = min(i + compressedSnapshotChunkSize, bytes.length);
+      size += 8 + codec.encode(Uint8List.sublistView(bytes, i, end)).length;
+    }
+  }
+  print('SDKArtifactSizes.$name.compressed(CodeSize): $size');
+}
+
 void reportDirectorySize(String path, String name) async {
   final dir = Directory(path);
 
@@ -75,6 +112,7 @@ void main() {
     final snapshotPath =
         '$rootDir/dart-sdk/bin/snapshots/$snapshot.dart.snapshot';
     reportFileSize(snapshotPath, snapshot);
+    reportCompressedSnapshotSize(snapshotPath, snapshot);
   }
 
   for (final resource in resources) {
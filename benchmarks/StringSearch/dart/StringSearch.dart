@@ -0,0 +1,62 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure performance of searching for and comparing substrings of long
+// one-byte strings, as done when routing requests and parsing headers.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+int matchCount = 0;
+
+String generateLongString(int lengthPower, String suffix) {
+  return 'abcdefgh' * (1 << lengthPower) + suffix;
+}
+
+class StringSearchIndexOf extends BenchmarkBase {
+  final int reps;
+  final String haystack;
+  final String needle;
+
+  StringSearchIndexOf(int lengthPower, this.reps)
+    : haystack = generateLongString(lengthPower, 'needle'),
+      needle = 'abcdefgh' * 3 + 'needle',
+      super('StringSearch.IndexOf.${8 << lengthPower}.${reps}reps');
+
+  @override
+  void run() {
+    for (int i = 0; i < reps; i++) {
+      if (haystack.indexOf(needle) >= 0) {
+        matchCount++;
+      }
+    }
+  }
+}
+
+class StringSearchStartsWith extends BenchmarkBase {
+  final int reps;
+  final String string;
+  final String prefix;
+
+  StringSearchStartsWith(int lengthPower, this.reps)
+    : string = generateLongString(lengthPower, '.'),
+      prefix = generateLongString(lengthPower, '!'),
+      super('StringSearch.StartsWith.${8 << lengthPower}.${reps}reps');
+
+  @override
+  void run() {
+    for (int i = 0; i < reps; i++) {
+      if (string.startsWith(prefix) || string.endsWith(prefix)) {
+        matchCount++;
+      }
+    }
+  }
+}
+
+void main() {
+  StringSearchIndexOf(3, 1000).report();
+  StringSearchIndexOf(8, 30).report();
+  StringSearchStartsWith(3, 3000).report();
+  StringSearchStartsWith(10, 300).report();
+  if (matchCount == 0) throw StateError('Unexpected matchCount: $matchCount');
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:isolate' hide Isolate;
+
+import '../common/test_helper.dart';
+
+const int messageCount = 10;
+
+// Handles messages that schedule microtasks, so that queueing, handling and
+// draining the microtask queue are all recorded.
+Future<void> warmup() {
+  final done = Completer<void>();
+  final port = RawReceivePort();
+  port.handler = (int i) {
+    scheduleMicrotask(() {
+      if (i == messageCount - 1) {
+        port.close();
+        done.complete();
+      }
+    });
+  };
+  for (int i = 0; i < messageCount; i++) {
+    port.sendPort.send(i);
+  }
+  return done.future;
+}
+
+Future<void> main([List<String> args = const <String>[]]) {
+  return startServiceTest(testeeBefore: warmup);
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:test/test.dart';
+import 'package:vm_service/vm_service.dart';
+
+import '../common/service_test_common.dart';
+import 'get_event_loop_latency_rpc_lib.dart' as testee_lib;
+
+void main([args = const <String>[]]) => IsolateTestHarness(
+      'get_event_loop_latency_rpc_lib.dart',
+      args,
+    ).addCustomTest((VmService service, IsolateRef isolateRef) async {
+      final isolateId = isolateRef.id!;
+      final result = (await service.callMethod(
+        '_getEventLoopLatency',
+        isolateId: isolateId,
+      ))
+          .json!;
+      expect(result['type'], equals('_EventLoopLatency'));
+      for (final name in [
+        'messageQueueLatency',
+        'messageHandlerTime',
+        'microtaskDrainTime',
+      ]) {
+        final histogram = result[name];
+        expect(histogram['type'], equals('_LatencyHistogram'));
+        expect(
+          histogram['count'],
+          greaterThanOrEqualTo(testee_lib.messageCount),
+          reason: name,
+        );
+      }
+    }).run(
+      testeeMain: testee_lib.main,
+      extraArgs: ['--record-event-loop-latency'],
+    );
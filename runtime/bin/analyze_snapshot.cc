@@ -2,6 +2,11 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
 #include "bin/error_exit.h"
 #include "bin/file.h"
 #include "bin/snapshot_utils.h"
@@ -15,16 +20,20 @@
 
 #ifdef SUPPORT_ANALYZE_SNAPSHOT
 #include "include/analyze_snapshot_api.h"
+#include "include/dart_tools_api.h"
 #endif
 
 namespace dart {
 namespace bin {
 #ifdef SUPPORT_ANALYZE_SNAPSHOT
-#define STRING_OPTIONS_LIST(V) V(out, out_path)
+#define STRING_OPTIONS_LIST(V)                                                 \
+  V(out, out_path)                                                             \
+  V(load_report, load_report_path)
 
 #define BOOL_OPTIONS_LIST(V)                                                   \
   V(help, help)                                                                \
-  V(sdk_version, sdk_version)
+  V(sdk_version, sdk_version)                                                  \
+  V(diff_load_reports, diff_load_reports)
 
 #define STRING_OPTION_DEFINITION(flag, variable)                               \
   static const char* variable = nullptr;                                       \
@@ -42,6 +51,7 @@ BOOL_OPTIONS_LIST(BOOL_OPTION_DEFINITION)
 static void PrintUsage() {
   Syslog::PrintErr(
 "Usage: analyze_snapshot [<vm-flags>] [<options>] <snapshot_data>            \n"
+"       analyze_snapshot --diff_load_reports <old_report> <new_report>       \n"
 "                                                                            \n"
 "Common options:                                                             \n"
 "--help                                                                      \n"
@@ -50,6 +60,13 @@ static void PrintUsage() {
 "  Print the SDK version.                                                    \n"
 "--out                                                                       \n"
 "  Path to generate the analysis results JSON.                               \n"
+"--load_report                                                               \n"
+"  Path to write the snapshot load report JSON to, listing the objects,      \n"
+"  bytes and load time of each cluster of the snapshot.                      \n"
+"--diff_load_reports                                                         \n"
+"  Compare two snapshot load reports, written by --load_report or by a VM    \n"
+"  run with --write_snapshot_load_report_to, and print the clusters whose    \n"
+"  size or load time changed.                                                \n"
 "If omitting [<vm-flags>] the VM parsing the snapshot is created with the    \n"
 "following default flags:                                                    \n"
 "--enable_mirrors=false                                                      \n"
@@ -97,6 +114,13 @@ static int ParseArguments(int argc,
   }
 
   // Verify consistency of arguments.
+  if (diff_load_reports) {
+    if (inputs->count() != 2) {
+      Syslog::PrintErr("--diff_load_reports requires two reports\n");
+      return -1;
+    }
+    return 0;
+  }
   if (inputs->count() < 1) {
     Syslog::PrintErr("At least one input is required\n");
     return -1;
@@ -133,6 +157,315 @@ static void WriteFile(const char* filename,
   }
 }
 
+// A parsed JSON value, sufficient for reading snapshot load reports.
+struct JSONValue {
+  enum Kind { kNull, kBool, kNumber, kString, kArray, kObject };
+  Kind kind = kNull;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  // Property names of an object.
+  std::vector<std::string> keys;
+  // Elements of an array, or property values of an object.
+  std::vector<JSONValue> values;
+
+  const JSONValue* Get(const char* key) const {
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (keys[i] == key) return &values[i];
+    }
+    return nullptr;
+  }
+  int64_t GetInt(const char* key) const {
+    const JSONValue* value = Get(key);
+    return (value != nullptr && value->kind == kNumber)
+               ? static_cast<int64_t>(value->number)
+               : 0;
+  }
+  const char* GetString(const char* key) const {
+    const JSONValue* value = Get(key);
+    return (value != nullptr && value->kind == kString) ? value->string.c_str()
+                                                        : "";
+  }
+  bool GetBool(const char* key) const {
+    const JSONValue* value = Get(key);
+    return value != nullptr && value->kind == kBool && value->boolean;
+  }
+};
+
+class JSONParser {
+ public:
+  JSONParser(const char* json, intptr_t length)
+      : current_(json), end_(json + length) {}
+
+  bool Parse(JSONValue* value) {
+    if (!ParseValue(value)) return false;
+    SkipWhitespace();
+    return current_ == end_;
+  }
+
+ private:
+  void SkipWhitespace() {
+    while (current_ < end_ && (*current_ == ' ' || *current_ == '\n' ||
+                               *current_ == '\r' || *current_ == '\t')) {
+      current_++;
+    }
+  }
+
+  bool Consume(const char* literal) {
+    const intptr_t length = strlen(literal);
+    if (end_ - current_ < length || strncmp(current_, literal, length) != 0) {
+      return false;
+    }
+    current_ += length;
+    return true;
+  }
+
+  bool ParseString(std::string* result) {
+    if (!Consume("\"")) return false;
+    while (current_ < end_ && *current_ != '"') {
+      char c = *current_++;
+      if (c == '\\') {
+        if (current_ == end_) return false;
+        c = *current_++;
+        switch (c) {
+          case 'n':
+            c = '\n';
+            break;
+          case 'r':
+            c = '\r';
+            break;
+          case 't':
+            c = '\t';
+            break;
+          case 'b':
+            c = '\b';
+            break;
+          case 'f':
+            c = '\f';
+            break;
+          case 'u': {
+            // Names in the report are ASCII, non-ASCII code units are only
+            // kept as placeholders.
+            if (end_ - current_ < 4) return false;
+            current_ += 4;
+            c = '?';
+            break;
+          }
+          default:
+            break;
+        }
+      }
+      result->push_back(c);
+    }
+    return Consume("\"");
+  }
+
+  bool ParseValue(JSONValue* value) {
+    SkipWhitespace();
+    if (current_ == end_) return false;
+    switch (*current_) {
+      case '{': {
+        current_++;
+        value->kind = JSONValue::kObject;
+        SkipWhitespace();
+        if (Consume("}")) return true;
+        do {
+          SkipWhitespace();
+          value->keys.emplace_back();
+          if (!ParseString(&value->keys.back())) return false;
+          SkipWhitespace();
+          if (!Consume(":")) return false;
+          value->values.emplace_back();
+          if (!ParseValue(&value->values.back())) return false;
+          SkipWhitespace();
+        } while (Consume(","));
+        return Consume("}");
+      }
+      case '[': {
+        current_++;
+        value->kind = JSONValue::kArray;
+        SkipWhitespace();
+        if (Consume("]")) return true;
+        do {
+          value->values.emplace_back();
+          if (!ParseValue(&value->values.back())) return false;
+          SkipWhitespace();
+        } while (Consume(","));
+        return Consume("]");
+      }
+      case '"':
+        value->kind = JSONValue::kString;
+        return ParseString(&value->string);
+      case 't':
+        value->kind = JSONValue::kBool;
+        value->boolean = true;
+        return Consume("true");
+      case 'f':
+        value->kind = JSONValue::kBool;
+        return Consume("false");
+      case 'n':
+        return Consume("null");
+      default: {
+        value->kind = JSONValue::kNumber;
+        char* number_end = nullptr;
+        value->number = strtod(current_, &number_end);
+        if (number_end == current_ || number_end > end_) return false;
+        current_ = number_end;
+        return true;
+      }
+    }
+  }
+
+  const char* current_;
+  const char* const end_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONParser);
+};
+
+// The statistics of one cluster of a snapshot load report.
+struct LoadReportRow {
+  int64_t objects = 0;
+  int64_t snapshot_bytes = 0;
+  int64_t heap_bytes = 0;
+  int64_t micros = 0;
+
+  void Add(const JSONValue& cluster) {
+    objects += cluster.GetInt("objects");
+    snapshot_bytes += cluster.GetInt("snapshotBytes");
+    heap_bytes += cluster.GetInt("heapBytes");
+    micros += cluster.GetInt("allocMicros") + cluster.GetInt("fillMicros") +
+              cluster.GetInt("postLoadMicros");
+  }
+};
+
+struct LoadReport {
+  // Rows keyed by isolate group, loading unit and cluster. Clusters with the
+  // same key, e.g. from isolate groups loaded more than once, are summed up.
+  std::map<std::string, LoadReportRow> rows;
+  LoadReportRow totals;
+  int64_t load_micros = 0;
+};
+
+static bool ReadLoadReport(const char* filename, LoadReport* report) {
+  File* file = File::Open(nullptr, filename, File::kRead);
+  if (file == nullptr) {
+    Syslog::PrintErr("Error: Unable to read file: %s\n", filename);
+    return false;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if (length < 0) {
+    Syslog::PrintErr("Error: Unable to read file: %s\n", filename);
+    return false;
+  }
+  std::string contents(length, '\0');
+  if (!file->ReadFully(&contents[0], length)) {
+    Syslog::PrintErr("Error: Unable to read file: %s\n", filename);
+    return false;
+  }
+
+  JSONValue root;
+  JSONParser parser(contents.data(), contents.size());
+  const JSONValue* loads = nullptr;
+  if (parser.Parse(&root)) {
+    loads = root.Get("loads");
+  }
+  if (loads == nullptr || loads->kind != JSONValue::kArray) {
+    Syslog::PrintErr("Error: Not a snapshot load report: %s\n", filename);
+    return false;
+  }
+
+  for (const JSONValue& load : loads->values) {
+    const JSONValue* clusters = load.Get("clusters");
+    if (clusters == nullptr) continue;
+    char prefix[256];
+    snprintf(prefix, sizeof(prefix), "%s unit %" Pd64 " ",
+             load.GetString("isolateGroup"), load.GetInt("loadingUnit"));
+    for (const JSONValue& cluster : clusters->values) {
+      std::string key(prefix);
+      key += cluster.GetString("name");
+      if (cluster.Get("class") != nullptr) {
+        key += " (";
+        key += cluster.GetString("class");
+        key += ")";
+      }
+      if (cluster.GetBool("canonical")) {
+        key += " canonical";
+      }
+      report->rows[key].Add(cluster);
+      report->totals.Add(cluster);
+    }
+    const JSONValue* totals = load.Get("totals");
+    if (totals != nullptr) {
+      report->load_micros += totals->GetInt("loadMicros");
+    }
+  }
+  return true;
+}
+
+static void PrintLoadReportRow(const char* name,
+                               const LoadReportRow& before,
+                               const LoadReportRow& after) {
+  Syslog::Print("%10" Pd64 " %10" Pd64 " %+10" Pd64 " %+10" Pd64
+                " %+12" Pd64 " %+12" Pd64 "  %s\n",
+                before.micros, after.micros, after.micros - before.micros,
+                after.objects - before.objects,
+                after.snapshot_bytes - before.snapshot_bytes,
+                after.heap_bytes - before.heap_bytes, name);
+}
+
+// Prints the clusters whose size or load time differs between two snapshot
+// load reports, the largest change in load time first.
+static int DiffLoadReports(const char* before_path, const char* after_path) {
+  LoadReport before;
+  LoadReport after;
+  if (!ReadLoadReport(before_path, &before) ||
+      !ReadLoadReport(after_path, &after)) {
+    return kErrorExitCode;
+  }
+
+  std::vector<std::string> keys;
+  for (const auto& it : before.rows) {
+    keys.push_back(it.first);
+  }
+  for (const auto& it : after.rows) {
+    if (before.rows.find(it.first) == before.rows.end()) {
+      keys.push_back(it.first);
+    }
+  }
+  auto delta = [&](const std::string& key) {
+    return Utils::Abs<int64_t>(after.rows[key].micros - before.rows[key].micros);
+  };
+  auto bytes_delta = [&](const std::string& key) {
+    return Utils::Abs<int64_t>(after.rows[key].snapshot_bytes -
+                               before.rows[key].snapshot_bytes);
+  };
+  std::stable_sort(keys.begin(), keys.end(),
+                   [&](const std::string& a, const std::string& b) {
+                     if (delta(a) != delta(b)) return delta(a) > delta(b);
+                     return bytes_delta(a) > bytes_delta(b);
+                   });
+
+  Syslog::Print("%10s %10s %10s %10s %12s %12s  %s\n", "old us", "new us",
+                "delta us", "objects", "snapshot", "heap", "cluster");
+  for (const std::string& key : keys) {
+    const LoadReportRow& old_row = before.rows[key];
+    const LoadReportRow& new_row = after.rows[key];
+    if (old_row.micros == new_row.micros &&
+        old_row.objects == new_row.objects &&
+        old_row.snapshot_bytes == new_row.snapshot_bytes &&
+        old_row.heap_bytes == new_row.heap_bytes) {
+      continue;
+    }
+    PrintLoadReportRow(key.c_str(), old_row, new_row);
+  }
+  PrintLoadReportRow("total (clusters)", before.totals, after.totals);
+  Syslog::Print("%10" Pd64 " %10" Pd64 " %+10" Pd64 "  total (loads)\n",
+                before.load_micros, after.load_micros,
+                after.load_micros - before.load_micros);
+  return 0;
+}
+
 int RunAnalyzer(int argc, char** argv) {
   // Constant mirrors gen_snapshot binary, subject to change.
   const int EXTRA_VM_ARGUMENTS = 7;
@@ -143,7 +476,10 @@ int RunAnalyzer(int argc, char** argv) {
     PrintUsage();
     return kErrorExitCode;
   }
-  if (out_path == nullptr) {
+  if (diff_load_reports) {
+    return DiffLoadReports(inputs.GetArgument(0), inputs.GetArgument(1));
+  }
+  if (out_path == nullptr && load_report_path == nullptr) {
     Syslog::PrintErr("No output path provided.\n");
     return kErrorExitCode;
   }
@@ -155,6 +491,9 @@ int RunAnalyzer(int argc, char** argv) {
     vm_options.AddArgument("--background_compilation");
     vm_options.AddArgument("--precompilation");
   }
+  if (load_report_path != nullptr) {
+    vm_options.AddArgument("--record_snapshot_load_report");
+  }
 
   char* error = Dart_SetVMFlags(vm_options.count(), vm_options.arguments());
   if (error != nullptr) {
@@ -209,18 +548,26 @@ int RunAnalyzer(int argc, char** argv) {
     return kErrorExitCode;
   }
 
-  dart::snapshot_analyzer::Dart_SnapshotAnalyzerInformation info = {
-      snapshot_data, snapshot_text};
+  Dart_EnterScope();
+  if (load_report_path != nullptr) {
+    char* report = Dart_GetSnapshotLoadReport();
+    WriteFile(load_report_path, report, strlen(report));
+    free(report);
+  }
 
-  char* out = nullptr;
-  intptr_t out_len = 0;
+  if (out_path != nullptr) {
+    dart::snapshot_analyzer::Dart_SnapshotAnalyzerInformation info = {
+        snapshot_data, snapshot_text};
 
-  Dart_EnterScope();
-  Dart_DumpSnapshotInformationAsJson(info, &out, &out_len);
-  WriteFile(out_path, out, out_len);
+    char* out = nullptr;
+    intptr_t out_len = 0;
+
+    Dart_DumpSnapshotInformationAsJson(info, &out, &out_len);
+    WriteFile(out_path, out, out_len);
 
-  // Since ownership of the JSON buffer is ours, free before we exit.
-  free(out);
+    // Since ownership of the JSON buffer is ours, free before we exit.
+    free(out);
+  }
 
   Dart_ExitScope();
   Dart_ShutdownIsolate();
@@ -26,6 +26,9 @@ dart::SimpleHashMap* DartUtils::environment_ = nullptr;
 
 MagicNumberData appjit_magic_number = {8, {0xdc, 0xdc, 0xf6, 0xf6, 0, 0, 0, 0}};
 MagicNumberData aotelf_magic_number = {4, {0x7F, 0x45, 0x4C, 0x46, 0x0}};
+MagicNumberData aotcompressed_magic_number = {
+    8,
+    {0xdc, 0xdc, 0xf6, 0xf6, 0x7a, 0x61, 0x6f, 0x74}};  // ....zaot
 MagicNumberData aotpe_magic_number = {2, {0x4d, 0x5a}};
 MagicNumberData aotcoff_arm32_magic_number = {2, {0x01, 0xC0}};
 MagicNumberData aotcoff_arm64_magic_number = {2, {0xAA, 0x64}};
@@ -365,6 +368,7 @@ DartUtils::MagicNumber DartUtils::SniffForMagicNumber(const char* filename) {
   MagicNumber magic_number = DartUtils::kUnknownMagicNumber;
   ASSERT(kMaxMagicNumberSize == appjit_magic_number.length);
   ASSERT(aotelf_magic_number.length <= appjit_magic_number.length);
+  ASSERT(aotcompressed_magic_number.length <= appjit_magic_number.length);
   ASSERT(static_cast<intptr_t>(sizeof(mach_o::mach_header::magic)) <=
          appjit_magic_number.length);
   ASSERT(aotpe_magic_number.length <= appjit_magic_number.length);
@@ -415,6 +419,10 @@ DartUtils::MagicNumber DartUtils::SniffForMagicNumber(const uint8_t* buffer,
     return kAotELFMagicNumber;
   }
 
+  if (CheckMagicNumber(buffer, buffer_length, aotcompressed_magic_number)) {
+    return kAotCompressedMagicNumber;
+  }
+
   // Mach-O magic numbers are reported by whether the endianness of the file
   // matches the endianness of the system. Here, we only bother looking for
   // host-endian magic numbers, as our Mach-O parsing code won't handle the
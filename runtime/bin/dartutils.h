@@ -284,6 +284,7 @@ class DartUtils {
     kBytecodeMagicNumber,
     kGzipMagicNumber,
     kAotELFMagicNumber,
+    kAotCompressedMagicNumber,
     // Only the host-endian magic numbers are recognized, not the reverse-endian
     // ("cigam") ones, as we can't load a reverse-endian snapshot anyway.
     kAotMachO32MagicNumber,
@@ -703,6 +704,7 @@ struct MagicNumberData {
 
 extern MagicNumberData appjit_magic_number;
 extern MagicNumberData aotelf_magic_number;
+extern MagicNumberData aotcompressed_magic_number;
 extern MagicNumberData kernel_magic_number;
 extern MagicNumberData kernel_list_magic_number;
 extern MagicNumberData gzip_magic_number;
@@ -119,6 +119,7 @@ static const char* const kSnapshotKindNames[] = {
 
 #define BOOL_OPTIONS_LIST(V)                                                   \
   V(compile_all, compile_all)                                                  \
+  V(compress_snapshot, compress_snapshot)                                      \
   V(help, help)                                                                \
   V(obfuscate, obfuscate)                                                      \
   V(strip, strip)                                                              \
@@ -181,8 +182,12 @@ static void PrintUsage() {
 "[--obfuscate]                                                               \n"
 "[--save-debugging-info=<debug-filename>]                                    \n"
 "[--save-obfuscation-map=<map-filename>]                                     \n"
+"[--compress-snapshot]                                                       \n"
 "<dart-kernel-file>                                                          \n"
 "                                                                            \n"
+"A compressed ELF snapshot is smaller but can only be run by dartaotruntime,  \n"
+"which decompresses it in memory when it is loaded.                          \n"
+"                                                                            \n"
 "To create an AOT application snapshot as an Mach-O dynamic library (dylib): \n"
 "--snapshot_kind=app-aot-macho-dylib                                         \n"
 "--macho=<output-file>                                                       \n"
@@ -347,6 +352,20 @@ static int ParseArguments(int argc,
       break;
   }
 
+  if (compress_snapshot) {
+    if (snapshot_kind != kAppAOTElf) {
+      Syslog::PrintErr(
+          "--compress-snapshot is only supported when building an AOT "
+          "snapshot as ELF.\n\n");
+      return -1;
+    }
+    if (loading_unit_manifest_filename != nullptr) {
+      Syslog::PrintErr(
+          "--compress-snapshot does not support --loading_unit_manifest.\n\n");
+      return -1;
+    }
+  }
+
   if (!obfuscate && obfuscation_map_filename != nullptr) {
     Syslog::PrintErr(
         "--save-obfuscation_map=<...> should only be specified when "
@@ -535,6 +554,14 @@ static void StreamingWriteCallback(void* callback_data,
   }
 }
 
+// Collects the snapshot in memory so that it can be compressed before it is
+// written (see --compress-snapshot).
+static void BufferingWriteCallback(void* callback_data,
+                                   const uint8_t* buffer,
+                                   intptr_t size) {
+  reinterpret_cast<TextBuffer*>(callback_data)->AddRaw(buffer, size);
+}
+
 static void StreamingCloseCallback(void* callback_data) {
   File* file = reinterpret_cast<File*>(callback_data);
   file->Release();
@@ -725,6 +752,20 @@ static void CreateAndWritePrecompiledSnapshot() {
           format, StreamingWriteCallback, file, object_file, strip, debug_file,
           identifier, object_filename);
       object_file->Release();
+    } else if (compress_snapshot) {
+      TextBuffer elf(1 * MB);
+      result = Dart_CreateAppAOTSnapshotAsBinary(format, BufferingWriteCallback,
+                                                 &elf, strip, debug_file,
+                                                 identifier, filename);
+      if (!Dart_IsError(result)) {
+        uint8_t* compressed = nullptr;
+        intptr_t compressed_size = 0;
+        Snapshot::CompressAppAOTSnapshot(
+            reinterpret_cast<const uint8_t*>(elf.buffer()), elf.length(),
+            &compressed, &compressed_size);
+        StreamingWriteCallback(file, compressed, compressed_size);
+        free(compressed);
+      }
     } else {
       result = Dart_CreateAppAOTSnapshotAsBinary(format, StreamingWriteCallback,
                                                  file, strip, debug_file,
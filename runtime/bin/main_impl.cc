@@ -66,6 +66,8 @@ const uint8_t* core_snapshot_text =
  *       <script_uri> [<script_options>]
  * To Run the application snapshot generated above, use :
  *   dart <app_snapshot_filename> [<script_options>]
+ * With --incremental-snapshot, the training run is skipped if the libraries
+ * of the program did not change since the snapshot was generated.
  */
 static bool vm_run_app_snapshot = false;
 static char* app_script_uri = nullptr;
@@ -75,6 +77,18 @@ static bool kernel_isolate_is_running = false;
 
 static Dart_Isolate main_isolate = nullptr;
 
+// The library fingerprints of the program an app JIT snapshot is generated
+// for with --incremental-snapshot, computed before the training run.
+static char* app_jit_library_fingerprints = nullptr;
+
+static void GenerateAppJIT() {
+  Snapshot::GenerateAppJIT(Options::snapshot_filename());
+  if (app_jit_library_fingerprints != nullptr) {
+    Snapshot::WriteLibraryFingerprints(Options::snapshot_filename(),
+                                       app_jit_library_fingerprints);
+  }
+}
+
 #if defined(DART_PRECOMPILED_RUNTIME) && defined(DART_CLI_RUNTIME) &&          \
     defined(DART_HOST_OS_LINUX)
 static CStringUniquePtr BuildCliSnapshotPath(const char* executable_path,
@@ -195,7 +209,7 @@ static void OnExitHook(int64_t exit_code) {
     }
     if (exit_code == 0) {
       if (Options::gen_snapshot_kind() == kAppJIT) {
-        Snapshot::GenerateAppJIT(Options::snapshot_filename());
+        GenerateAppJIT();
       }
       WriteDepsFile();
     }
@@ -1179,6 +1193,20 @@ void RunMainIsolate(const char* script_name,
               script_name);
   }
 
+  if (Options::incremental_snapshot()) {
+    app_jit_library_fingerprints = Snapshot::LibraryFingerprints(dart_options);
+    if (Snapshot::IsAppJITSnapshotUpToDate(Options::snapshot_filename(),
+                                           app_jit_library_fingerprints)) {
+      Syslog::Print("App JIT snapshot '%s' is up to date, skipping training.\n",
+                    Options::snapshot_filename());
+      // The build system still expects the depfile of the kept snapshot.
+      WriteDepsFile();
+      Dart_ExitScope();
+      Dart_ShutdownIsolate();
+      return;
+    }
+  }
+
   // Create a closure for the main entry point which is in the exported
   // namespace of the root library or invoke a getter of the same name
   // in the exported namespace and return the resulting closure.
@@ -1209,7 +1237,7 @@ void RunMainIsolate(const char* script_name,
   // Generate an app snapshot after execution if specified.
   if (Options::gen_snapshot_kind() == kAppJIT) {
     if (!Dart_IsCompilationError(result)) {
-      Snapshot::GenerateAppJIT(Options::snapshot_filename());
+      GenerateAppJIT();
     }
   }
   CHECK_RESULT(result);
@@ -1407,6 +1435,20 @@ void main(int argc, char** argv) {
       }
       vm_run_app_snapshot = true;
       app_snapshot->SetBuffers(&app_snapshot_data, &app_snapshot_text);
+      if (Options::prefetch_snapshot_text() != nullptr) {
+        // The byte count is printed by gen_snapshot --startup_code_order.
+        const char* value = Options::prefetch_snapshot_text();
+        char* end = nullptr;
+        errno = 0;
+        const int64_t length = strtoll(value, &end, /*base=*/10);
+        if ((errno != 0) || (end == value) || (*end != '\0') ||
+            (length < 0)) {
+          Syslog::PrintErr("Invalid --prefetch_snapshot_text value: %s\n",
+                           value);
+          Platform::Exit(kErrorExitCode);
+        }
+        Snapshot::PrefetchText(app_snapshot_text, length);
+      }
     } else if (app_snapshot == nullptr && Dart_IsPrecompiledRuntime()) {
       Syslog::PrintErr(
           "%s is not an AOT snapshot,"
@@ -1573,6 +1615,7 @@ void main(int argc, char** argv) {
 
   delete app_snapshot;
   free(app_script_uri);
+  free(app_jit_library_fingerprints);
   asset_resolution_base.reset();
 
   DeleteTempDirOnShutdown();
@@ -273,6 +273,11 @@ bool Options::ParseArguments(int argc,
   if ((snapshot_filename_ != nullptr) && (gen_snapshot_kind_ == kNone)) {
     gen_snapshot_kind_ = kKernel;
   }
+  if (incremental_snapshot_ && (gen_snapshot_kind_ != kAppJIT)) {
+    Syslog::PrintErr(
+        "--incremental-snapshot requires --snapshot-kind=app-jit.\n");
+    return false;
+  }
 
   return true;
 }
@@ -31,6 +31,7 @@ namespace bin {
   V(executable_name, executable_name)                                          \
   V(resolved_executable_name, resolved_executable_name)                        \
   V(script_uri_override, script_uri_override)                                  \
+  V(prefetch_snapshot_text, prefetch_snapshot_text)                            \
   V(delete_temp_dir_on_shutdown, delete_temp_dir_on_shutdown)                  \
   /* The purpose of these flags is documented in */                            \
   /* pkg/dartdev/lib/src/commands/compilation_server.dart. */                  \
@@ -68,6 +69,7 @@ namespace bin {
   V(serve_observatory, enable_observatory)                                     \
   V(print_dtd, print_dtd)                                                      \
   V(profile_microtasks, profile_microtasks)                                    \
+  V(incremental_snapshot, incremental_snapshot)                                \
   /* The purpose of this flag is documented in */                              \
   /* pkg/dartdev/lib/src/commands/run.dart. */                                 \
   V(resident, resident)                                                        \
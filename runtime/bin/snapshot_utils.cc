@@ -5,7 +5,11 @@
 #include "bin/snapshot_utils.h"
 
 #include <cerrno>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "bin/dartutils.h"
 #include "bin/dfe.h"
@@ -13,8 +17,11 @@
 #include "bin/error_exit.h"
 #include "bin/exe_utils.h"
 #include "bin/file.h"
+#include "bin/lockers.h"
 #include "bin/macho_loader.h"
 #include "bin/platform.h"
+#include "bin/thread.h"
+#include "bin/virtual_memory.h"
 #include "include/dart_api.h"
 #if defined(DART_TARGET_OS_MACOS)
 #include <platform/mach_o.h>
@@ -22,7 +29,9 @@
 #if defined(DART_TARGET_OS_WINDOWS)
 #include <platform/pe.h>
 #endif
+#include "platform/atomic.h"
 #include "platform/utils.h"
+#include "zlib/zlib.h"
 
 #define LOG_SECTION_BOUNDARIES false
 
@@ -44,6 +53,21 @@ static constexpr int64_t kAppSnapshotPageSize = 64 * KB;
 
 static const char kMachOAppSnapshotNoteName[] DART_UNUSED = "__dart_app_snap";
 
+// A compressed AOT snapshot (see gen_snapshot --compress_snapshot) is an ELF
+// snapshot split into chunks that are compressed independently, so that they
+// can be decompressed in parallel when the snapshot is loaded:
+//
+//   magic number                  8 bytes
+//   uncompressed size             int64
+//   chunk size                    int64
+//   number of chunks              int64
+//   compressed size of chunk 0    int64
+//   ...
+//   compressed chunk 0            zlib stream
+//   ...
+static constexpr int64_t kCompressedSnapshotHeaderSize = 3 * kInt64Size;
+static constexpr int64_t kCompressedSnapshotChunkSize = 1 * MB;
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 class DummySnapshot : public AppSnapshot {
  public:
@@ -387,6 +411,162 @@ static AppSnapshot* TryReadAppSnapshotMachODylib(
                                    snapshot_text_buffer);
 }
 
+// Decompresses the chunks of a compressed AOT snapshot on the loading thread
+// and on helper threads.
+class CompressedSnapshotDecompressor {
+ public:
+  static constexpr intptr_t kMaxThreads = 8;
+
+  CompressedSnapshotDecompressor(uint8_t* output,
+                                 int64_t output_size,
+                                 int64_t chunk_size,
+                                 std::vector<const uint8_t*> chunks,
+                                 std::vector<int64_t> chunk_sizes)
+      : output_(output),
+        output_size_(output_size),
+        chunk_size_(chunk_size),
+        chunks_(std::move(chunks)),
+        chunk_sizes_(std::move(chunk_sizes)) {}
+
+  bool Decompress() {
+    const intptr_t num_chunks = chunks_.size();
+    const intptr_t num_helpers =
+        Utils::Minimum<intptr_t>(
+            Utils::Minimum<intptr_t>(Platform::NumberOfProcessors(),
+                                     kMaxThreads),
+            num_chunks) -
+        1;
+    for (intptr_t i = 0; i < num_helpers; i++) {
+      {
+        MonitorLocker ml(&monitor_);
+        running_helpers_++;
+      }
+      if (Thread::TryStart("Dart snapshot decompression", &RunHelper,
+                           reinterpret_cast<uword>(this)) != 0) {
+        // Whatever the helpers do not decompress is decompressed below.
+        MonitorLocker ml(&monitor_);
+        running_helpers_--;
+        break;
+      }
+    }
+    DecompressChunks();
+    MonitorLocker ml(&monitor_);
+    while (running_helpers_ > 0) {
+      ml.Wait();
+    }
+    return !failed_;
+  }
+
+ private:
+  static void RunHelper(uword parameter) {
+    auto* const decompressor =
+        reinterpret_cast<CompressedSnapshotDecompressor*>(parameter);
+    decompressor->DecompressChunks();
+    MonitorLocker ml(&decompressor->monitor_);
+    decompressor->running_helpers_--;
+    ml.Notify();
+  }
+
+  void DecompressChunks() {
+    const intptr_t num_chunks = chunks_.size();
+    for (intptr_t i = next_chunk_.fetch_add(1); i < num_chunks;
+         i = next_chunk_.fetch_add(1)) {
+      const int64_t start = i * chunk_size_;
+      const int64_t expected =
+          Utils::Minimum(chunk_size_, output_size_ - start);
+      uLongf length = expected;
+      const int result = uncompress(output_ + start, &length, chunks_[i],
+                                    static_cast<uLong>(chunk_sizes_[i]));
+      if ((result != Z_OK) || (static_cast<int64_t>(length) != expected)) {
+        failed_ = true;
+      }
+    }
+  }
+
+  uint8_t* const output_;
+  const int64_t output_size_;
+  const int64_t chunk_size_;
+  const std::vector<const uint8_t*> chunks_;
+  const std::vector<int64_t> chunk_sizes_;
+  RelaxedAtomic<intptr_t> next_chunk_ = {0};
+  RelaxedAtomic<bool> failed_ = {false};
+  Monitor monitor_;
+  intptr_t running_helpers_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CompressedSnapshotDecompressor);
+};
+
+static AppSnapshot* TryReadAppSnapshotCompressed(File& file,
+                                                 int64_t file_offset) {
+  MappedMemory* memory =
+      file.Map(File::kReadOnly, /*position=*/0, /*length=*/file.Length());
+  if (memory == nullptr) return nullptr;
+  std::unique_ptr<MappedMemory> mapping(memory);
+  const uint8_t* const start =
+      reinterpret_cast<const uint8_t*>(memory->address()) + file_offset;
+  const uint8_t* const end =
+      reinterpret_cast<const uint8_t*>(memory->address()) + file.Length();
+
+  const uint8_t* cursor = start + DartUtils::kMaxMagicNumberSize;
+  auto read_int64 = [&](int64_t* value) {
+    if ((end - cursor) < kInt64Size) return false;
+    memcpy(value, cursor, kInt64Size);  // NOLINT
+    cursor += kInt64Size;
+    return true;
+  };
+  int64_t uncompressed_size = 0;
+  int64_t chunk_size = 0;
+  int64_t num_chunks = 0;
+  if (!read_int64(&uncompressed_size) || !read_int64(&chunk_size) ||
+      !read_int64(&num_chunks) || (uncompressed_size <= 0) ||
+      (chunk_size <= 0) ||
+      (num_chunks != Utils::RoundUp(uncompressed_size, chunk_size) /
+                         chunk_size) ||
+      (num_chunks > (end - cursor) / kInt64Size)) {
+    Syslog::PrintErr("Loading failed: malformed compressed snapshot\n");
+    return nullptr;
+  }
+  std::vector<int64_t> chunk_sizes(num_chunks);
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    read_int64(&chunk_sizes[i]);
+  }
+  std::vector<const uint8_t*> chunks(num_chunks);
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    if ((chunk_sizes[i] <= 0) || (chunk_sizes[i] > (end - cursor))) {
+      Syslog::PrintErr("Loading failed: malformed compressed snapshot\n");
+      return nullptr;
+    }
+    chunks[i] = cursor;
+    cursor += chunk_sizes[i];
+  }
+
+  std::unique_ptr<uint8_t, decltype(std::free)*> elf{
+      reinterpret_cast<uint8_t*>(malloc(uncompressed_size)), std::free};
+  if (elf == nullptr) return nullptr;
+  CompressedSnapshotDecompressor decompressor(elf.get(), uncompressed_size,
+                                              chunk_size, std::move(chunks),
+                                              std::move(chunk_sizes));
+  if (!decompressor.Decompress()) {
+    Syslog::PrintErr("Loading failed: corrupt compressed snapshot\n");
+    return nullptr;
+  }
+  // The compressed file is no longer needed once it has been decompressed.
+  mapping.reset();
+
+  // The loader copies the segments out of the decompressed ELF image.
+  const uint8_t* snapshot_data_buffer = nullptr;
+  const uint8_t* snapshot_text_buffer = nullptr;
+  const char* error = nullptr;
+  Dart_LoadedElf* handle =
+      Dart_LoadELF_Memory(elf.get(), uncompressed_size, &error,
+                          &snapshot_data_buffer, &snapshot_text_buffer);
+  if (handle == nullptr) {
+    Syslog::PrintErr("Loading failed: %s\n", error);
+    return nullptr;
+  }
+  return new ElfAppSnapshot(handle, snapshot_data_buffer, snapshot_text_buffer);
+}
+
 static AppSnapshot* TryReadAppSnapshotAt(const char* script_name,
                                          File& file,
                                          int64_t file_offset,
@@ -403,6 +583,10 @@ static AppSnapshot* TryReadAppSnapshotAt(const char* script_name,
                                         force_load_from_memory);
   }
 
+  if (magic_number == DartUtils::kAotCompressedMagicNumber) {
+    return TryReadAppSnapshotCompressed(file, file_offset);
+  }
+
   if (file_offset == 0) {
     // This is a non-appended snapshot which is not handled by any of the
     // non-native loaders, so attempt to load it as a native dynamic library.
@@ -836,6 +1020,20 @@ static bool WriteInt64(File* file, int64_t size) {
   return file->WriteFully(&size, sizeof(size));
 }
 
+void Snapshot::PrefetchText(const uint8_t* snapshot_text, int64_t length) {
+  if ((snapshot_text == nullptr) || (length <= 0)) return;
+#if defined(HOST_ARCH_ARM64E)
+  snapshot_text = ptrauth_strip(snapshot_text, ptrauth_key_function_pointer);
+#endif
+  // The instructions image starts with its total size (see
+  // Image::HeaderField::ImageSize in vm/image_snapshot.h).
+  const uword text_size = *reinterpret_cast<const uword*>(snapshot_text);
+  length = Utils::Minimum<int64_t>(length, text_size);
+  VirtualMemory::Init();
+  VirtualMemory::Prefetch(const_cast<uint8_t*>(snapshot_text),
+                          static_cast<intptr_t>(length));
+}
+
 void Snapshot::WriteAppSnapshot(const char* filename,
                                 uint8_t* isolate_data_buffer,
                                 intptr_t isolate_data_size,
@@ -876,6 +1074,55 @@ void Snapshot::WriteAppSnapshot(const char* filename,
   file->Release();
 }
 
+void Snapshot::CompressAppAOTSnapshot(const uint8_t* snapshot,
+                                      intptr_t snapshot_size,
+                                      uint8_t** compressed,
+                                      intptr_t* compressed_size) {
+  ASSERT(snapshot_size > 0);
+  const int64_t num_chunks =
+      Utils::RoundUp(snapshot_size, kCompressedSnapshotChunkSize) /
+      kCompressedSnapshotChunkSize;
+  const intptr_t header_size = DartUtils::kMaxMagicNumberSize +
+                               kCompressedSnapshotHeaderSize +
+                               num_chunks * kInt64Size;
+  uint8_t* const buffer = reinterpret_cast<uint8_t*>(malloc(
+      header_size + num_chunks * compressBound(kCompressedSnapshotChunkSize)));
+  uint8_t* cursor = buffer;
+  auto write_int64 = [&](int64_t value) {
+    memcpy(cursor, &value, kInt64Size);  // NOLINT
+    cursor += kInt64Size;
+  };
+
+  memcpy(cursor, aotcompressed_magic_number.bytes,  // NOLINT
+         aotcompressed_magic_number.length);
+  cursor += aotcompressed_magic_number.length;
+  write_int64(snapshot_size);
+  write_int64(kCompressedSnapshotChunkSize);
+  write_int64(num_chunks);
+  uint8_t* chunk_sizes = cursor;
+  cursor += num_chunks * kInt64Size;
+  ASSERT(cursor - buffer == header_size);
+
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    const int64_t start = i * kCompressedSnapshotChunkSize;
+    const int64_t length =
+        Utils::Minimum(kCompressedSnapshotChunkSize, snapshot_size - start);
+    uLongf chunk_size = compressBound(length);
+    const int result = compress2(cursor, &chunk_size, snapshot + start, length,
+                                 Z_BEST_COMPRESSION);
+    if (result != Z_OK) {
+      ErrorExit(kErrorExitCode, "Unable to compress snapshot: %s\n",
+                zError(result));
+    }
+    cursor += chunk_size;
+    const int64_t size = chunk_size;
+    memcpy(chunk_sizes + i * kInt64Size, &size, kInt64Size);  // NOLINT
+  }
+
+  *compressed = buffer;
+  *compressed_size = cursor - buffer;
+}
+
 void Snapshot::GenerateKernel(const char* snapshot_filename,
                               const char* script_name,
                               const char* package_config) {
@@ -925,6 +1172,205 @@ void Snapshot::GenerateAppJIT(const char* snapshot_filename) {
                    snapshot_text_buffer, snapshot_text_size);
 }
 
+static char* LibraryFingerprintsFilename(const char* snapshot_filename) {
+  return Utils::SCreate("%s.fingerprints", snapshot_filename);
+}
+
+// Hashes what the training run depends on besides the program: the package
+// config, which user code can read, and the arguments passed to main.
+static uint64_t TrainingConfigurationHash(
+    CommandLineOptions* training_arguments) {
+  std::string configuration;
+  Dart_Handle package_config =
+      Dart_Invoke(DartUtils::LookupBuiltinLib(),
+                  DartUtils::NewString("_getPackageConfigSync"), 0, nullptr);
+  if (!Dart_IsError(package_config) && !Dart_IsNull(package_config)) {
+    package_config = Dart_ToString(package_config);
+  }
+  if (Dart_IsError(package_config)) {
+    ErrorExit(kErrorExitCode, "%s\n", Dart_GetError(package_config));
+  }
+  if (!Dart_IsNull(package_config)) {
+    const char* uri = nullptr;
+    Dart_Handle result = Dart_StringToCString(package_config, &uri);
+    if (Dart_IsError(result)) {
+      ErrorExit(kErrorExitCode, "%s\n", Dart_GetError(result));
+    }
+    configuration.append(uri);
+    configuration.push_back('\0');
+    File* file = File::OpenUri(nullptr, uri, File::kRead);
+    if (file != nullptr) {
+      RefCntReleaseScope<File> rs(file);
+      const int64_t length = file->Length();
+      if (length > 0) {
+        std::string contents(length, '\0');
+        if (file->ReadFully(&contents[0], length)) {
+          configuration.append(contents);
+        }
+      }
+    }
+  }
+  configuration.push_back('\0');
+  for (intptr_t i = 0; i < training_arguments->count(); i++) {
+    configuration.append(training_arguments->GetArgument(i));
+    configuration.push_back('\0');
+  }
+  return Utils::StringHash64(configuration.data(), configuration.length());
+}
+
+char* Snapshot::LibraryFingerprints(CommandLineOptions* training_arguments) {
+  const uint64_t configuration_hash =
+      TrainingConfigurationHash(training_arguments);
+  uint8_t* buffer = nullptr;
+  intptr_t length = 0;
+  Dart_Handle result = Dart_GetLibraryFingerprints(&buffer, &length);
+  if (Dart_IsError(result)) {
+    ErrorExit(kErrorExitCode, "%s\n", Dart_GetError(result));
+  }
+  // The first line identifies the VM, whose snapshots other VMs cannot read,
+  // and the second one how the snapshot was trained.
+  return Utils::SCreate("dart %s\ntraining %016" Px64 "\n%.*s",
+                        Dart_VersionString(), configuration_hash,
+                        static_cast<int>(length),
+                        reinterpret_cast<const char*>(buffer));
+}
+
+void Snapshot::WriteLibraryFingerprints(const char* snapshot_filename,
+                                        const char* fingerprints) {
+  CStringUniquePtr filename(LibraryFingerprintsFilename(snapshot_filename));
+  File* file = File::Open(nullptr, filename.get(), File::kWriteTruncate);
+  if (file == nullptr ||
+      !file->WriteFully(fingerprints, strlen(fingerprints))) {
+    ErrorExit(kErrorExitCode, "Unable to write fingerprints file '%s'\n",
+              filename.get());
+  }
+  file->Release();
+}
+
+// The libraries listed in a fingerprints file, by URI.
+struct LibraryFingerprint {
+  std::string fingerprint;
+  std::vector<std::string> dependencies;
+};
+using LibraryFingerprintMap = std::map<std::string, LibraryFingerprint>;
+
+static bool ParseLibraryFingerprints(const char* text,
+                                     std::string* vm,
+                                     std::string* training,
+                                     LibraryFingerprintMap* libraries) {
+  const char* line = text;
+  const char* line_end = strchr(line, '\n');
+  if (line_end == nullptr) return false;
+  vm->assign(line, line_end - line);
+  line = line_end + 1;
+  line_end = strchr(line, '\n');
+  if (line_end == nullptr) return false;
+  training->assign(line, line_end - line);
+  for (line = line_end + 1; *line != '\0'; line = line_end + 1) {
+    line_end = strchr(line, '\n');
+    if (line_end == nullptr) line_end = line + strlen(line);
+    std::vector<std::string> words;
+    for (const char* word = line; word < line_end;) {
+      const char* word_end = word;
+      while (word_end < line_end && *word_end != ' ') {
+        word_end++;
+      }
+      words.emplace_back(word, word_end - word);
+      word = word_end + 1;
+    }
+    if (words.size() < 2) return false;
+    LibraryFingerprint& library = (*libraries)[words[1]];
+    library.fingerprint = words[0];
+    library.dependencies.assign(words.begin() + 2, words.end());
+    if (*line_end == '\0') break;
+  }
+  return true;
+}
+
+bool Snapshot::IsAppJITSnapshotUpToDate(const char* snapshot_filename,
+                                        const char* fingerprints) {
+  if (!File::Exists(nullptr, snapshot_filename)) return false;
+  CStringUniquePtr filename(LibraryFingerprintsFilename(snapshot_filename));
+  File* file = File::Open(nullptr, filename.get(), File::kRead);
+  if (file == nullptr) return false;
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if (length <= 0) return false;
+  std::string previous_text(length, '\0');
+  if (!file->ReadFully(&previous_text[0], length)) return false;
+
+  std::string previous_vm;
+  std::string current_vm;
+  std::string previous_training;
+  std::string current_training;
+  LibraryFingerprintMap previous;
+  LibraryFingerprintMap current;
+  if (!ParseLibraryFingerprints(previous_text.c_str(), &previous_vm,
+                                &previous_training, &previous) ||
+      !ParseLibraryFingerprints(fingerprints, &current_vm, &current_training,
+                                &current)) {
+    return false;
+  }
+  if (previous_vm != current_vm) {
+    Syslog::Print("App JIT snapshot '%s' was written by another VM.\n",
+                  snapshot_filename);
+    return false;
+  }
+  if (previous_training != current_training) {
+    Syslog::Print(
+        "App JIT snapshot '%s' was trained with another package config or "
+        "other arguments.\n",
+        snapshot_filename);
+    return false;
+  }
+
+  // Libraries that were added, removed or changed since the snapshot was
+  // written, followed by the libraries importing or exporting them.
+  std::vector<std::string> outdated;
+  std::set<std::string> seen;
+  for (const auto& it : current) {
+    auto previous_it = previous.find(it.first);
+    if (previous_it == previous.end() ||
+        previous_it->second.fingerprint != it.second.fingerprint) {
+      outdated.push_back(it.first);
+      seen.insert(it.first);
+    }
+  }
+  for (const auto& it : previous) {
+    if (current.find(it.first) == current.end()) {
+      outdated.push_back(it.first);
+      seen.insert(it.first);
+    }
+  }
+  if (outdated.empty()) return true;
+  const size_t changed_count = outdated.size();
+
+  std::map<std::string, std::vector<std::string>> dependants;
+  for (const auto& it : current) {
+    for (const auto& dependency : it.second.dependencies) {
+      dependants[dependency].push_back(it.first);
+    }
+  }
+  for (size_t i = 0; i < outdated.size(); i++) {
+    for (const auto& dependant : dependants[outdated[i]]) {
+      if (seen.insert(dependant).second) {
+        outdated.push_back(dependant);
+      }
+    }
+  }
+
+  Syslog::Print(
+      "App JIT snapshot '%s' is out of date: %" Pd
+      " libraries changed, %" Pd " libraries depend on them.\n",
+      snapshot_filename, static_cast<intptr_t>(changed_count),
+      static_cast<intptr_t>(outdated.size() - changed_count));
+  for (size_t i = 0; i < outdated.size(); i++) {
+    Syslog::Print("  %s %s\n", i < changed_count ? "changed:  " : "dependant:",
+                  outdated[i].c_str());
+  }
+  return false;
+}
+
 static void StreamingWriteCallback(void* callback_data,
                                    const uint8_t* buffer,
                                    intptr_t size) {
@@ -47,6 +47,22 @@ class Snapshot {
                              const char* script_name,
                              const char* package_config);
   static void GenerateAppJIT(const char* snapshot_filename);
+
+  // Support for reusing app JIT snapshots across training runs (see
+  // --incremental-snapshot).
+  //
+  // Returns the fingerprints of the current isolate group's libraries (see
+  // Dart_GetLibraryFingerprints), preceded by the VM version and a hash of the
+  // package config and the [training_arguments]. The caller must free them.
+  static char* LibraryFingerprints(CommandLineOptions* training_arguments);
+  // Writes [fingerprints] next to the app JIT snapshot [snapshot_filename].
+  static void WriteLibraryFingerprints(const char* snapshot_filename,
+                                       const char* fingerprints);
+  // Whether the app JIT snapshot [snapshot_filename] was written for a program
+  // whose libraries had the given [fingerprints]. If not, prints the libraries
+  // that changed and the libraries depending on them.
+  static bool IsAppJITSnapshotUpToDate(const char* snapshot_filename,
+                                       const char* fingerprints);
   static void GenerateAppAOTAsAssembly(const char* snapshot_filename);
 
   static bool IsMachOFormattedBinary(const char* container_path,
@@ -62,11 +78,23 @@ class Snapshot {
   static std::pair<AppSnapshot*, CStringUniquePtr> TryReadSDKSnapshot(
       const char* snapshot_name,
       bool verbose = true);
+  // Prefetches the first [length] bytes of a loaded snapshot's instructions,
+  // e.g. the startup code placed first by gen_snapshot --startup_code_order.
+  // [length] is clamped to the size of the instructions.
+  static void PrefetchText(const uint8_t* snapshot_text, int64_t length);
   static void WriteAppSnapshot(const char* filename,
                                uint8_t* isolate_data_buffer,
                                intptr_t isolate_data_size,
                                uint8_t* isolate_instructions_buffer,
                                intptr_t isolate_instructions_size);
+  // Compresses the AOT ELF snapshot [snapshot] into the format written by
+  // gen_snapshot --compress-snapshot, which the precompiled runtime
+  // decompresses when it loads the snapshot. The caller must free
+  // [compressed].
+  static void CompressAppAOTSnapshot(const uint8_t* snapshot,
+                                     intptr_t snapshot_size,
+                                     uint8_t** compressed,
+                                     intptr_t* compressed_size);
 
  private:
 #if defined(DART_TARGET_OS_MACOS)
@@ -104,6 +104,10 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   }
 }
 
+void VirtualMemory::Prefetch(void* address, intptr_t size) {
+  // Not supported on Fuchsia, prefetching is only a hint.
+}
+
 }  // namespace bin
 }  // namespace dart
 
@@ -131,6 +131,15 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   }
 }
 
+void VirtualMemory::Prefetch(void* address, intptr_t size) {
+  const uword start_address = reinterpret_cast<uword>(address);
+  const uword end_address = start_address + size;
+  const uword page_address = Utils::RoundDown(start_address, PageSize());
+  // Only a hint, failure to prefetch is not an error.
+  madvise(reinterpret_cast<void*>(page_address), end_address - page_address,
+          MADV_WILLNEED);
+}
+
 }  // namespace bin
 }  // namespace dart
 
@@ -76,6 +76,17 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   }
 }
 
+void VirtualMemory::Prefetch(void* address, intptr_t size) {
+  const uword start_address = reinterpret_cast<uword>(address);
+  const uword end_address = start_address + size;
+  const uword page_address = Utils::RoundDown(start_address, PageSize());
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = reinterpret_cast<void*>(page_address);
+  range.NumberOfBytes = end_address - page_address;
+  // Only a hint, failure to prefetch is not an error.
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
 }  // namespace bin
 }  // namespace dart
 
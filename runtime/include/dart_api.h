@@ -4288,6 +4288,34 @@ Dart_CreateAppJITSnapshotAsBlobs(uint8_t** snapshot_data_buffer,
                                  uint8_t** snapshot_text_buffer,
                                  intptr_t* snapshot_text_size);
 
+/**
+ *  Computes a fingerprint of the declarations of every library of the current
+ *  isolate group, other than the dart: libraries, for deciding whether an app
+ *  JIT snapshot taken of the program is still up to date.
+ *
+ *  The fingerprints are written as text, one line per library:
+ *
+ *    <fingerprint> <library uri> <imported library uri>*
+ *
+ *  where the imported libraries are the non-dart: libraries the library
+ *  imports or exports. A fingerprint hashes the library's kernel: the
+ *  headers and annotations of its classes, and the signatures, annotations
+ *  and bodies of its fields and functions, including field initializers and
+ *  the values of the constants and integer literals they use. Source
+ *  positions are not hashed, and declarations of other libraries are
+ *  referred to by name only. It is computed from the kernel program, so no
+ *  class is loaded or finalized.
+ *
+ *   - Requires the VM to have not been started with --precompilation.
+ *
+ *  The buffer is scope allocated and is only valid until the next call to
+ *  Dart_ExitScope.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT DART_API_WARN_UNUSED_RESULT Dart_Handle
+Dart_GetLibraryFingerprints(uint8_t** buffer, intptr_t* buffer_length);
+
 /**
  * Get obfuscation map for precompiled code.
  *
@@ -530,6 +530,114 @@ Dart_IsolateGroupHeapNewCapacityMetric(Dart_IsolateGroup group);  // Byte
 DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewExternalMetric(Dart_IsolateGroup group);  // Byte
 
+/*
+ * ====================
+ * Snapshot Load Report
+ * ====================
+ */
+
+/**
+ * Returns a JSON report of the snapshots loaded since the VM was initialized.
+ *
+ * For every program and deferred loading unit snapshot loaded, the report
+ * lists each deserialization cluster with its number of objects, the bytes it
+ * occupies in the snapshot and in the heap, and the time spent allocating,
+ * filling and post-processing its objects.
+ *
+ * Loads are only recorded when the VM flag `record_snapshot_load_report` or
+ * `write_snapshot_load_report_to` is set.
+ *
+ * \return A JSON string, or NULL if loads are not being recorded. The caller
+ *   is responsible for freeing the returned string.
+ */
+DART_EXPORT char* Dart_GetSnapshotLoadReport(void);
+
+/*
+ * ========================
+ * Continuous CPU Profiling
+ * ========================
+ */
+
+/**
+ * A callback which receives a CPU profile in the pprof format (see
+ * https://github.com/google/pprof/blob/main/proto/profile.proto).
+ *
+ * \param buffer The serialized, uncompressed profile. The buffer is only valid
+ *   during the call.
+ * \param buffer_length The length of the profile in bytes.
+ */
+typedef void (*Dart_ContinuousProfileCallback)(const uint8_t* buffer,
+                                               intptr_t buffer_length);
+
+/**
+ * Enables continuous CPU profiling without the VM service.
+ *
+ * A VM thread periodically collects the CPU samples of all isolates and
+ * aggregates them. Every `continuous_profile_period` seconds the aggregated
+ * samples are passed to `callback` as a pprof profile, instead of being
+ * written to the directory given by the VM flag `continuous_profile_dir`.
+ * The samples are consumed when they are collected, so while the callback is
+ * set the VM service's getCpuSamples and the CPU profiler of DevTools see no
+ * samples.
+ *
+ * Must be called before Dart_Initialize.
+ *
+ * \param callback The callback receiving the profiles.
+ *
+ * \return false if the VM was built without the profiler.
+ */
+DART_EXPORT bool Dart_SetContinuousProfileCallback(
+    Dart_ContinuousProfileCallback callback);
+
+/*
+ * ==================
+ * Event Loop Latency
+ * ==================
+ */
+
+typedef enum {
+  /* Time from posting a message until its handler starts. */
+  Dart_EventLoopLatency_MessageQueue,
+  /* Time spent handling a message, without draining the microtask queue. */
+  Dart_EventLoopLatency_MessageHandler,
+  /* Time spent draining the microtask queue after handling a message. */
+  Dart_EventLoopLatency_MicrotaskDrain,
+} Dart_EventLoopLatencyKind;
+
+typedef struct {
+  /* The number of recorded durations. */
+  int64_t count;
+  /* The shortest, longest and total recorded durations in microseconds. */
+  int64_t min_micros;
+  int64_t max_micros;
+  int64_t total_micros;
+  /* Percentiles of the recorded durations in microseconds, accurate to within
+   * a few percent. */
+  int64_t p50_micros;
+  int64_t p90_micros;
+  int64_t p99_micros;
+  int64_t p999_micros;
+} Dart_LatencySummary;
+
+/**
+ * Summarizes a latency histogram of an isolate's event loop.
+ *
+ * The histograms are only recorded for isolates created while the VM flag
+ * `record_event_loop_latency` is set. They are also available through the
+ * VM service.
+ *
+ * Can be called from any thread while the isolate is alive.
+ *
+ * \param isolate The isolate.
+ * \param kind The histogram to summarize.
+ * \param summary Receives the summary.
+ *
+ * \return false if the isolate does not record event loop latency.
+ */
+DART_EXPORT bool Dart_GetEventLoopLatency(Dart_Isolate isolate,
+                                          Dart_EventLoopLatencyKind kind,
+                                          Dart_LatencySummary* summary);
+
 /*
  * ========
  * UserTags
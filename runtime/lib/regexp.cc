@@ -21,16 +21,12 @@ DEFINE_NATIVE_ENTRY(RegExp_factory, 0, 5) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(0));
 
   bool multi_line = arguments->NativeArgAt(1) == Bool::True().ptr();
-  bool ignore_case = arguments->NativeArgAt(2) != Bool::True().ptr();
+  bool case_sensitive = arguments->NativeArgAt(2) == Bool::True().ptr();
   bool unicode = arguments->NativeArgAt(3) == Bool::True().ptr();
   bool dot_all = arguments->NativeArgAt(4) == Bool::True().ptr();
 
-  RegExpFlags flags;
-  flags |= RegExpFlag::kGlobal;  // All dart regexps are global.
-  if (ignore_case) flags |= RegExpFlag::kIgnoreCase;
-  if (multi_line) flags |= RegExpFlag::kMultiline;
-  if (unicode) flags |= RegExpFlag::kUnicode;
-  if (dot_all) flags |= RegExpFlag::kDotAll;
+  RegExpFlags flags =
+      RegExpStatics::FlagsFor(multi_line, case_sensitive, unicode, dot_all);
 
   RegExpKey lookup_key(pattern, flags);
   RegExp& regexp = RegExp::Handle(thread->zone());
@@ -61,16 +57,7 @@ DEFINE_NATIVE_ENTRY(RegExp_factory, 0, 5) {
     UNREACHABLE();
   }
 
-  {
-    RegExpKey lookup_symbol_key(String::Handle(Symbols::New(thread, pattern)),
-                                flags);
-    SafepointMutexLocker ml(thread->isolate_group()->symbols_mutex());
-    CanonicalRegExpSet table(
-        thread->zone(),
-        thread->isolate_group()->object_store()->regexp_table());
-    regexp ^= table.InsertNewOrGet(lookup_symbol_key);
-    thread->isolate_group()->object_store()->set_regexp_table(table.Release());
-  }
+  regexp = RegExpStatics::Canonicalize(thread, pattern, flags);
 
   ASSERT(regexp.flags() == flags);
   return regexp.ptr();
@@ -135,18 +122,11 @@ DEFINE_NATIVE_ENTRY(RegExp_getGroupNameMap, 0, 1) {
   return ThrowUninitialized(regexp);
 }
 
-static ObjectPtr ExecuteMatch(Thread* thread,
-                              Zone* zone,
-                              NativeArguments* arguments,
-                              bool sticky) {
-  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
-  ASSERT(!regexp.IsNull());
-  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
-  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
-
-  // Both generated code and the interpreter are using 32-bit registers and
-  // 32-bit backtracking stack so they can't work with strings which are
-  // larger than that. Validate these assumptions before running the regexp.
+// Both generated code and the interpreter are using 32-bit registers and
+// 32-bit backtracking stack so they can't work with strings which are
+// larger than that. Validate these assumptions before running the regexp.
+static void ValidateMatchArguments(const String& subject,
+                                   const Smi& start_index) {
   if (!Utils::IsInt(32, subject.Length())) {
     Exceptions::ThrowRangeError("length",
                                 Integer::Handle(Integer::New(subject.Length())),
@@ -156,6 +136,17 @@ static ObjectPtr ExecuteMatch(Thread* thread,
     Exceptions::ThrowRangeError("start_index", Integer::Cast(start_index),
                                 kMinInt32, kMaxInt32);
   }
+}
+
+static ObjectPtr ExecuteMatch(Thread* thread,
+                              Zone* zone,
+                              NativeArguments* arguments,
+                              bool sticky) {
+  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  ValidateMatchArguments(subject, start_index);
 
   return RegExpStatics::Interpret(thread, regexp, subject, start_index.Value(),
                                   sticky);
@@ -171,4 +162,17 @@ DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchSticky, 0, 3) {
   return ExecuteMatch(thread, zone, arguments, /*sticky=*/true);
 }
 
+DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchGlobal, 0, 4) {
+  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedData, matches, arguments->NativeArgAt(3));
+  ValidateMatchArguments(subject, start_index);
+  ASSERT(matches.GetClassId() == kTypedDataInt32ArrayCid);
+
+  return Smi::New(RegExpStatics::InterpretGlobal(
+      thread, regexp, subject, start_index.Value(), matches));
+}
+
 }  // namespace dart
@@ -5,6 +5,8 @@
 #ifndef RUNTIME_PLATFORM_SYNCHRONIZATION_H_
 #define RUNTIME_PLATFORM_SYNCHRONIZATION_H_
 
+#include <atomic>
+
 #include "platform/allocation.h"
 #include "platform/threads.h"
 
@@ -48,9 +50,37 @@ class DisallowMutexLockingScope : public ValueObject {
 #endif  // DEBUG
 };
 
+class Mutex;
+
+// Receives reports about contention on named mutexes, see
+// Mutex::SetContentionObserver. Reports are made on the thread that waited
+// for or held the mutex, while it holds the mutex.
+class LockContentionObserver {
+ public:
+  virtual ~LockContentionObserver() {}
+
+  // Returns the current monotonic time in microseconds.
+  virtual int64_t CurrentMicros() = 0;
+
+  // Called after the current thread acquired [mutex], which was held by
+  // another thread when it started waiting at [wait_start_micros].
+  virtual void Contended(const Mutex& mutex,
+                         int64_t wait_start_micros,
+                         int64_t acquired_micros) = 0;
+
+  // Called before the current thread releases [mutex], which it acquired at
+  // [acquired_micros]. [contended] is true if another thread started waiting
+  // for [mutex] in the meantime.
+  virtual void Released(const Mutex& mutex,
+                        int64_t acquired_micros,
+                        int64_t released_micros,
+                        bool contended) = 0;
+};
+
 class Mutex {
  public:
-  Mutex();
+  // Only mutexes with a [name] are reported to the contention observer.
+  explicit Mutex(const char* name = nullptr);
   ~Mutex();
 
   bool IsOwnedByCurrentThread() const {
@@ -61,11 +91,116 @@ class Mutex {
   bool TryLock();  // Returns false if lock is busy and locking failed.
   void Unlock();
 
+  const char* name() const { return name_; }
+
+  // Sets the observer for all named mutexes, or removes it if [observer] is
+  // nullptr. The observer must stay alive after it is removed, because
+  // threads might still be reporting to it.
+  static void SetContentionObserver(LockContentionObserver* observer) {
+    contention_observer_.store(observer, std::memory_order_release);
+  }
+
  private:
+  static constexpr int64_t kNotObserved = -1;
+
+  LockContentionObserver* contention_observer() const {
+    if (name_ == nullptr) return nullptr;
+    return contention_observer_.load(std::memory_order_acquire);
+  }
+
+  // Must be called with [observer] from |contention_observer()| before
+  // blocking on a busy mutex.
+  int64_t NoteWaiting(LockContentionObserver* observer) {
+    has_waiters_.store(true, std::memory_order_relaxed);
+    return observer->CurrentMicros();
+  }
+
+  // Must be called after acquiring the mutex with [observer] from
+  // |contention_observer()|, or nullptr.
+  void NoteAcquired(LockContentionObserver* observer,
+                    int64_t wait_start_micros = kNotObserved) {
+    if (observer == nullptr) return;
+    acquired_micros_ = observer->CurrentMicros();
+    if ((wait_start_micros != kNotObserved) &&
+        (wait_start_micros <= acquired_micros_)) {
+      observer->Contended(*this, wait_start_micros, acquired_micros_);
+    }
+  }
+
+  // Must be called by the owner before notifying threads waiting on a
+  // condition variable with the mutex.
+  void NoteNotifying() {
+    LockContentionObserver* observer = contention_observer();
+    if (observer == nullptr) return;
+    notified_micros_.store(observer->CurrentMicros(),
+                           std::memory_order_relaxed);
+  }
+
+  // Must be called before waiting on a condition variable with the mutex.
+  // Returns the time at which the wait started, or kNotObserved.
+  int64_t NoteWaitStarting() {
+    NoteReleasing();
+    LockContentionObserver* observer = contention_observer();
+    return (observer == nullptr) ? kNotObserved : observer->CurrentMicros();
+  }
+
+  // Must be called after reacquiring the mutex at the end of a wait that
+  // started at [wait_start_micros]. The notifying thread usually still holds
+  // the mutex, so reacquiring it can block like |Lock|: that time is reported
+  // as a wait starting at the notification or at the timeout. Only monitors
+  // note their notifications.
+  void NoteWaitFinished(int64_t wait_start_micros,
+                        int64_t timeout_micros,
+                        bool timed_out) {
+    LockContentionObserver* observer = contention_observer();
+    int64_t reacquire_start_micros = kNotObserved;
+    if ((observer != nullptr) && (wait_start_micros != kNotObserved)) {
+      if (timed_out) {
+        reacquire_start_micros = wait_start_micros + timeout_micros;
+      } else {
+        const int64_t notified_micros =
+            notified_micros_.load(std::memory_order_relaxed);
+        if (notified_micros >= wait_start_micros) {
+          reacquire_start_micros = notified_micros;
+        }
+      }
+    }
+    NoteAcquired(observer, reacquire_start_micros);
+  }
+
+  // Must be called before releasing the mutex.
+  void NoteReleasing() {
+    if (acquired_micros_ == kNotObserved) return;
+    const int64_t acquired_micros = acquired_micros_;
+    acquired_micros_ = kNotObserved;
+    LockContentionObserver* observer = contention_observer();
+    if (observer == nullptr) return;
+    const bool contended = has_waiters_.exchange(false);
+    observer->Released(*this, acquired_micros, observer->CurrentMicros(),
+                       contended);
+  }
+
   MutexImpl mutex_;
   platform::ThreadBoundResource owner_;
 
+  const char* const name_;
+  // When observed, the time at which the owner acquired the mutex. Only
+  // accessed by the owner.
+  int64_t acquired_micros_ = kNotObserved;
+  // Whether a thread blocked on the mutex since its owner acquired it. This is
+  // approximate, because the owner might release the mutex before the flag is
+  // set, and then the next owner reports the contention.
+  std::atomic<bool> has_waiters_ = false;
+  // When observed, the time at which the owner last notified threads waiting
+  // on a condition variable with the mutex.
+  std::atomic<int64_t> notified_micros_ = kNotObserved;
+
+  static inline std::atomic<LockContentionObserver*> contention_observer_ =
+      nullptr;
+
   friend class ConditionVariable;
+  friend class Monitor;
+  friend class ReentrantMonitor;
   DISALLOW_COPY_AND_ASSIGN(Mutex);
 };
 
@@ -98,9 +233,11 @@ class Monitor {
 
   static constexpr int64_t kNoTimeout = ConditionVariable::kNoTimeout;
 
-  Monitor() {}
+  explicit Monitor(const char* name = nullptr) : mutex_(name) {}
   ~Monitor() {}
 
+  const char* name() const { return mutex_.name(); }
+
   bool IsOwnedByCurrentThread() const {
     return mutex_.IsOwnedByCurrentThread();
   }
@@ -119,9 +256,15 @@ class Monitor {
   }
 
   // Notify waiting threads.
-  void Notify() { cv_.Notify(); }
+  void Notify() {
+    mutex_.NoteNotifying();
+    cv_.Notify();
+  }
 
-  void NotifyAll() { cv_.NotifyAll(); }
+  void NotifyAll() {
+    mutex_.NoteNotifying();
+    cv_.NotifyAll();
+  }
 
  private:
   Mutex mutex_;  // OS-specific data.
@@ -202,9 +345,15 @@ class ReentrantMonitor {
   }
 
   // Notify waiting threads.
-  void Notify() { cv_.Notify(); }
+  void Notify() {
+    mutex_.NoteNotifying();
+    cv_.Notify();
+  }
 
-  void NotifyAll() { cv_.NotifyAll(); }
+  void NotifyAll() {
+    mutex_.NoteNotifying();
+    cv_.NotifyAll();
+  }
 
  private:
   Mutex mutex_;  // OS-specific data.
@@ -13,14 +13,22 @@
 
 namespace dart {
 
-Mutex::Mutex() {}
+Mutex::Mutex(const char* name) : name_(name) {}
 
 Mutex::~Mutex() {}
 
 ABSL_NO_THREAD_SAFETY_ANALYSIS
 void Mutex::Lock() {
-  mutex_.lock();
+  LockContentionObserver* observer = contention_observer();
+  int64_t wait_start_micros = kNotObserved;
+  if (observer == nullptr) {
+    mutex_.lock();
+  } else if (!mutex_.try_lock()) {
+    wait_start_micros = NoteWaiting(observer);
+    mutex_.lock();
+  }
   owner_.Acquire();
+  NoteAcquired(observer, wait_start_micros);
 }
 
 ABSL_NO_THREAD_SAFETY_ANALYSIS
@@ -29,11 +37,13 @@ bool Mutex::TryLock() {
     return false;
   }
   owner_.Acquire();
+  NoteAcquired(contention_observer());
   return true;
 }
 
 ABSL_NO_THREAD_SAFETY_ANALYSIS
 void Mutex::Unlock() {
+  NoteReleasing();
   owner_.Release();
   mutex_.unlock();
 }
@@ -53,6 +63,7 @@ ABSL_NO_THREAD_SAFETY_ANALYSIS
 ConditionVariable::WaitResult ConditionVariable::WaitMicros(
     Mutex* mutex,
     int64_t timeout_micros) {
+  const int64_t wait_start_micros = mutex->NoteWaitStarting();
   mutex->owner_.Release();
   Monitor::WaitResult retval = kNotified;
   if (timeout_micros == kNoTimeout) {
@@ -65,6 +76,8 @@ ConditionVariable::WaitResult ConditionVariable::WaitMicros(
     }
   }
   mutex->owner_.Acquire();
+  mutex->NoteWaitFinished(wait_start_micros, timeout_micros,
+                          retval == kTimedOut);
   return retval;
 }
 
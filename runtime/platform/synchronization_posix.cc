@@ -18,7 +18,7 @@
 
 namespace dart {
 
-Mutex::Mutex() {
+Mutex::Mutex(const char* name) : name_(name) {
   pthread_mutexattr_t attr;
   int result = pthread_mutexattr_init(&attr);
   VALIDATE_PTHREAD_RESULT(result);
@@ -45,11 +45,23 @@ Mutex::~Mutex() {
 void Mutex::Lock() {
   DEBUG_ASSERT(!DisallowMutexLockingScope::is_active());
 
-  int result = pthread_mutex_lock(&mutex_);
+  LockContentionObserver* observer = contention_observer();
+  int64_t wait_start_micros = kNotObserved;
+  int result;
+  if (observer == nullptr) {
+    result = pthread_mutex_lock(&mutex_);
+  } else {
+    result = pthread_mutex_trylock(&mutex_);
+    if (result == EBUSY) {
+      wait_start_micros = NoteWaiting(observer);
+      result = pthread_mutex_lock(&mutex_);
+    }
+  }
   // Specifically check for dead lock to help debugging.
   ASSERT(result != EDEADLK);
   ASSERT_PTHREAD_SUCCESS(result);  // Verify no other errors.
   owner_.Acquire();
+  NoteAcquired(observer, wait_start_micros);
 }
 
 bool Mutex::TryLock() {
@@ -62,10 +74,12 @@ bool Mutex::TryLock() {
   }
   ASSERT_PTHREAD_SUCCESS(result);  // Verify no other errors.
   owner_.Acquire();
+  NoteAcquired(contention_observer());
   return true;
 }
 
 void Mutex::Unlock() {
+  NoteReleasing();
   owner_.Release();
   int result = pthread_mutex_unlock(&mutex_);
   // Specifically check for wrong thread unlocking to aid debugging.
@@ -137,6 +151,7 @@ static int TimedWait(pthread_cond_t* cv,
 ConditionVariable::WaitResult ConditionVariable::WaitMicros(
     Mutex* mutex,
     int64_t timeout_micros) {
+  const int64_t wait_start_micros = mutex->NoteWaitStarting();
   mutex->owner_.Release();
   Monitor::WaitResult retval = kNotified;
   if (timeout_micros == kNoTimeout) {
@@ -151,6 +166,8 @@ ConditionVariable::WaitResult ConditionVariable::WaitMicros(
     }
   }
   mutex->owner_.Acquire();
+  mutex->NoteWaitFinished(wait_start_micros, timeout_micros,
+                          retval == kTimedOut);
   return retval;
 }
 
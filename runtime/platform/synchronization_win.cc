@@ -15,7 +15,7 @@
 
 namespace dart {
 
-Mutex::Mutex() {
+Mutex::Mutex(const char* name) : name_(name) {
   InitializeSRWLock(&mutex_);
 }
 
@@ -24,8 +24,16 @@ Mutex::~Mutex() {}
 void Mutex::Lock() {
   DEBUG_ASSERT(!DisallowMutexLockingScope::is_active());
 
-  AcquireSRWLockExclusive(&mutex_);
+  LockContentionObserver* observer = contention_observer();
+  int64_t wait_start_micros = kNotObserved;
+  if (observer == nullptr) {
+    AcquireSRWLockExclusive(&mutex_);
+  } else if (TryAcquireSRWLockExclusive(&mutex_) == 0) {
+    wait_start_micros = NoteWaiting(observer);
+    AcquireSRWLockExclusive(&mutex_);
+  }
   owner_.Acquire();
+  NoteAcquired(observer, wait_start_micros);
 }
 
 bool Mutex::TryLock() {
@@ -33,12 +41,14 @@ bool Mutex::TryLock() {
 
   if (TryAcquireSRWLockExclusive(&mutex_) != 0) {
     owner_.Acquire();
+    NoteAcquired(contention_observer());
     return true;
   }
   return false;
 }
 
 void Mutex::Unlock() {
+  NoteReleasing();
   owner_.Release();
   ReleaseSRWLockExclusive(&mutex_);
 }
@@ -51,6 +61,7 @@ ConditionVariable::~ConditionVariable() {}
 
 ConditionVariable::WaitResult ConditionVariable::Wait(Mutex* mutex,
                                                       int64_t timeout_millis) {
+  const int64_t wait_start_micros = mutex->NoteWaitStarting();
   mutex->owner_.Release();
   Monitor::WaitResult retval = kNotified;
   if (timeout_millis == kNoTimeout) {
@@ -64,6 +75,9 @@ ConditionVariable::WaitResult ConditionVariable::Wait(Mutex* mutex,
     }
   }
   mutex->owner_.Acquire();
+  mutex->NoteWaitFinished(wait_start_micros,
+                          timeout_millis * kMicrosecondsPerMillisecond,
+                          retval == kTimedOut);
   return retval;
 }
 
@@ -0,0 +1,151 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that analyze_snapshot --diff_load_reports parses two snapshot load
+// reports and prints the clusters that changed, the largest change in load
+// time first.
+
+import 'dart:io';
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const before = r'''
+{
+  "type": "SnapshotLoadReport",
+  "loads": [
+    {
+      "isolateGroup": "main",
+      "kind": "full-aot",
+      "loadingUnit": 1,
+      "clusters": [
+        {"name": "Class", "objects": 10, "snapshotBytes": 100,
+         "heapBytes": 200, "allocMicros": 5, "fillMicros": 10,
+         "postLoadMicros": 0},
+        {"name": "String", "canonical": true, "objects": 50,
+         "snapshotBytes": 1000, "heapBytes": 2000, "allocMicros": 10,
+         "fillMicros": 20, "postLoadMicros": 0},
+        {"name": "Instance", "class": "Café", "objects": 1,
+         "snapshotBytes": 8, "heapBytes": 16, "allocMicros": 1,
+         "fillMicros": 1, "postLoadMicros": 0}
+      ],
+      "totals": {"loadMicros": 100}
+    }
+  ]
+}
+''';
+
+const after = r'''
+{
+  "type": "SnapshotLoadReport",
+  "loads": [
+    {
+      "isolateGroup": "main",
+      "kind": "full-aot",
+      "loadingUnit": 1,
+      "clusters": [
+        {"name": "Class", "objects": 10, "snapshotBytes": 100,
+         "heapBytes": 200, "allocMicros": 5, "fillMicros": 10,
+         "postLoadMicros": 0},
+        {"name": "String", "canonical": true, "objects": 60,
+         "snapshotBytes": 1200, "heapBytes": 2400, "allocMicros": 20,
+         "fillMicros": 40, "postLoadMicros": 0},
+        {"name": "Instance", "class": "Café", "objects": 1,
+         "snapshotBytes": 8, "heapBytes": 16, "allocMicros": 1,
+         "fillMicros": 1, "postLoadMicros": 0},
+        {"name": "Double", "objects": 3, "snapshotBytes": 24,
+         "heapBytes": 48, "allocMicros": 1, "fillMicros": 3,
+         "postLoadMicros": 0}
+      ],
+      "totals": {"loadMicros": 140}
+    }
+  ]
+}
+''';
+
+// The numbers of a row of the diff and the cluster it describes.
+List<Object> parseRow(String line) {
+  final fields = line.trim().split(RegExp(r'\s+'));
+  return <Object>[
+    ...fields.take(6).map(int.parse),
+    fields.skip(6).join(' '),
+  ];
+}
+
+main() async {
+  // We don't have access to the SDK on Android.
+  if (Platform.isAndroid) {
+    return;
+  }
+
+  final analyzeSnapshot = path.join(
+    buildDir,
+    'analyze_snapshot' + (Platform.isWindows ? '.exe' : ''),
+  );
+
+  await withTempDir('analyze_snapshot_load_reports', (String tempDir) async {
+    final beforePath = path.join(tempDir, 'before.json');
+    final afterPath = path.join(tempDir, 'after.json');
+    await File(beforePath).writeAsString(before);
+    await File(afterPath).writeAsString(after);
+
+    final lines = await runOutput(analyzeSnapshot, <String>[
+      '--diff_load_reports',
+      beforePath,
+      afterPath,
+    ]);
+    Expect.equals(5, lines.length, lines.join('\n'));
+    Expect.isTrue(lines[0].trim().startsWith('old us'));
+    // Unchanged clusters are left out.
+    Expect.listEquals(<Object>[
+      30,
+      60,
+      30,
+      10,
+      200,
+      400,
+      'main unit 1 String canonical',
+    ], parseRow(lines[1]));
+    Expect.listEquals(<Object>[
+      0,
+      4,
+      4,
+      3,
+      24,
+      48,
+      'main unit 1 Double',
+    ], parseRow(lines[2]));
+    Expect.listEquals(<Object>[
+      47,
+      81,
+      34,
+      13,
+      224,
+      448,
+      'total (clusters)',
+    ], parseRow(lines[3]));
+    final loads = lines[4].trim().split(RegExp(r'\s+'));
+    Expect.listEquals(<String>[
+      '100',
+      '140',
+      '+40',
+      'total',
+      '(loads)',
+    ], loads);
+
+    // Reports that cannot be parsed are rejected.
+    final brokenPath = path.join(tempDir, 'broken.json');
+    await File(brokenPath).writeAsString(before.substring(0, 100));
+    final errors = await runError(analyzeSnapshot, <String>[
+      '--diff_load_reports',
+      beforePath,
+      brokenPath,
+    ]);
+    Expect.isTrue(
+      errors.any((line) => line.contains('Not a snapshot load report')),
+    );
+  });
+}
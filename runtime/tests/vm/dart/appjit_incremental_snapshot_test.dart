@@ -0,0 +1,95 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verify that --incremental-snapshot skips the training run of an app-jit
+// snapshot whose libraries and training arguments did not change, and reports
+// the changed libraries and their dependants otherwise.
+
+import 'dart:async';
+import 'dart:io';
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as p;
+
+import 'snapshot_test_helper.dart';
+
+String library({int value = 1, int start = 0, String label = 'a'}) => '''
+class Counter {
+  int start = $start;
+  int get current => $value + start;
+}
+
+int value() => Counter().current;
+
+String label() => const ['$label'].first;
+''';
+
+const String mainSource = '''
+import 'lib.dart';
+
+void main() {
+  print('OK(Trained \${value()} \${label()})');
+}
+''';
+
+Future<void> main() async {
+  await withTempDir('incremental-snapshot', (String temp) async {
+    final snapshotPath = p.join(temp, 'app.jit');
+    final mainPath = p.join(temp, 'main.dart');
+    final libPath = p.join(temp, 'lib.dart');
+    File(mainPath).writeAsStringSync(mainSource);
+    File(libPath).writeAsStringSync(library());
+
+    final depfilePath = p.join(temp, 'app.jit.d');
+    Future<Result> train([List<String> arguments = const []]) =>
+        runDart('TRAINING RUN', [
+          '--snapshot=$snapshotPath',
+          '--snapshot-kind=app-jit',
+          '--incremental-snapshot',
+          '--depfile=$depfilePath',
+          mainPath,
+          ...arguments,
+        ]);
+
+    Future<void> expectRetrained(String output) async {
+      final outOfDate = await train();
+      Expect.contains('1 libraries changed, 1 libraries depend on them',
+          outOfDate.output);
+      Expect.contains('lib.dart', outOfDate.output);
+      Expect.contains('main.dart', outOfDate.output);
+      Expect.isTrue(outOfDate.output.endsWith(output), outOfDate.output);
+    }
+
+    expectOutput('OK(Trained 1 a)', await train());
+    Expect.isTrue(File('$snapshotPath.fingerprints').existsSync());
+
+    File(depfilePath).deleteSync();
+    final upToDate = await train();
+    Expect.contains('is up to date, skipping training', upToDate.output);
+    // The depfile is written even though the snapshot is kept.
+    final depfile = File(depfilePath).readAsStringSync();
+    Expect.isTrue(depfile.startsWith('$snapshotPath: '), depfile);
+    Expect.contains('lib.dart', depfile);
+
+    // Only an integer literal in the body of a getter changed. Fingerprints
+    // are taken from kernel before main runs, so the class has not been
+    // loaded yet.
+    File(libPath).writeAsStringSync(library(value: 2));
+    await expectRetrained('OK(Trained 2 a)');
+
+    // Only a field initializer changed.
+    File(libPath).writeAsStringSync(library(value: 2, start: 1));
+    await expectRetrained('OK(Trained 3 a)');
+
+    // Only the value of a constant changed.
+    File(libPath).writeAsStringSync(library(value: 2, start: 1, label: 'b'));
+    await expectRetrained('OK(Trained 3 b)');
+
+    // The program did not change, but it is trained with another argument.
+    final otherArguments = await train(['--other']);
+    Expect.contains('was trained with another package config or other '
+        'arguments', otherArguments.output);
+    Expect.isTrue(otherArguments.output.endsWith('OK(Trained 3 b)'));
+  });
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that an ELF snapshot created with gen_snapshot --compress-snapshot
+// is smaller than the uncompressed snapshot and runs the same way.
+
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const script = '''
+final table = <String, int>{
+  for (int i = 0; i < 1000; i++) 'key\$i': i * i,
+};
+
+void main(List<String> args) {
+  int sum = 0;
+  for (final value in table.values) {
+    sum += value;
+  }
+  print('sum: \$sum');
+}
+''';
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('compressed-snapshot-test', (String tempDir) async {
+    final scriptPath = path.join(tempDir, 'script.dart');
+    await File(scriptPath).writeAsString(script);
+    final scriptDill = path.join(tempDir, 'script.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      scriptPath,
+    ]);
+
+    final elfSnapshot = path.join(tempDir, 'script.so');
+    final compressedSnapshot = path.join(tempDir, 'script.compressed.so');
+    await createSnapshot(scriptDill, SnapshotType.elf, elfSnapshot);
+    await createSnapshot(scriptDill, SnapshotType.elf, compressedSnapshot, [
+      '--compress-snapshot',
+    ]);
+
+    final elfSize = await File(elfSnapshot).length();
+    final compressedSize = await File(compressedSnapshot).length();
+    print('ELF snapshot: $elfSize bytes, compressed: $compressedSize bytes');
+    Expect.isTrue(compressedSize < elfSize);
+
+    final expected = await runOutput(dartPrecompiledRuntime, [elfSnapshot]);
+    final actual = await runOutput(dartPrecompiledRuntime, [
+      compressedSnapshot,
+    ]);
+    Expect.listEquals(<String>['sum: 332833500'], expected);
+    Expect.listEquals(expected, actual);
+
+    // Only ELF snapshots can be compressed.
+    final errors = await runError(genSnapshot, <String>[
+      '--compress-snapshot',
+      '--snapshot-kind=app-aot-assembly',
+      '--assembly=${path.join(tempDir, 'script.S')}',
+      scriptDill,
+    ]);
+    Expect.isTrue(
+      errors.any((line) => line.contains('--compress-snapshot is only')),
+    );
+  });
+}
@@ -119,7 +119,9 @@ main() {
     "Dart_GetDataFromByteBuffer",
     "Dart_GetDefaultUserTag",
     "Dart_GetError",
+    "Dart_GetEventLoopLatency",
     "Dart_GetField",
+    "Dart_GetLibraryFingerprints",
     "Dart_GetLoadedLibraries",
     "Dart_GetMainPortId",
     "Dart_GetMessageNotifyCallback",
@@ -141,6 +143,7 @@ main() {
     "Dart_GetNullableType",
     "Dart_GetObfuscationMap",
     "Dart_GetPeer",
+    "Dart_GetSnapshotLoadReport",
     "Dart_GetStaticMethodClosure",
     "Dart_GetStickyError",
     "Dart_GetCurrentThreadOwnsIsolate",
@@ -297,6 +300,7 @@ main() {
     "Dart_SendPortGetIdEx",
     "Dart_ServiceSendDataEvent",
     "Dart_SetBooleanReturnValue",
+    "Dart_SetContinuousProfileCallback",
     "Dart_SetCurrentUserTag",
     "Dart_SetDartLibrarySourcesKernel",
     "Dart_SetDeferredLoadHandler",
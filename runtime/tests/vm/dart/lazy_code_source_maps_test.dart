@@ -0,0 +1,95 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that symbolic stack traces are the same when code source maps are
+// left in the snapshot with --lazy_snapshot_clusters=CodeSourceMap, and that
+// only the maps of the code in those stack traces are materialized.
+
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const script = '''
+@pragma('vm:never-inline')
+void thrower(int depth) {
+  if (depth == 0) {
+    throw StateError('boom');
+  }
+  inlined(depth - 1);
+}
+
+@pragma('vm:prefer-inline')
+void inlined(int depth) => thrower(depth);
+
+void main() {
+  // Twice, so the second stack trace reuses the materialized maps.
+  for (int i = 0; i < 2; i++) {
+    try {
+      thrower(3);
+    } catch (e, st) {
+      for (final line in st.toString().split('\\n')) {
+        if (line.contains('script.dart')) {
+          print(line.trim());
+        }
+      }
+    }
+  }
+}
+''';
+
+const lazyFlags = <String>[
+  '--lazy-snapshot-clusters=CodeSourceMap',
+  '--print-lazy-snapshot-statistics',
+];
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('lazy-code-source-maps-test', (String tempDir) async {
+    final scriptPath = path.join(tempDir, 'script.dart');
+    await File(scriptPath).writeAsString(script);
+    final scriptDill = path.join(tempDir, 'script.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      scriptPath,
+    ]);
+
+    final snapshot = path.join(tempDir, 'script.so');
+    await createSnapshot(scriptDill, SnapshotType.elf, snapshot);
+
+    final expected = await runOutput(dartPrecompiledRuntime, [snapshot]);
+    Expect.isTrue(expected.any((line) => line.contains('thrower')));
+    Expect.isTrue(expected.any((line) => line.contains('inlined')));
+    Expect.isTrue(expected.any((line) => line.contains('main')));
+    Expect.isTrue(expected.any((line) => line.contains('script.dart:4:')));
+
+    final result = await runHelper(dartPrecompiledRuntime, [
+      ...lazyFlags,
+      snapshot,
+    ]);
+    Expect.equals(0, result.exitCode);
+    Expect.listEquals(expected, (result.stdout as String).trim().split('\n'));
+
+    final statistics = RegExp(
+      r'Lazy snapshot objects: (\d+) of (\d+) materialized',
+    ).firstMatch(result.stderr as String);
+    Expect.isNotNull(statistics);
+    final materialized = int.parse(statistics!.group(1)!);
+    final deferred = int.parse(statistics.group(2)!);
+    Expect.isTrue(materialized > 0);
+    Expect.isTrue(materialized < deferred);
+  });
+}
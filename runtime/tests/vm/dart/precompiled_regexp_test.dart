@@ -0,0 +1,84 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that a RegExp created with constant arguments is compiled into an
+// AOT snapshot, so matching it at runtime compiles no bytecode.
+
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const script = '''
+void main(List<String> args) {
+  final re = args.isEmpty ? RegExp(r'(a|b)+c') : RegExp(args[0]);
+  print('match: \${re.firstMatch('xxababc')?.group(0)}');
+}
+''';
+
+// Prints the bytecode of every RegExp compiled at runtime.
+const traceFlags = <String>[
+  '--regexp-peephole-optimization',
+  '--trace-regexp-peephole-optimization',
+];
+
+bool compiledRegExp(List<String> lines) =>
+    lines.any((line) => line.startsWith('[optimized:'));
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('precompiled-regexp-test', (String tempDir) async {
+    final scriptPath = path.join(tempDir, 'script.dart');
+    await File(scriptPath).writeAsString(script);
+    final scriptDill = path.join(tempDir, 'script.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      scriptPath,
+    ]);
+
+    final snapshot = path.join(tempDir, 'script.so');
+    final uncompiledSnapshot = path.join(tempDir, 'script.uncompiled.so');
+    await createSnapshot(scriptDill, SnapshotType.elf, snapshot);
+    await createSnapshot(scriptDill, SnapshotType.elf, uncompiledSnapshot, [
+      '--no-precompile-regexps',
+    ]);
+
+    // The constant RegExp is served from the snapshot.
+    final precompiled = await runOutput(dartPrecompiledRuntime, [
+      ...traceFlags,
+      snapshot,
+    ]);
+    Expect.isTrue(precompiled.contains('match: ababc'));
+    Expect.isFalse(compiledRegExp(precompiled));
+
+    // Without --precompile-regexps it is compiled when it is first used.
+    final uncompiled = await runOutput(dartPrecompiledRuntime, [
+      ...traceFlags,
+      uncompiledSnapshot,
+    ]);
+    Expect.isTrue(uncompiled.contains('match: ababc'));
+    Expect.isTrue(compiledRegExp(uncompiled));
+
+    // RegExps created from runtime values are compiled when first used.
+    final fromArgument = await runOutput(dartPrecompiledRuntime, [
+      ...traceFlags,
+      snapshot,
+      r'(a|b)+c$',
+    ]);
+    Expect.isTrue(fromArgument.contains('match: ababc'));
+    Expect.isTrue(compiledRegExp(fromArgument));
+  });
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verify that loops whose allocations can be reused across iterations compute
+// the same results as the same loops with escaping allocations.
+
+// VMOptions=
+// VMOptions=--reuse-loop-allocations
+
+import 'package:expect/expect.dart';
+
+final List<Object?> escaped = [];
+
+@pragma('vm:never-inline')
+int arrayElements(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    final l = List<int?>.filled(3, null);
+    if (i % 2 == 0) l[0] = i;
+    l[i % 3] = i + 1;
+    sum += (l[0] ?? -1) + (l[1] ?? -2) + (l[2] ?? -3);
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int arrayElementsEscaping(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    final l = List<int?>.filled(3, null);
+    escaped.add(l);
+    if (i % 2 == 0) l[0] = i;
+    l[i % 3] = i + 1;
+    sum += (l[0] ?? -1) + (l[1] ?? -2) + (l[2] ?? -3);
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int records(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    final r = (i, b: i * 2);
+    sum += r.$1 - r.b;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int recordsEscaping(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    final r = (i, b: i * 2);
+    escaped.add(r);
+    sum += r.$1 - r.b;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int contexts(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    int captured = i;
+    int get() => captured;
+    captured += 1;
+    sum += get();
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int contextsEscaping(int n) {
+  final closures = <int Function()>[];
+  for (int i = 0; i < n; i++) {
+    int captured = i;
+    closures.add(() => captured);
+    captured += 1;
+  }
+  int sum = 0;
+  for (final closure in closures) {
+    sum += closure();
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int previousIteration(int n) {
+  List<int>? previous;
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    final l = List<int>.filled(2, i);
+    sum += previous?[0] ?? 0;
+    previous = l;
+  }
+  return sum;
+}
+
+void main() {
+  for (int n in [0, 1, 2, 3, 10, 100]) {
+    Expect.equals(arrayElementsEscaping(n), arrayElements(n), 'arrays $n');
+    Expect.equals(recordsEscaping(n), records(n), 'records $n');
+    Expect.equals(contextsEscaping(n), contexts(n), 'contexts $n');
+    Expect.equals(n <= 1 ? 0 : (n - 1) * (n - 2) ~/ 2, previousIteration(n),
+        'previous iteration $n');
+  }
+  // Run the loops again after they had a chance to be optimized.
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(arrayElementsEscaping(50), arrayElements(50));
+    Expect.equals(recordsEscaping(50), records(50));
+    Expect.equals(contextsEscaping(50), contexts(50));
+    Expect.equals(49 * 48 ~/ 2, previousIteration(50));
+  }
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that a JIT training run with --write_startup_code_order_to records
+// closures under distinct keys, that gen_snapshot --startup_code_order places
+// the recorded functions at the start of the text section, and that
+// dartaotruntime --prefetch_snapshot_text validates its value.
+
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const script = '''
+int run(int x) {
+  final add = (int y) => x + y;
+  final multiply = (int y) => x * y;
+  return add(1) + multiply(2);
+}
+
+void main(List<String> args) {
+  print('result: \${run(3)}');
+}
+''';
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('startup-code-order-test', (String tempDir) async {
+    final scriptPath = path.join(tempDir, 'script.dart');
+    await File(scriptPath).writeAsString(script);
+    final jitDill = path.join(tempDir, 'script.jit.dill');
+    await run(genKernel, <String>[
+      '--platform=$platformDill',
+      '-o',
+      jitDill,
+      scriptPath,
+    ]);
+    final aotDill = path.join(tempDir, 'script.aot.dill');
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      aotDill,
+      scriptPath,
+    ]);
+
+    // Training run.
+    final order = path.join(tempDir, 'order.txt');
+    final training = await runOutput(dart, [
+      '--write-startup-code-order-to=$order',
+      jitDill,
+    ]);
+    Expect.listEquals(<String>['result: 10'], training);
+    final keys = await File(order).readAsLines();
+    Expect.equals(keys.length, keys.toSet().length);
+    final closures = keys
+        .where((key) => key.contains('script.dart'))
+        .where((key) => key.contains('<anonymous closure>'))
+        .toList();
+    Expect.equals(2, closures.length, '$closures');
+
+    final snapshot = path.join(tempDir, 'script.so');
+    final result = await runHelper(genSnapshot, <String>[
+      '--deterministic',
+      '--startup-code-order=$order',
+      '--trace-startup-code-order',
+      '--snapshot-kind=app-aot-elf',
+      '--elf=$snapshot',
+      aotDill,
+    ]);
+    Expect.equals(0, result.exitCode);
+    final match = RegExp(
+      r'Startup code: (\d+) functions within the first (\d+) bytes',
+    ).firstMatch(result.stderr as String);
+    Expect.isNotNull(match);
+    Expect.isTrue(int.parse(match!.group(1)!) > 0);
+    final startupBytes = match.group(2)!;
+
+    Expect.listEquals(
+      <String>['result: 10'],
+      await runOutput(dartPrecompiledRuntime, [
+        '--prefetch-snapshot-text=$startupBytes',
+        snapshot,
+      ]),
+    );
+    // Values past the end of the text section are clamped.
+    Expect.listEquals(
+      <String>['result: 10'],
+      await runOutput(dartPrecompiledRuntime, [
+        '--prefetch-snapshot-text=1000000000000',
+        snapshot,
+      ]),
+    );
+    final errors = await runError(dartPrecompiledRuntime, [
+      '--prefetch-snapshot-text=lots',
+      snapshot,
+    ]);
+    Expect.isTrue(
+      errors.any((line) => line.contains('Invalid --prefetch_snapshot_text')),
+    );
+  });
+}
@@ -22,13 +22,17 @@
 #include "vm/growable_array.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/json_writer.h"
+#include "vm/lockers.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/program_visitor.h"
 #include "vm/raw_object_fields.h"
+#include "vm/startup_code_order.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/v8_snapshot_writer.h"
 #include "vm/version.h"
@@ -49,6 +53,44 @@ DEFINE_FLAG(bool,
             "Print information about clusters written to snapshot");
 #endif
 
+DEFINE_FLAG(int,
+            snapshot_fill_tasks,
+            4,
+            "The number of helper tasks to spawn for initializing the objects "
+            "of independent clusters while reading a snapshot (0 means fill "
+            "all clusters on the main thread).");
+DEFINE_FLAG(int,
+            snapshot_parallel_fill_min_bytes,
+            16 * KB,
+            "Clusters whose fill section is smaller than this are filled on "
+            "the main thread even when --snapshot_fill_tasks allows helpers.");
+
+DEFINE_FLAG(bool,
+            record_snapshot_load_report,
+            false,
+            "Record the number of objects, snapshot and heap bytes and the "
+            "time spent reading each cluster of the snapshots loaded "
+            "(see Dart_GetSnapshotLoadReport).");
+DEFINE_FLAG(charp,
+            write_snapshot_load_report_to,
+            nullptr,
+            "Write the snapshot load report (see --record_snapshot_load_report) "
+            "as JSON to the given file at VM shutdown.");
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+DEFINE_FLAG(charp,
+            lazy_snapshot_clusters,
+            nullptr,
+            "Comma-separated names of clusters whose objects are left in the "
+            "isolate snapshot and only materialized on first access. "
+            "Supported: CodeSourceMap.");
+DEFINE_FLAG(bool,
+            print_lazy_snapshot_statistics,
+            false,
+            "Print how many of the objects left in the snapshot by "
+            "--lazy_snapshot_clusters were materialized at VM shutdown.");
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 #if defined(DART_PRECOMPILER)
 DEFINE_FLAG(charp,
             write_v8_snapshot_profile_to,
@@ -236,6 +278,16 @@ class DeserializationCluster : public ZoneObject {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill only reads the cluster's fill section and initializes the
+  // cluster's own objects, without consulting or updating any other VM state.
+  // Such clusters may be filled on a helper thread, concurrently with the
+  // other clusters (see Deserializer::ReadFill).
+  virtual bool CanFillInParallel() const { return false; }
+
+  // Called on the isolate thread with the stream positioned at the start of
+  // the cluster's fill section, before any cluster is filled.
+  virtual void PrepareFill(Deserializer* deserializer) {}
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(Deserializer* deserializer, const Array& refs) {
@@ -252,6 +304,19 @@ class DeserializationCluster : public ZoneObject {
   const char* name() const { return name_; }
   bool is_canonical() const { return is_canonical_; }
   bool is_deeply_immutable() const { return is_deeply_immutable_; }
+  intptr_t num_objects() const { return stop_index_ - start_index_; }
+
+  // What reading the cluster cost, recorded for the snapshot load report
+  // (see --record_snapshot_load_report).
+  struct LoadStats {
+    intptr_t cid = kIllegalCid;
+    intptr_t snapshot_bytes = 0;
+    intptr_t heap_bytes = 0;
+    int64_t alloc_micros = 0;
+    int64_t fill_micros = 0;
+    int64_t post_load_micros = 0;
+  };
+  LoadStats* load_stats() { return &load_stats_; }
 
  protected:
   void ReadAllocFixedSize(Deserializer* deserializer, intptr_t instance_size);
@@ -262,6 +327,7 @@ class DeserializationCluster : public ZoneObject {
   // The range of the ref array that belongs to this cluster.
   intptr_t start_index_;
   intptr_t stop_index_;
+  LoadStats load_stats_;
 };
 
 class SerializationRoots {
@@ -762,6 +828,21 @@ class Deserializer : public ThreadStackResource {
 
   DeserializationCluster* ReadCluster();
 
+  // While in scope, Deserializer::Local on the current thread reads from
+  // [stream] rather than from the deserializer's own stream. Used to fill
+  // clusters on helper threads, each from its own fill section.
+  class FillStreamScope : public ValueObject {
+   public:
+    explicit FillStreamScope(ReadStream* stream) {
+      ASSERT(fill_stream_ == nullptr);
+      fill_stream_ = stream;
+    }
+    ~FillStreamScope() { fill_stream_ = nullptr; }
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(FillStreamScope);
+  };
+
   void ReadDispatchTable() {
     ReadDispatchTable(&stream_, /*deferred=*/false, InstructionsTable::Handle(),
                       -1, -1);
@@ -783,6 +864,7 @@ class Deserializer : public ThreadStackResource {
 #endif
   }
   bool is_non_root_unit() const { return is_non_root_unit_; }
+  void set_loading_unit_id(intptr_t value) { loading_unit_id_ = value; }
   void set_code_start_index(intptr_t value) { code_start_index_ = value; }
   intptr_t code_start_index() const { return code_start_index_; }
   void set_code_stop_index(intptr_t value) { code_stop_index_ = value; }
@@ -804,16 +886,8 @@ class Deserializer : public ThreadStackResource {
   class Local : public ReadStream {
    public:
     explicit Local(Deserializer* d)
-        : ReadStream(d->stream_.buffer_, d->stream_.current_, d->stream_.end_),
-          d_(d),
-          refs_(d->refs_),
-          null_(Object::null()) {
-#if defined(DEBUG)
-      // Can't mix use of Deserializer::Read*.
-      d->stream_.current_ = nullptr;
-#endif
-    }
-    ~Local() { d_->stream_.current_ = current_; }
+        : Local(d, fill_stream_ != nullptr ? fill_stream_ : &d->stream_) {}
+    ~Local() { stream_->current_ = current_; }
 
     ObjectPtr Ref(intptr_t index) const {
       ASSERT(index > 0);
@@ -857,12 +931,40 @@ class Deserializer : public ThreadStackResource {
     ObjectPtr null() const { return null_; }
 
    private:
+    Local(Deserializer* d, ReadStream* stream)
+        : ReadStream(stream->buffer_, stream->current_, stream->end_),
+          d_(d),
+          stream_(stream),
+          refs_(d->refs_),
+          null_(Object::null()) {
+#if defined(DEBUG)
+      // Can't mix use of Deserializer::Read*.
+      stream->current_ = nullptr;
+#endif
+    }
+
     Deserializer* const d_;
+    ReadStream* const stream_;
     const ArrayPtr refs_;
     const ObjectPtr null_;
   };
 
  private:
+  // Reads the fill sections of all clusters, filling the clusters that
+  // CanFillInParallel on helper threads when --snapshot_fill_tasks allows.
+  void ReadFill();
+
+  // Whether the objects of the cluster named [name] are left in the snapshot
+  // (see --lazy_snapshot_clusters).
+  bool IsLazyCluster(const char* name) const;
+
+  // Adds the statistics of the clusters just read to the snapshot load report.
+  void AddToLoadReport(int64_t total_micros);
+
+  // The stream ReadFill on the current thread reads from instead of [stream_],
+  // see FillStreamScope.
+  static inline thread_local ReadStream* fill_stream_ = nullptr;
+
   Heap* heap_;
   PageSpace* old_space_;
   FreeList* freelist_;
@@ -882,11 +984,15 @@ class Deserializer : public ThreadStackResource {
   intptr_t instructions_index_ = 0;
   DeserializationCluster** clusters_;
   const bool is_non_root_unit_;
+  intptr_t loading_unit_id_ = LoadingUnit::kRootId;
+  // Bytes allocated in old space for the objects read so far.
+  intptr_t allocated_bytes_ = 0;
   InstructionsTable& instructions_table_;
 };
 
 DART_FORCE_INLINE
 ObjectPtr Deserializer::Allocate(intptr_t size) {
+  allocated_bytes_ += size;
   return UntaggedObject::FromAddr(
       old_space_->AllocateSnapshotLocked(freelist_, size));
 }
@@ -1240,15 +1346,25 @@ class CanonicalSetSerializationCluster : public SerializationCluster {
     table_length_ = arr.Length();
   }
 
+  // Writes the size of the canonical set as part of the alloc section, so the
+  // deserializer can allocate it along with the cluster's objects.
   void WriteCanonicalSetLayout(Serializer* s) {
     if (represents_canonical_set_) {
       s->WriteUnsigned(table_length_);
       s->WriteUnsigned(objects_.length() - gaps_.length());
+      target_memory_size_ +=
+          compiler::target::Array::InstanceSize(table_length_);
+    }
+  }
+
+  // Writes the positions of the cluster's objects within the canonical set as
+  // part of the fill section, so the deserializer can populate the set
+  // together with the cluster's objects.
+  void WriteCanonicalSetGaps(Serializer* s) {
+    if (represents_canonical_set_) {
       for (auto gap : gaps_) {
         s->WriteUnsigned(gap);
       }
-      target_memory_size_ +=
-          compiler::target::Array::InstanceSize(table_length_);
     }
   }
 
@@ -1272,7 +1388,8 @@ class CanonicalSetDeserializationCluster : public DeserializationCluster {
         is_root_unit_(is_root_unit),
         table_(SetType::ArrayHandle::Handle()) {}
 
-  void BuildCanonicalSetFromLayout(Deserializer* d) {
+  // Allocates the canonical set during ReadAlloc.
+  void AllocateCanonicalSet(Deserializer* d) {
     if (!is_root_unit_ || !is_canonical()) {
       return;
     }
@@ -1280,12 +1397,24 @@ class CanonicalSetDeserializationCluster : public DeserializationCluster {
     const auto table_length = d->ReadUnsigned();
     first_element_ = d->ReadUnsigned();
     const intptr_t count = stop_index_ - (start_index_ + first_element_);
-    auto table = StartDeserialization(d, table_length, count);
+    table_ = StartDeserialization(d, table_length, count);
+  }
+
+  // Populates the canonical set allocated by AllocateCanonicalSet during
+  // ReadFill. Only touches the set itself, so it can be done on the helper
+  // thread filling the cluster.
+  void BuildCanonicalSetFromLayout(Deserializer::Local* d) {
+    if (!is_root_unit_ || !is_canonical()) {
+      return;
+    }
+
+    DeserializationFinger table = {table_.ptr(), SetType::kFirstKeyIndex,
+                                   SetType::UnusedMarker().ptr()};
     for (intptr_t i = start_index_ + first_element_; i < stop_index_; i++) {
       table.FillGap(d->ReadUnsigned());
-      table.WriteElement(d, d->Ref(i));
+      table.WriteElement(d->Ref(i));
     }
-    table_ = table.Finish();
+    table.Finish();
   }
 
  protected:
@@ -1330,7 +1459,7 @@ class CanonicalSetDeserializationCluster : public DeserializationCluster {
       current_index += length;
     }
 
-    void WriteElement(Deserializer* d, ObjectPtr object) {
+    void WriteElement(ObjectPtr object) {
       table->untag()->data()[current_index++] = object;
     }
 
@@ -1344,9 +1473,9 @@ class CanonicalSetDeserializationCluster : public DeserializationCluster {
     }
   };
 
-  static DeserializationFinger StartDeserialization(Deserializer* d,
-                                                    intptr_t length,
-                                                    intptr_t count) {
+  static typename SetType::ArrayPtr StartDeserialization(Deserializer* d,
+                                                         intptr_t length,
+                                                         intptr_t count) {
     const intptr_t instance_size = SetType::ArrayHandle::InstanceSize(length);
     typename SetType::ArrayPtr table =
         static_cast<typename SetType::ArrayPtr>(d->Allocate(instance_size));
@@ -1363,7 +1492,7 @@ class CanonicalSetDeserializationCluster : public DeserializationCluster {
       table->untag()->data()[i] = Smi::New(0);
     }
     table->untag()->data()[SetType::kOccupiedEntriesIndex] = Smi::New(count);
-    return {table, SetType::kFirstKeyIndex, SetType::UnusedMarker().ptr()};
+    return table;
   }
 
   static void InitTypeArgsOrNext(ArrayPtr table) {
@@ -1428,6 +1557,8 @@ class TypeParametersDeserializationCluster : public DeserializationCluster {
     ReadAllocFixedSize(d, TypeParameters::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -1485,6 +1616,7 @@ class TypeArgumentsSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     const intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       TypeArgumentsPtr type_args = objects_[i];
@@ -1525,11 +1657,14 @@ class TypeArgumentsDeserializationCluster
       d->AssignRef(d->Allocate(TypeArguments::InstanceSize(length)));
     }
     stop_index_ = d->next_index();
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     const bool mark_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
@@ -1926,7 +2061,10 @@ class FunctionDeserializationCluster : public DeserializationCluster {
       for (intptr_t i = start_index_, n = stop_index_; i < n; i++) {
         func ^= refs.At(i);
         code = func.CurrentCode();
-        if (func.HasCode() && !code.IsDisabled()) {
+        // A training run for --startup_code_order compiles every function
+        // on first use, so that its first execution is recorded.
+        if (func.HasCode() && !code.IsDisabled() &&
+            !StartupCodeOrder::IsRecording()) {
           func.SetInstructionsSafe(code);  // Set entrypoint.
           func.SetWasCompiled(true);
         } else {
@@ -2678,6 +2816,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t startup_rank;   // Position in --startup_code_order.
     intptr_t instructions_id;
   };
 
@@ -2692,10 +2831,15 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // Within each of the two groups, code executed during startup (see
+  // StartupCodeOrder) comes first in the order of its first execution.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->startup_rank < b->startup_rank) return -1;
+    if (a->startup_rank > b->startup_rank) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2722,6 +2866,17 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.startup_rank = StartupCodeOrder::kNotInStartupOrder;
+#if defined(DART_PRECOMPILER)
+    if (FLAG_precompiled_mode && StartupCodeOrder::IsEnabled()) {
+      ObjectPtr owner =
+          WeakSerializationReference::Unwrap(code->untag()->owner());
+      if (owner->IsHeapObject() && owner->GetClassId() == kFunctionCid) {
+        info.startup_rank =
+            StartupCodeOrder::RankOf(Function::Handle(Function::RawCast(owner)));
+      }
+    }
+#endif
     order_list->Add(info);
   }
 
@@ -3492,6 +3647,8 @@ class PcDescriptorsDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3553,8 +3710,8 @@ class CodeSourceMapSerializationCluster : public SerializationCluster {
 
 class CodeSourceMapDeserializationCluster : public DeserializationCluster {
  public:
-  CodeSourceMapDeserializationCluster()
-      : DeserializationCluster("CodeSourceMap") {}
+  explicit CodeSourceMapDeserializationCluster(bool is_lazy)
+      : DeserializationCluster("CodeSourceMap"), is_lazy_(is_lazy) {}
   ~CodeSourceMapDeserializationCluster() {}
 
   void ReadAlloc(Deserializer* d) override {
@@ -3562,14 +3719,62 @@ class CodeSourceMapDeserializationCluster : public DeserializationCluster {
     const intptr_t count = d->ReadUnsigned();
     for (intptr_t i = 0; i < count; i++) {
       const intptr_t length = d->ReadUnsigned();
-      d->AssignRef(d->Allocate(CodeSourceMap::InstanceSize(length)));
+      if (is_lazy_) {
+        // The index of the map in ObjectStore::lazy_code_source_maps.
+        d->AssignRef(Smi::New(i));
+      } else {
+        d->AssignRef(d->Allocate(CodeSourceMap::InstanceSize(length)));
+      }
     }
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+  void PrepareFill(Deserializer* d) override {
+    if (!is_lazy_) return;
+
+    // Remember the position of each map's fill data, which
+    // LazySnapshotObjects::MaterializeCodeSourceMap reads on first access.
+    const intptr_t start = d->position();
+    const intptr_t count = stop_index_ - start_index_;
+    positions_ = d->zone()->Alloc<intptr_t>(count);
+    intptr_t size = 0;
+    for (intptr_t i = 0; i < count; i++) {
+      positions_[i] = d->position();
+      RELEASE_ASSERT(Smi::IsValid(positions_[i]));
+      const intptr_t length = d->ReadUnsigned();
+      d->Advance(length);
+      size += CodeSourceMap::InstanceSize(length);
+    }
+    fill_size_ = d->position() - start;
+    LazySnapshotObjects::RecordDeferred(count, size);
+  }
+
+  void PostLoad(Deserializer* d, const Array& refs) override {
+    if (!is_lazy_) return;
+
+    // Code objects sharing a map refer to the same index, so the map is
+    // materialized once.
+    auto object_store = d->isolate_group()->object_store();
+    ASSERT(object_store->lazy_code_source_maps() == Array::null());
+    const intptr_t count = stop_index_ - start_index_;
+    const auto& maps = Array::Handle(d->zone(), Array::New(count, Heap::kOld));
+    for (intptr_t i = 0; i < count; i++) {
+      maps.SetAt(i, Smi::Handle(d->zone(), Smi::New(positions_[i])));
+    }
+    object_store->set_lazy_code_source_maps(maps);
+  }
+#endif
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
+    if (is_lazy_) {
+      d.Advance(fill_size_);
+      return;
+    }
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
       const intptr_t length = d.ReadUnsigned();
       CodeSourceMapPtr map = static_cast<CodeSourceMapPtr>(d.Ref(id));
@@ -3580,6 +3785,11 @@ class CodeSourceMapDeserializationCluster : public DeserializationCluster {
       d.ReadBytes(cdata, length);
     }
   }
+
+ private:
+  const bool is_lazy_;
+  intptr_t fill_size_ = 0;
+  intptr_t* positions_ = nullptr;
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -3645,6 +3855,8 @@ class CompressedStackMapsDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3725,9 +3937,7 @@ class RODataSerializationCluster
     WriteCanonicalSetLayout(s);
   }
 
-  void WriteFill(Serializer* s) {
-    // No-op.
-  }
+  void WriteFill(Serializer* s) { WriteCanonicalSetGaps(s); }
 
  private:
   const char* const type_;
@@ -3760,11 +3970,18 @@ class RODataDeserializationCluster
     }
     stop_index_ = d->next_index();
     if (cid_ == kStringCid) {
-      BuildCanonicalSetFromLayout(d);
+      AllocateCanonicalSet(d);
     }
   }
 
-  void ReadFill(Deserializer* d_) override {}
+  bool CanFillInParallel() const override { return true; }
+
+  void ReadFill(Deserializer* d_) override {
+    if (cid_ == kStringCid) {
+      Deserializer::Local d(d_);
+      BuildCanonicalSetFromLayout(&d);
+    }
+  }
 
   void PostLoad(Deserializer* d, const Array& refs) override {
     if (!table_.IsNull()) {
@@ -3855,6 +4072,8 @@ class LocalVarDescriptorsDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -3949,6 +4168,8 @@ class ExceptionHandlersDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4041,6 +4262,8 @@ class ContextDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4121,6 +4344,8 @@ class ContextScopeDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -4883,6 +5108,8 @@ class InstanceDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5038,6 +5265,7 @@ class TypeSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       WriteType(s, objects_[i]);
@@ -5094,11 +5322,14 @@ class TypeDeserializationCluster
 
   void ReadAlloc(Deserializer* d) override {
     ReadAllocFixedSize(d, Type::InstanceSize());
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     const bool mark_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
@@ -5180,6 +5411,7 @@ class FunctionTypeSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       WriteFunctionType(s, objects_[i]);
@@ -5210,11 +5442,14 @@ class FunctionTypeDeserializationCluster
 
   void ReadAlloc(Deserializer* d) override {
     ReadAllocFixedSize(d, FunctionType::InstanceSize());
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     const bool mark_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
@@ -5299,6 +5534,7 @@ class RecordTypeSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       WriteRecordType(s, objects_[i]);
@@ -5327,11 +5563,14 @@ class RecordTypeDeserializationCluster
 
   void ReadAlloc(Deserializer* d) override {
     ReadAllocFixedSize(d, RecordType::InstanceSize());
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     const bool mark_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
@@ -5414,6 +5653,7 @@ class TypeParameterSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       WriteTypeParameter(s, objects_[i]);
@@ -5444,11 +5684,14 @@ class TypeParameterDeserializationCluster
 
   void ReadAlloc(Deserializer* d) override {
     ReadAllocFixedSize(d, TypeParameter::InstanceSize());
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     const bool mark_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
@@ -5568,6 +5811,8 @@ class ClosureDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5744,6 +5989,8 @@ class DoubleDeserializationCluster
     ReadAllocFixedSize(d, Double::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
     const bool mark_canonical = is_root_unit_ && is_canonical();
@@ -5822,6 +6069,8 @@ class Simd128DeserializationCluster
     ReadAllocFixedSize(d, Int32x4::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
     const intptr_t cid = cid_;
@@ -5896,6 +6145,8 @@ class GrowableObjectArrayDeserializationCluster
     ReadAllocFixedSize(d, GrowableObjectArray::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -5984,6 +6235,8 @@ class RecordDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6065,6 +6318,8 @@ class TypedDataDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6448,6 +6703,7 @@ class RegExpSerializationCluster : public SerializationCluster {
       RegExpPtr regexp = objects_[i];
       AutoTraceObject(regexp);
       WriteFromTo(regexp);
+      s->Write<int32_t>(regexp->untag()->num_bracket_expressions());
       s->Write<int32_t>(regexp->untag()->num_one_byte_registers_);
       s->Write<int32_t>(regexp->untag()->num_two_byte_registers_);
       s->Write<uint32_t>(regexp->untag()->flags_);
@@ -6480,6 +6736,7 @@ class RegExpDeserializationCluster : public DeserializationCluster {
       Deserializer::InitializeHeader(regexp, kRegExpCid,
                                      RegExp::InstanceSize());
       d.ReadFromTo(regexp);
+      regexp->untag()->set_num_bracket_expressions(d.Read<int32_t>());
       regexp->untag()->num_one_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->num_two_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->flags_ = d.Read<uint32_t>();
@@ -6629,6 +6886,8 @@ class MapDeserializationCluster
     ReadAllocFixedSize(d, Map::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6709,6 +6968,8 @@ class SetDeserializationCluster
     ReadAllocFixedSize(d, Set::InstanceSize());
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6863,6 +7124,8 @@ class ArrayDeserializationCluster
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -6957,6 +7220,8 @@ class WeakArrayDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
 
@@ -7026,6 +7291,7 @@ class StringSerializationCluster
   }
 
   void WriteFill(Serializer* s) {
+    WriteCanonicalSetGaps(s);
     const intptr_t count = objects_.length();
     for (intptr_t i = 0; i < count; i++) {
       StringPtr str = objects_[i];
@@ -7077,11 +7343,14 @@ class StringDeserializationCluster
       d->AssignRef(d->Allocate(InstanceSize(length, cid)));
     }
     stop_index_ = d->next_index();
-    BuildCanonicalSetFromLayout(d);
+    AllocateCanonicalSet(d);
   }
 
+  bool CanFillInParallel() const override { return true; }
+
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    BuildCanonicalSetFromLayout(&d);
 
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
       StringPtr str = static_cast<StringPtr>(d.Ref(id));
@@ -9086,10 +9355,20 @@ ZoneGrowableArray<Object*>* Serializer::Serialize(SerializationRoots* roots) {
 #endif
 
   for (SerializationCluster* cluster : clusters_) {
+    // Prefix each fill section with its length, so the deserializer can locate
+    // all of them up front and fill independent clusters concurrently.
+    const intptr_t length_position = bytes_written();
+    uint32_t length = 0;
+    WriteBytes(&length, sizeof(length));
     cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
     Write<int32_t>(kSectionMarker);
 #endif
+    const intptr_t end_position = bytes_written();
+    length = end_position - (length_position + sizeof(length));
+    stream_->SetPosition(length_position);
+    WriteBytes(&length, sizeof(length));
+    stream_->SetPosition(end_position);
   }
 
   roots->WriteRoots(this);
@@ -9363,6 +9642,33 @@ Deserializer::~Deserializer() {
   delete[] clusters_;
 }
 
+bool Deserializer::IsLazyCluster(const char* name) const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // Lazy objects are read back from the isolate group's snapshot, so this is
+  // limited to the root unit of that snapshot.
+  if (FLAG_lazy_snapshot_clusters == nullptr || is_non_root_unit_) {
+    return false;
+  }
+  IsolateGroupSource* source = isolate_group()->source();
+  if ((source == nullptr) || (source->snapshot_data != stream_.buffer_)) {
+    return false;
+  }
+  const intptr_t name_length = strlen(name);
+  const char* current = FLAG_lazy_snapshot_clusters;
+  while (*current != '\0') {
+    const char* end = strchr(current, ',');
+    const intptr_t length =
+        (end == nullptr) ? strlen(current) : (end - current);
+    if ((length == name_length) && (strncmp(current, name, length) == 0)) {
+      return true;
+    }
+    if (end == nullptr) break;
+    current = end + 1;
+  }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+  return false;
+}
+
 DeserializationCluster* Deserializer::ReadCluster() {
   const uint32_t tags = Read<uint32_t>();
   const intptr_t cid = UntaggedObject::ClassIdTag::decode(tags);
@@ -9480,7 +9786,8 @@ DeserializationCluster* Deserializer::ReadCluster() {
     case kCodeSourceMapCid:
       ASSERT(!is_canonical);
       ASSERT(!is_deeply_immutable);
-      return new (Z) CodeSourceMapDeserializationCluster();
+      return new (Z) CodeSourceMapDeserializationCluster(
+          IsLazyCluster("CodeSourceMap"));
     case kCompressedStackMapsCid:
       ASSERT(!is_canonical);
       ASSERT(!is_deeply_immutable);
@@ -9927,8 +10234,154 @@ class HeapLocker : public StackResource {
   FreeList* freelist_;
 };
 
+// The fill sections of the clusters handed to helper threads, claimed in
+// order by the helpers and the isolate thread.
+class ParallelFillState : public ValueObject {
+ public:
+  ParallelFillState(Deserializer* deserializer,
+                    const uint8_t* buffer,
+                    intptr_t size,
+                    intptr_t num_sections)
+      : deserializer_(deserializer),
+        buffer_(buffer),
+        size_(size),
+        clusters_(num_sections),
+        positions_(num_sections) {}
+
+  void Add(DeserializationCluster* cluster, intptr_t position) {
+    clusters_.Add(cluster);
+    positions_.Add(position);
+  }
+  intptr_t length() const { return clusters_.length(); }
+
+  // Fills clusters until all of them have been claimed.
+  void FillClusters() {
+    for (intptr_t i = next_.fetch_add(1); i < clusters_.length();
+         i = next_.fetch_add(1)) {
+      ReadStream stream(buffer_, size_, positions_[i]);
+      Deserializer::FillStreamScope scope(&stream);
+      const bool record_load_report = SnapshotLoadReport::IsEnabled();
+      const int64_t start =
+          record_load_report ? OS::GetCurrentMonotonicMicros() : 0;
+      clusters_[i]->ReadFill(deserializer_);
+      if (record_load_report) {
+        clusters_[i]->load_stats()->fill_micros =
+            OS::GetCurrentMonotonicMicros() - start;
+      }
+#if defined(DEBUG)
+      int32_t section_marker = stream.Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+    }
+  }
+
+  void TaskStarted() {
+    MonitorLocker ml(&monitor_);
+    running_tasks_++;
+  }
+  void TaskFinished() {
+    MonitorLocker ml(&monitor_);
+    if (--running_tasks_ == 0) {
+      ml.Notify();
+    }
+  }
+  void WaitForTasks() {
+    MonitorLocker ml(&monitor_);
+    while (running_tasks_ > 0) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  Deserializer* const deserializer_;
+  const uint8_t* const buffer_;
+  const intptr_t size_;
+  GrowableArray<DeserializationCluster*> clusters_;
+  GrowableArray<intptr_t> positions_;
+  RelaxedAtomic<intptr_t> next_ = {0};
+  Monitor monitor_;
+  intptr_t running_tasks_ = 0;
+};
+
+class ParallelFillTask : public ThreadPool::Task {
+ public:
+  explicit ParallelFillTask(ParallelFillState* state) : state_(state) {}
+
+  void Run() override {
+    state_->FillClusters();
+    state_->TaskFinished();
+  }
+
+ private:
+  ParallelFillState* const state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelFillTask);
+};
+
+void Deserializer::ReadFill() {
+  // Clusters that can be filled in parallel go to the helper tasks, provided
+  // their fill section is large enough to be worth the handoff. The remaining
+  // clusters are filled in order on the isolate thread while the helpers run.
+  ParallelFillState parallel(this, stream_.buffer_,
+                             stream_.end_ - stream_.buffer_, num_clusters_);
+  intptr_t* positions = zone_->Alloc<intptr_t>(num_clusters_);
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    uint32_t length;
+    stream_.ReadBytes(&length, sizeof(length));
+    const intptr_t position = stream_.Position();
+    clusters_[i]->PrepareFill(this);
+    clusters_[i]->load_stats()->snapshot_bytes += sizeof(length) + length;
+    if ((FLAG_snapshot_fill_tasks > 0) && clusters_[i]->CanFillInParallel() &&
+        (static_cast<intptr_t>(length) >=
+         FLAG_snapshot_parallel_fill_min_bytes)) {
+      parallel.Add(clusters_[i], position);
+      positions[i] = -1;
+    } else {
+      positions[i] = position;
+    }
+    stream_.SetPosition(position + length);
+  }
+  const intptr_t end_position = stream_.Position();
+
+  const intptr_t num_tasks =
+      Utils::Minimum<intptr_t>(FLAG_snapshot_fill_tasks, parallel.length());
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    parallel.TaskStarted();
+    if (!Dart::thread_pool()->Run<ParallelFillTask>(&parallel)) {
+      parallel.TaskFinished();
+      break;
+    }
+  }
+
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (positions[i] < 0) continue;
+    stream_.SetPosition(positions[i]);
+    const bool record_load_report = SnapshotLoadReport::IsEnabled();
+    const int64_t start =
+        record_load_report ? OS::GetCurrentMonotonicMicros() : 0;
+    clusters_[i]->ReadFill(this);
+    if (record_load_report) {
+      clusters_[i]->load_stats()->fill_micros =
+          OS::GetCurrentMonotonicMicros() - start;
+    }
+#if defined(DEBUG)
+    int32_t section_marker = Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+  }
+
+  // Help with (or do all of) the remaining parallel clusters.
+  parallel.FillClusters();
+  parallel.WaitForTasks();
+
+  stream_.SetPosition(end_position);
+}
+
 void Deserializer::Deserialize(DeserializationRoots* roots) {
   const void* clustered_start = AddressOfCurrentPosition();
+  const bool record_load_report = SnapshotLoadReport::IsEnabled();
+  const int64_t start_micros =
+      record_load_report ? OS::GetCurrentMonotonicMicros() : 0;
 
   Array& refs = Array::Handle(zone_);
   num_base_objects_ = ReadUnsigned();
@@ -9991,8 +10444,24 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
       for (intptr_t i = 0; i < num_clusters_; i++) {
-        clusters_[i] = ReadCluster();
-        clusters_[i]->ReadAlloc(this);
+        if (record_load_report) {
+          const intptr_t position = stream_.Position();
+          // Peek at the tags ReadCluster reads to record the cluster's class.
+          const uint32_t tags = Read<uint32_t>();
+          stream_.SetPosition(position);
+          const intptr_t heap_bytes = allocated_bytes_;
+          const int64_t start = OS::GetCurrentMonotonicMicros();
+          clusters_[i] = ReadCluster();
+          clusters_[i]->ReadAlloc(this);
+          auto const stats = clusters_[i]->load_stats();
+          stats->cid = UntaggedObject::ClassIdTag::decode(tags);
+          stats->alloc_micros = OS::GetCurrentMonotonicMicros() - start;
+          stats->heap_bytes = allocated_bytes_ - heap_bytes;
+          stats->snapshot_bytes = stream_.Position() - position;
+        } else {
+          clusters_[i] = ReadCluster();
+          clusters_[i]->ReadAlloc(this);
+        }
 #if defined(DEBUG)
         intptr_t serializers_next_ref_index_ = Read<int32_t>();
         ASSERT_EQUAL(serializers_next_ref_index_, next_ref_index_);
@@ -10005,13 +10474,7 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
 
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadFill");
-      for (intptr_t i = 0; i < num_clusters_; i++) {
-        clusters_[i]->ReadFill(this);
-#if defined(DEBUG)
-        int32_t section_marker = Read<int32_t>();
-        ASSERT(section_marker == kSectionMarker);
-#endif
-      }
+      ReadFill();
     }
 
     roots->ReadRoots(this);
@@ -10035,10 +10498,20 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
   {
     TIMELINE_DURATION(thread(), Isolate, "PostLoad");
     for (intptr_t i = 0; i < num_clusters_; i++) {
+      const int64_t start =
+          record_load_report ? OS::GetCurrentMonotonicMicros() : 0;
       clusters_[i]->PostLoad(this, refs);
+      if (record_load_report) {
+        clusters_[i]->load_stats()->post_load_micros =
+            OS::GetCurrentMonotonicMicros() - start;
+      }
     }
   }
 
+  if (record_load_report) {
+    AddToLoadReport(OS::GetCurrentMonotonicMicros() - start_micros);
+  }
+
   if (isolate_group->snapshot_is_dontneed_safe()) {
     size_t clustered_length =
         reinterpret_cast<uword>(AddressOfCurrentPosition()) -
@@ -10048,6 +10521,186 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
   }
 }
 
+void Deserializer::AddToLoadReport(int64_t total_micros) {
+  auto isolate_group = thread()->isolate_group();
+  auto class_table = isolate_group->class_table();
+  const char* isolate_group_name =
+      (isolate_group->source() != nullptr) ? isolate_group->source()->name
+                                           : nullptr;
+  DeserializationCluster::LoadStats totals;
+  intptr_t total_objects = 0;
+
+  JSONWriter writer;
+  writer.OpenObject();
+  writer.PrintProperty("isolateGroup", isolate_group_name != nullptr
+                                           ? isolate_group_name
+                                           : "vm-isolate");
+  writer.PrintProperty("loadingUnit", loading_unit_id_);
+  writer.PrintProperty("kind", Snapshot::KindToCString(kind()));
+  writer.OpenArray("clusters");
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    DeserializationCluster* cluster = clusters_[i];
+    const auto stats = cluster->load_stats();
+    writer.OpenObject();
+    writer.PrintProperty("name", cluster->name());
+    if (stats->cid >= kNumPredefinedCids && class_table->HasValidClassAt(
+                                                 stats->cid)) {
+      const auto& cls =
+          Class::Handle(zone_, class_table->At(stats->cid));
+      writer.PrintProperty("class", cls.ScrubbedNameCString());
+    }
+    writer.PrintPropertyBool("canonical", cluster->is_canonical());
+    writer.PrintProperty("objects", cluster->num_objects());
+    writer.PrintProperty("snapshotBytes", stats->snapshot_bytes);
+    writer.PrintProperty("heapBytes", stats->heap_bytes);
+    writer.PrintProperty64("allocMicros", stats->alloc_micros);
+    writer.PrintProperty64("fillMicros", stats->fill_micros);
+    writer.PrintProperty64("postLoadMicros", stats->post_load_micros);
+    writer.CloseObject();
+
+    total_objects += cluster->num_objects();
+    totals.snapshot_bytes += stats->snapshot_bytes;
+    totals.heap_bytes += stats->heap_bytes;
+    totals.alloc_micros += stats->alloc_micros;
+    totals.fill_micros += stats->fill_micros;
+    totals.post_load_micros += stats->post_load_micros;
+  }
+  writer.CloseArray();
+  // Fill times of clusters filled on helper threads overlap, so the sum of the
+  // per-cluster times may exceed the time the load took.
+  writer.OpenObject("totals");
+  writer.PrintProperty("objects", total_objects);
+  writer.PrintProperty("snapshotBytes", totals.snapshot_bytes);
+  writer.PrintProperty("heapBytes", totals.heap_bytes);
+  writer.PrintProperty64("allocMicros", totals.alloc_micros);
+  writer.PrintProperty64("fillMicros", totals.fill_micros);
+  writer.PrintProperty64("postLoadMicros", totals.post_load_micros);
+  writer.PrintProperty64("loadMicros", total_micros);
+  writer.CloseObject();
+  writer.CloseObject();
+
+  char* json = nullptr;
+  intptr_t length = 0;
+  writer.Steal(&json, &length);
+  SnapshotLoadReport::AddLoad(json);
+}
+
+static Mutex* load_report_mutex = new Mutex();
+static MallocGrowableArray<char*>* load_report_loads = nullptr;
+
+bool SnapshotLoadReport::IsEnabled() {
+  return FLAG_record_snapshot_load_report ||
+         (FLAG_write_snapshot_load_report_to != nullptr);
+}
+
+void SnapshotLoadReport::AddLoad(char* json) {
+  MutexLocker ml(load_report_mutex);
+  if (load_report_loads == nullptr) {
+    load_report_loads = new MallocGrowableArray<char*>();
+  }
+  load_report_loads->Add(json);
+}
+
+char* SnapshotLoadReport::ToJSON() {
+  if (!IsEnabled()) return nullptr;
+  TextBuffer buffer(1024);
+  buffer.AddString("{\"type\":\"SnapshotLoadReport\",\"loads\":[");
+  {
+    MutexLocker ml(load_report_mutex);
+    const intptr_t length =
+        (load_report_loads != nullptr) ? load_report_loads->length() : 0;
+    for (intptr_t i = 0; i < length; i++) {
+      if (i > 0) buffer.AddChar(',');
+      buffer.AddString(load_report_loads->At(i));
+    }
+  }
+  buffer.AddString("]}");
+  return buffer.Steal();
+}
+
+void SnapshotLoadReport::WriteToFile() {
+  if (FLAG_write_snapshot_load_report_to == nullptr) return;
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+  void* file = file_open(FLAG_write_snapshot_load_report_to, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write snapshot load report: %s\n",
+                 FLAG_write_snapshot_load_report_to);
+    return;
+  }
+  char* json = ToJSON();
+  file_write(json, strlen(json), file);
+  file_close(file);
+  free(json);
+}
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+static RelaxedAtomic<intptr_t> lazy_objects_deferred = {0};
+static RelaxedAtomic<intptr_t> lazy_bytes_deferred = {0};
+static RelaxedAtomic<intptr_t> lazy_objects_materialized = {0};
+static RelaxedAtomic<intptr_t> lazy_bytes_materialized = {0};
+
+void LazySnapshotObjects::RecordDeferred(intptr_t count, intptr_t size) {
+  lazy_objects_deferred.fetch_add(count);
+  lazy_bytes_deferred.fetch_add(size);
+}
+
+// Serializes materialization, which allocates, between the mutator and
+// helper threads such as the profiler.
+static Mutex* lazy_objects_mutex = new Mutex();
+
+CodeSourceMapPtr LazySnapshotObjects::MaterializeCodeSourceMap(
+    const Code& code) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  auto isolate_group = thread->isolate_group();
+  SafepointMutexLocker ml(thread, lazy_objects_mutex);
+  ObjectPtr lazy = code.ptr()->untag()->code_source_map();
+  if (!lazy->IsSmi()) {
+    // Materialized by another thread while this one waited for the lock.
+    return CodeSourceMap::RawCast(lazy);
+  }
+  const intptr_t index = Smi::Value(Smi::RawCast(lazy));
+  const auto& maps = Array::Handle(
+      zone, isolate_group->object_store()->lazy_code_source_maps());
+  auto& map = CodeSourceMap::Handle(zone);
+  lazy = maps.At(index);
+  if (lazy->IsSmi()) {
+    const Snapshot* snapshot =
+        Snapshot::SetupFromBuffer(isolate_group->source()->snapshot_data);
+    ReadStream stream(snapshot->Addr(), snapshot->length(),
+                      Smi::Value(Smi::RawCast(lazy)));
+    const intptr_t length = stream.ReadUnsigned();
+    map = CodeSourceMap::New(length);
+    {
+      NoSafepointScope no_safepoint;
+      stream.ReadBytes(map.Data(), length);
+    }
+    maps.SetAt(index, map);
+    lazy_objects_materialized.fetch_add(1);
+    lazy_bytes_materialized.fetch_add(CodeSourceMap::InstanceSize(length));
+  } else {
+    // Shared with a Code object that materialized it first.
+    map ^= lazy;
+  }
+  code.set_code_source_map(map);
+  return map.ptr();
+}
+
+void LazySnapshotObjects::PrintStatistics() {
+  OS::PrintErr("Lazy snapshot objects: %" Pd " of %" Pd
+               " materialized (%" Pd " of %" Pd " bytes)\n",
+               lazy_objects_materialized.load(), lazy_objects_deferred.load(),
+               lazy_bytes_materialized.load(), lazy_bytes_deferred.load());
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 FullSnapshotWriter::FullSnapshotWriter(Snapshot::Kind kind,
                                        NonStreamingWriteStream* snapshot_data,
@@ -10340,6 +10993,7 @@ char* FullSnapshotReader::ReadUnitSnapshot(const LoadingUnit& unit) {
   }
 
   UnitDeserializationRoots roots(unit);
+  deserializer.set_loading_unit_id(unit.id());
   deserializer.Deserialize(&roots);
 
   InitializeBSS();
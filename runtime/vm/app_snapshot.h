@@ -147,6 +147,42 @@ class FullSnapshotWriter {
   DISALLOW_COPY_AND_ASSIGN(FullSnapshotWriter);
 };
 
+// Per-cluster statistics of the snapshots read since VM start, recorded with
+// --record_snapshot_load_report. Every load of a program or loading unit
+// snapshot contributes the number of objects, snapshot and heap bytes and the
+// time spent in ReadAlloc, ReadFill and PostLoad of each of its clusters.
+class SnapshotLoadReport : public AllStatic {
+ public:
+  static bool IsEnabled();
+
+  // Takes ownership of [json], the malloced report of a single load.
+  static void AddLoad(char* json);
+
+  // Returns the report of all loads as a malloced JSON string, or nullptr if
+  // loads are not being recorded.
+  static char* ToJSON();
+
+  // Writes the report to the file given with --write_snapshot_load_report_to.
+  static void WriteToFile();
+};
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+// Objects of the clusters selected by --lazy_snapshot_clusters are left in
+// the isolate snapshot when it is read. References to such an object hold a
+// Smi index into a table of the object store instead, which holds the
+// position of the object's fill data in the snapshot until the object is
+// materialized in the heap on first access.
+class LazySnapshotObjects : public AllStatic {
+ public:
+  static void RecordDeferred(intptr_t count, intptr_t size);
+
+  // Allocates, so the current thread must be able to reach a safepoint.
+  static CodeSourceMapPtr MaterializeCodeSourceMap(const Code& code);
+
+  static void PrintStatistics();
+};
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 class FullSnapshotReader {
  public:
   FullSnapshotReader(const Snapshot* snapshot,
@@ -22,6 +22,7 @@
 #include "vm/datastream.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/timeline.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -531,6 +532,27 @@ BENCHMARK(SimpleMessage) {
   benchmark->set_score(elapsed_time);
 }
 
+#if defined(SUPPORT_TIMELINE)
+// Nanoseconds to record one duration event into the thread's timeline block.
+BENCHMARK(TimelineDurationEvent) {
+  TimelineStream stream("Benchmark", "dart:benchmark", /*static_labels=*/true,
+                        /*enabled=*/true);
+  const intptr_t kNumEvents = 1000000;
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kNumEvents; i++) {
+    TimelineEvent* event = stream.StartEvent();
+    if (event != nullptr) {
+      event->Duration("Event", i, i + 1);
+      event->Complete();
+    }
+  }
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime() * kNanosecondsPerMicrosecond /
+                       kNumEvents);
+}
+#endif  // defined(SUPPORT_TIMELINE)
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
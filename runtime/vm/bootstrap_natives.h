@@ -113,6 +113,7 @@ namespace dart {
   V(RegExp_getGroupNameMap, 1)                                                 \
   V(RegExp_ExecuteMatch, 3)                                                    \
   V(RegExp_ExecuteMatchSticky, 3)                                              \
+  V(RegExp_ExecuteMatchGlobal, 4)                                              \
   V(List_allocate, 1)                                                          \
   V(List_setIndexed, 3)                                                        \
   V(List_getLength, 1)                                                         \
@@ -26,6 +26,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
+#include "vm/regexp/regexp.h"
 #include "vm/resolver.h"
 #include "vm/scopes.h"
 #include "vm/stack_frame.h"
@@ -986,9 +987,57 @@ void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
   if (TryInlineFieldAccess(instr)) {
     return;
   }
+  TryPrecompileRegExp(instr);
   CallSpecializer::VisitStaticCall(instr);
 }
 
+void AotCallSpecializer::TryPrecompileRegExp(StaticCallInstr* call) {
+  if (precompiler_ == nullptr) return;
+  const Function& target = call->function();
+  if (!target.IsFactory()) return;
+  const Class& owner = Class::Handle(Z, target.Owner());
+  if (owner.library() != Library::CoreLibrary()) return;
+  const String& class_name = String::Handle(Z, owner.Name());
+  if (!class_name.Equals("RegExp") && !class_name.Equals("_RegExp")) return;
+
+  // RegExp(source, {multiLine, caseSensitive, unicode, dotAll}). Factories
+  // take their type arguments as the first argument.
+  const Array& names = call->argument_names();
+  const intptr_t named_count = names.IsNull() ? 0 : names.Length();
+  const intptr_t first_named = call->ArgumentCount() - named_count;
+  const intptr_t source_index = call->FirstArgIndex() + 1;
+  if (source_index + 1 != first_named) return;
+  Value* source = call->ArgumentValueAt(source_index);
+  if (!source->BindsToConstant() || !source->BoundConstant().IsString()) {
+    return;
+  }
+  bool multi_line = false;
+  bool case_sensitive = true;
+  bool unicode = false;
+  bool dot_all = false;
+  String& name = String::Handle(Z);
+  for (intptr_t i = 0; i < named_count; i++) {
+    Value* arg = call->ArgumentValueAt(first_named + i);
+    if (!arg->BindsToConstant() || !arg->BoundConstant().IsBool()) return;
+    const bool value = Bool::Cast(arg->BoundConstant()).value();
+    name ^= names.At(i);
+    if (name.Equals("multiLine")) {
+      multi_line = value;
+    } else if (name.Equals("caseSensitive")) {
+      case_sensitive = value;
+    } else if (name.Equals("unicode")) {
+      unicode = value;
+    } else if (name.Equals("dotAll")) {
+      dot_all = value;
+    } else {
+      return;
+    }
+  }
+  precompiler_->AddRegExp(
+      String::Cast(source->BoundConstant()),
+      RegExpStatics::FlagsFor(multi_line, case_sensitive, unicode, dot_all));
+}
+
 bool AotCallSpecializer::TryExpandCallThroughGetter(const Class& receiver_class,
                                                     InstanceCallInstr* call) {
   // If it's an accessor call it can't be a call through getter.
@@ -41,6 +41,10 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryInlineFieldAccess(InstanceCallInstr* call);
   bool TryInlineFieldAccess(StaticCallInstr* call);
 
+  // If the call creates a RegExp from constant arguments, adds the RegExp to
+  // the precompiled ones.
+  void TryPrecompileRegExp(StaticCallInstr* call);
+
   bool IsSupportedIntOperandForStaticDoubleOp(CompileType* operand_type);
   Value* PrepareStaticOpInput(Value* input, intptr_t cid, Instruction* call);
 
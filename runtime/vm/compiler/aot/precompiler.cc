@@ -47,6 +47,8 @@
 #include "vm/os.h"
 #include "vm/parser.h"
 #include "vm/program_visitor.h"
+#include "vm/regexp/regexp-parser.h"
+#include "vm/regexp/regexp.h"
 #include "vm/resolver.h"
 #include "vm/runtime_entry.h"
 #include "vm/stack_trace.h"
@@ -74,6 +76,11 @@ DEFINE_FLAG(charp,
             nullptr,
             "Print layout of Dart objects to the given file");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(bool,
+            precompile_regexps,
+            true,
+            "Compile RegExps created with constant arguments into the "
+            "snapshot.");
 DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
@@ -402,6 +409,8 @@ Precompiler::Precompiler(Thread* thread)
           thread->isolate_group()->object_store()->libraries())),
       pending_functions_(
           GrowableObjectArray::Handle(GrowableObjectArray::New())),
+      precompiled_regexps_(
+          GrowableObjectArray::Handle(GrowableObjectArray::New())),
       sent_selectors_(),
       functions_called_dynamically_(
           HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
@@ -547,6 +556,9 @@ void Precompiler::DoCompileAll() {
       // fixed point.
       Iterate();
 
+      IG->object_store()->set_precompiled_regexps(
+          Array::Handle(Z, Array::MakeFixedLength(precompiled_regexps_)));
+
       // Replace the default type testing stubs installed on [Type]s with new
       // [Type]-specialized stubs.
       AttachOptimizedTypeTestingStub();
@@ -1192,6 +1204,33 @@ void Precompiler::AddTypeArguments(const TypeArguments& args) {
   }
 }
 
+void Precompiler::AddRegExp(const String& pattern, RegExpFlags flags) {
+  if (!FLAG_precompile_regexps) return;
+  RegExpCompileData compile_data;
+  if (!RegExpParser::ParseRegExpFromHeapString(T->isolate(), Z, pattern, flags,
+                                               &compile_data)) {
+    // The constructor throws the syntax error at runtime.
+    return;
+  }
+  const auto& regexp =
+      RegExp::Handle(Z, RegExpStatics::Canonicalize(T, pattern, flags));
+  auto& other = RegExp::Handle(Z);
+  for (intptr_t i = 0; i < precompiled_regexps_.Length(); i++) {
+    other ^= precompiled_regexps_.At(i);
+    if (other.ptr() == regexp.ptr()) return;
+  }
+  if (!RegExpStatics::CompileAheadOfTime(T, regexp)) {
+    if (FLAG_trace_precompiler) {
+      THR_Print("Cannot precompile RegExp /%s/\n", pattern.ToCString());
+    }
+    return;
+  }
+  if (FLAG_trace_precompiler) {
+    THR_Print("Precompiled RegExp /%s/\n", pattern.ToCString());
+  }
+  precompiled_regexps_.Add(regexp);
+}
+
 void Precompiler::AddConstObject(const class Instance& instance) {
   // Types, type parameters, and type arguments require special handling.
   if (instance.IsAbstractType()) {  // Includes type parameter.
@@ -264,6 +264,9 @@ class Precompiler : public ValueObject {
 
   void AddField(const Field& field);
   void AddTableSelector(const compiler::TableSelector* selector);
+  // Compiles the RegExp created by a constructor call with constant
+  // arguments into the snapshot, so that it is not compiled at runtime.
+  void AddRegExp(const String& pattern, RegExpFlags flags);
 
   enum class Phase {
     kPreparation,
@@ -388,6 +391,7 @@ class Precompiler : public ValueObject {
   compiler::ObjectPoolBuilder global_object_pool_builder_;
   GrowableObjectArray& libraries_;
   const GrowableObjectArray& pending_functions_;
+  const GrowableObjectArray& precompiled_regexps_;
   SymbolSet sent_selectors_;
   FunctionSet functions_called_dynamically_;
   FunctionSet functions_with_entry_point_pragmas_;
@@ -1525,6 +1525,27 @@ void GenerateSubstringMatchesSpecialization(Assembler* assembler,
   // i = 0
   __ LoadImmediate(R3, 0);
 
+  if (receiver_cid == kOneByteStringCid && other_cid == kOneByteStringCid) {
+    // Compare 16 bytes at a time while at least 16 bytes remain.
+    Label vector_loop, scalar;
+    __ Bind(&vector_loop);
+    __ sub(R8, R9, Operand(R3));
+    __ cmp(R8, Operand(16));
+    __ b(&scalar, LT);
+    __ ldp(R6, R7, Address(R0, 16, Address::PairPostIndex));
+    __ ldp(R10, R11, Address(R2, 16, Address::PairPostIndex));
+    __ eor(R6, R6, Operand(R10));
+    __ eor(R7, R7, Operand(R11));
+    __ orr(R6, R6, Operand(R7));
+    __ cbnz(return_false, R6);
+    __ add(R3, R3, Operand(16));
+    __ b(&vector_loop);
+
+    __ Bind(&scalar);
+    __ cmp(R3, Operand(R9));
+    __ b(return_true, GE);
+  }
+
   // do
   Label loop;
   __ Bind(&loop);
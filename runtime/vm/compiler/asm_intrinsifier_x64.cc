@@ -1405,6 +1405,30 @@ void GenerateSubstringMatchesSpecialization(Assembler* assembler,
 
   __ LoadImmediate(R11, Immediate(0));  // i = 0
 
+  if (receiver_cid == kOneByteStringCid && other_cid == kOneByteStringCid) {
+    // Compare 16 bytes at a time while at least 16 bytes remain.
+    Label vector_loop, scalar;
+    __ leaq(R8, Address(RAX, RBX, TIMES_1, 0));  // this + start
+    __ leaq(R12, Address(R9, -16));
+    __ Bind(&vector_loop);
+    __ cmpq(R11, R12);
+    __ j(GREATER, &scalar, Assembler::kNearJump);
+    __ movups(XMM0, FieldAddress(R8, R11, TIMES_1,
+                                 target::OneByteString::data_offset()));
+    __ movups(XMM1, FieldAddress(RCX, R11, TIMES_1,
+                                 target::OneByteString::data_offset()));
+    __ pcmpeqb(XMM0, XMM1);
+    __ pmovmskb(R13, XMM0);
+    __ cmpl(R13, Immediate(0xFFFF));
+    __ j(NOT_EQUAL, return_false);
+    __ addq(R11, Immediate(16));
+    __ jmp(&vector_loop, Assembler::kNearJump);
+
+    __ Bind(&scalar);
+    __ cmpq(R11, R9);
+    __ j(GREATER_EQUAL, return_true);
+  }
+
   // do
   Label loop;
   __ Bind(&loop);
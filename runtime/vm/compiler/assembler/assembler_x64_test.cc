@@ -5332,6 +5332,30 @@ ASSEMBLER_TEST_RUN(Pcmpeqd, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(Pcmpeqb, assembler) {
+  // Lanes 0 and 1 differ, all other byte lanes are equal.
+  __ movq(RAX, Immediate(0x1122));
+  __ movq(XMM0, RAX);
+  __ xorps(XMM1, XMM1);
+  __ pcmpeqb(XMM0, XMM1);
+  // Collect the sixteen byte lane sign bits.
+  __ pmovmskb(RAX, XMM0);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(Pcmpeqb, test) {
+  typedef intptr_t (*PcmpeqbCode)();
+  intptr_t res = reinterpret_cast<PcmpeqbCode>(test->entry())();
+  EXPECT_EQ(0xFFFC, res);
+  EXPECT_DISASSEMBLY(
+      "movl rax,0x1122\n"
+      "movq xmm0,rax\n"
+      "xorps xmm1,xmm1\n"
+      "pcmpeqb xmm0,xmm1\n"
+      "pmovmskb rax,xmm0\n"
+      "ret\n");
+}
+
 ASSEMBLER_TEST_GENERATE(Ptest, assembler) {
   // Zero vector: ptest sets ZF=1, so setcc(EQUAL) yields 1.
   __ xorps(XMM0, XMM0);
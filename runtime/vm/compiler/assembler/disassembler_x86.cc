@@ -1382,6 +1382,8 @@ int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
           mnemonic = "psubd";
         } else if (opcode == 0xEF) {
           mnemonic = "pxor";
+        } else if (opcode == 0x74) {
+          mnemonic = "pcmpeqb";
         } else if (opcode == 0x76) {
           mnemonic = "pcmpeqd";
         } else {
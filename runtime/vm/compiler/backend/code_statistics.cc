@@ -12,6 +12,10 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
   object_header_bytes_ = 0;
   return_const_count_ = 0;
   return_const_with_load_field_count_ = 0;
+  spill_count_ = 0;
+  reload_count_ = 0;
+  spill_in_loop_count_ = 0;
+  reload_in_loop_count_ = 0;
   intptr_t i = 0;
 
 #define DO(type, attrs)                                                        \
@@ -105,6 +109,11 @@ void CombinedCodeStatistics::DumpStatistics() {
   OS::PrintErr("% 8" Pd " return-constant-with-load-field functions\n",
                return_const_with_load_field_count_);
   OS::PrintErr("--------------------\n");
+  OS::PrintErr("% 8" Pd " spills (%" Pd " inside loops)\n", spill_count_,
+               spill_in_loop_count_);
+  OS::PrintErr("% 8" Pd " reloads (%" Pd " inside loops)\n", reload_count_,
+               reload_in_loop_count_);
+  OS::PrintErr("--------------------\n");
 }
 
 int CombinedCodeStatistics::CompareEntries(const void* a, const void* b) {
@@ -129,12 +138,38 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
   stack_index_ = -1;
   for (intptr_t i = 0; i < kStackSize; i++)
     stack_[i] = -1;
+
+  spill_count_ = 0;
+  reload_count_ = 0;
+  spill_in_loop_count_ = 0;
+  reload_in_loop_count_ = 0;
 }
 
 void CodeStatistics::Begin(Instruction* instruction) {
+  if (auto* const move = instruction->AsParallelMove()) {
+    CountSpillsAndReloads(move);
+  }
   SpecialBegin(static_cast<intptr_t>(instruction->statistics_tag()));
 }
 
+void CodeStatistics::CountSpillsAndReloads(ParallelMoveInstr* move) {
+  BlockEntryInstr* block = move->GetBlock();
+  const bool in_loop = (block != nullptr) && (block->loop_info() != nullptr);
+  for (intptr_t i = 0; i < move->NumMoves(); i++) {
+    MoveOperands* operands = move->MoveOperandsAt(i);
+    if (operands->IsRedundant()) continue;
+    if (operands->src().IsMachineRegister() &&
+        operands->dest().HasStackIndex()) {
+      spill_count_++;
+      if (in_loop) spill_in_loop_count_++;
+    } else if (operands->src().HasStackIndex() &&
+               operands->dest().IsMachineRegister()) {
+      reload_count_++;
+      if (in_loop) reload_in_loop_count_++;
+    }
+  }
+}
+
 void CodeStatistics::End(Instruction* instruction) {
   SpecialEnd(static_cast<intptr_t>(instruction->statistics_tag()));
 }
@@ -201,6 +236,11 @@ void CodeStatistics::AppendTo(CombinedCodeStatistics* stat) {
   stat->alignment_bytes_ += alignment_bytes_;
   stat->object_header_bytes_ += Instructions::HeaderSize();
 
+  stat->spill_count_ += spill_count_;
+  stat->reload_count_ += reload_count_;
+  stat->spill_in_loop_count_ += spill_in_loop_count_;
+  stat->reload_in_loop_count_ += reload_in_loop_count_;
+
   if (returns_constant) stat->return_const_count_++;
   if (returns_const_with_load_field_) {
     stat->return_const_with_load_field_count_++;
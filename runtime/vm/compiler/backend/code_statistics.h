@@ -68,6 +68,10 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t spill_count_;
+  intptr_t reload_count_;
+  intptr_t spill_in_loop_count_;
+  intptr_t reload_in_loop_count_;
 };
 
 class CodeStatistics {
@@ -87,6 +91,10 @@ class CodeStatistics {
  private:
   static constexpr int kStackSize = 8;
 
+  // Count register allocator spills (register to stack slot moves) and
+  // reloads (stack slot to register moves) in the given parallel move.
+  void CountSpillsAndReloads(ParallelMoveInstr* move);
+
   compiler::Assembler* assembler_;
 
   typedef struct {
@@ -101,6 +109,11 @@ class CodeStatistics {
 
   intptr_t stack_[kStackSize];
   intptr_t stack_index_;
+
+  intptr_t spill_count_;
+  intptr_t reload_count_;
+  intptr_t spill_in_loop_count_;
+  intptr_t reload_in_loop_count_;
 };
 
 }  // namespace dart
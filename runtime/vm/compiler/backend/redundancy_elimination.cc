@@ -23,6 +23,15 @@ DEFINE_FLAG(bool,
             optimize_lazy_initializer_calls,
             true,
             "Eliminate redundant lazy initializer calls.");
+DEFINE_FLAG(bool,
+            reuse_loop_allocations,
+            false,
+            "Reuse non-escaping allocations across loop iterations.");
+DEFINE_FLAG(bool,
+            partial_escape_analysis,
+            true,
+            "Sink allocations which escape only on some paths into these "
+            "paths.");
 DEFINE_FLAG(bool,
             trace_load_optimization,
             false,
@@ -1828,6 +1837,158 @@ bool DelayAllocations::IsOneTimeUse(BlockEntryInstr* use_block,
   return true;
 }
 
+// Returns true if the given use of an allocation is a load from or a store
+// into the allocated object. Such uses can't make the object escape.
+static bool IsAccessToAllocation(Value* use) {
+  Instruction* const instr = use->instruction();
+  if (instr->IsStoreField()) {
+    return use->use_index() == StoreFieldInstr::kInstancePos;
+  } else if (instr->IsStoreIndexed()) {
+    return use->use_index() == StoreIndexedInstr::kArrayPos;
+  } else if (instr->IsLoadField()) {
+    return true;
+  } else if (instr->IsLoadIndexed()) {
+    return use->use_index() == LoadIndexedInstr::kArrayPos;
+  }
+  return false;
+}
+
+bool ReuseLoopAllocations::IsReusable(Definition* alloc,
+                                      BlockEntryInstr* pre_header) {
+  const intptr_t kMaxReusedArrayLength = 16;
+
+  if (alloc->IsCreateArray()) {
+    auto* const array_alloc = alloc->AsCreateArray();
+    if (!array_alloc->HasConstantNumElements() ||
+        array_alloc->GetConstantNumElements() > kMaxReusedArrayLength) {
+      return false;
+    }
+  } else if (!alloc->IsAllocateContext() && !alloc->IsAllocateRecord()) {
+    return false;
+  }
+
+  if (alloc->env() != nullptr || alloc->GetBlock()->InsideTryBlock()) {
+    return false;
+  }
+
+  // Inputs of the allocation should be available before the loop.
+  for (intptr_t i = 0; i < alloc->InputCount(); i++) {
+    if (!alloc->InputAt(i)->definition()->GetBlock()->Dominates(pre_header)) {
+      return false;
+    }
+  }
+
+  // Identity of the object can't be observed and object can't outlive the
+  // iteration unless it is only accessed directly. Uses which are neither
+  // loads nor stores (including phis joining objects from different
+  // iterations) make it escape.
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    if (!IsAccessToAllocation(use)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ReuseLoopAllocations::ResetStoredSlots(FlowGraph* graph,
+                                            Definition* alloc,
+                                            Instruction* reset_point) {
+  Zone* zone = graph->zone();
+  // Record fields are always initialized right after the allocation.
+  if (alloc->IsAllocateRecord()) return;
+
+  Definition* const null = graph->constant_null();
+  GrowableArray<const Slot*> slots;
+  bool reset_all_elements = false;
+  GrowableArray<intptr_t> indices;
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    if (auto* const store = use->instruction()->AsStoreField()) {
+      if (!slots.Contains(&store->slot())) {
+        slots.Add(&store->slot());
+      }
+    } else if (auto* const store = use->instruction()->AsStoreIndexed()) {
+      if (store->index()->BindsToSmiConstant()) {
+        const intptr_t index = store->index()->BoundSmiConstant();
+        if (!indices.Contains(index)) {
+          indices.Add(index);
+        }
+      } else {
+        reset_all_elements = true;
+      }
+    }
+  }
+
+  for (auto* const slot : slots) {
+    auto* const store = new (zone) StoreFieldInstr(
+        *slot, new (zone) Value(alloc), new (zone) Value(null),
+        kNoStoreBarrier, alloc->source());
+    graph->InsertBefore(reset_point, store, nullptr, FlowGraph::kEffect);
+  }
+
+  if (reset_all_elements) {
+    indices.Clear();
+    for (intptr_t i = 0, n = alloc->AsCreateArray()->GetConstantNumElements();
+         i < n; i++) {
+      indices.Add(i);
+    }
+  }
+  for (intptr_t index : indices) {
+    auto* const store = new (zone) StoreIndexedInstr(
+        new (zone) Value(alloc),
+        new (zone) Value(
+            graph->GetConstant(Smi::ZoneHandle(zone, Smi::New(index)))),
+        new (zone) Value(null), kNoStoreBarrier, /*index_unboxed=*/false,
+        compiler::target::Instance::ElementSizeFor(kArrayCid), kArrayCid,
+        kAlignedAccess, DeoptId::kNone, alloc->source());
+    graph->InsertBefore(reset_point, store, nullptr, FlowGraph::kEffect);
+  }
+}
+
+void ReuseLoopAllocations::Optimize(FlowGraph* graph) {
+  if (!FLAG_reuse_loop_allocations) return;
+
+  const LoopHierarchy& loop_hierarchy = graph->GetLoopHierarchy();
+  if (loop_hierarchy.num_loops() == 0) return;
+
+  // Allocations which do not escape and do not survive a loop iteration are
+  // hoisted into the loop pre-header and the same object is reused by every
+  // iteration. Fields and elements written by the loop are reset to their
+  // initial values at the place of the original allocation.
+  GrowableArray<Definition*> reused;
+  for (BlockIterator block_it = graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    LoopInfo* loop = block->loop_info();
+    if (loop == nullptr) continue;
+
+    BlockEntryInstr* pre_header = loop->header()->ImmediateDominator();
+    if (pre_header == nullptr || !pre_header->last_instruction()->IsGoto()) {
+      continue;
+    }
+
+    for (ForwardInstructionIterator instr_it(block); !instr_it.Done();
+         instr_it.Advance()) {
+      Definition* def = instr_it.Current()->AsDefinition();
+      if (def != nullptr && def->IsAllocation() &&
+          IsReusable(def, pre_header)) {
+        ResetStoredSlots(graph, def, def->next());
+        instr_it.RemoveCurrentFromGraph();
+        def->InsertBefore(pre_header->last_instruction());
+        reused.Add(def);
+      }
+    }
+  }
+
+  if (FLAG_trace_optimization && graph->should_print()) {
+    for (auto* const def : reused) {
+      THR_Print("Reusing allocation v%" Pd " in B%" Pd "\n",
+                def->ssa_temp_index(), def->GetBlock()->block_id());
+    }
+  }
+}
+
 class LoadOptimizer : public ValueObject {
  public:
   LoadOptimizer(FlowGraph* graph, AliasedSet* aliased_set)
@@ -3449,6 +3610,14 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
     return true;
   }
 
+  // Escapes of partially escaping allocations get their own copy of the
+  // object, see MaterializeAtEscapes.
+  if (auto* const partial_escape = PartialEscapeFor(use->definition())) {
+    if (partial_escape->escapes.Contains(use->instruction())) {
+      return true;
+    }
+  }
+
   if (auto* const alloc = use->instruction()->AsAllocation()) {
     return IsSupportedAllocation(alloc) &&
            ((check_type == kOptimisticCheck) ||
@@ -3616,7 +3785,8 @@ void AllocationSinking::CollectCandidates() {
       }
 
       Definition* alloc = current->Cast<Definition>();
-      if (IsAllocationSinkingCandidate(alloc, kOptimisticCheck)) {
+      if (IsAllocationSinkingCandidate(alloc, kOptimisticCheck) ||
+          (FLAG_partial_escape_analysis && CollectPartialEscapes(alloc))) {
         alloc->SetIdentity(AliasIdentity::AllocationSinkingCandidate());
         candidates_.Add(alloc);
       }
@@ -3657,6 +3827,178 @@ void AllocationSinking::CollectCandidates() {
   candidates_.TruncateTo(j);
 }
 
+// Returns true if the given allocation can be copied by
+// AllocationSinking::MaterializeAtEscapes.
+static bool CanCopyAllocation(Definition* alloc) {
+  return alloc->IsAllocateObject() || alloc->IsAllocateContext() ||
+         alloc->IsAllocateRecord() || alloc->IsAllocateSmallRecord() ||
+         (alloc->IsCreateArray() &&
+          IsValidLengthForAllocationSinking(alloc->AsCreateArray()));
+}
+
+// Create a new allocation of the same shape as the given one.
+static Definition* CopyAllocation(Zone* zone,
+                                  Definition* alloc,
+                                  intptr_t deopt_id) {
+  auto copy_value = [&](Value* value) -> Value* {
+    return (value != nullptr) ? new (zone) Value(value->definition()) : nullptr;
+  };
+  if (auto* const instr = alloc->AsAllocateObject()) {
+    return new (zone)
+        AllocateObjectInstr(instr->source(), instr->cls(), deopt_id,
+                            copy_value(instr->type_arguments()));
+  } else if (auto* const instr = alloc->AsAllocateContext()) {
+    return new (zone) AllocateContextInstr(instr->source(),
+                                           instr->context_slots(), deopt_id);
+  } else if (auto* const instr = alloc->AsAllocateRecord()) {
+    return new (zone)
+        AllocateRecordInstr(instr->source(), instr->shape(), deopt_id);
+  } else if (auto* const instr = alloc->AsAllocateSmallRecord()) {
+    return new (zone) AllocateSmallRecordInstr(
+        instr->source(), instr->shape(), copy_value(instr->InputAt(0)),
+        copy_value(instr->InputAt(1)),
+        instr->num_fields() > 2 ? copy_value(instr->InputAt(2)) : nullptr,
+        deopt_id);
+  } else if (auto* const instr = alloc->AsCreateArray()) {
+    return new (zone) CreateArrayInstr(
+        instr->source(), copy_value(instr->type_arguments()),
+        copy_value(instr->num_elements()), deopt_id);
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+// Returns true if the given allocation has any use (including environment
+// uses) which can be executed after [escape], or if [escape] itself can be
+// executed more than once for a single execution of the allocation.
+static bool IsUsedAfter(FlowGraph* flow_graph,
+                        Definition* alloc,
+                        Instruction* escape) {
+  Zone* zone = flow_graph->zone();
+  BlockEntryInstr* const escape_block = escape->GetBlock();
+
+  // Collect all blocks reachable from the escape.
+  BitVector* reachable =
+      new (zone) BitVector(zone, flow_graph->preorder().length());
+  GrowableArray<BlockEntryInstr*> worklist;
+  worklist.Add(escape_block);
+  while (!worklist.is_empty()) {
+    Instruction* last = worklist.RemoveLast()->last_instruction();
+    for (intptr_t i = 0; i < last->SuccessorCount(); i++) {
+      BlockEntryInstr* succ = last->SuccessorAt(i);
+      if (!reachable->Contains(succ->preorder_number())) {
+        reachable->Add(succ->preorder_number());
+        worklist.Add(succ);
+      }
+    }
+  }
+  if (reachable->Contains(escape_block->preorder_number())) {
+    // The escape is inside a loop which does not contain the allocation.
+    return true;
+  }
+
+  auto is_after_escape = [&](Instruction* instr) {
+    if (instr == escape) return false;
+    BlockEntryInstr* const block = instr->GetBlock();
+    if (reachable->Contains(block->preorder_number())) return true;
+    if (block != escape_block) return false;
+    for (Instruction* it = escape->next(); it != nullptr; it = it->next()) {
+      if (it == instr) return true;
+    }
+    return false;
+  };
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    if (is_after_escape(use->instruction())) return true;
+  }
+  for (Value* use = alloc->env_use_list(); use != nullptr;
+       use = use->next_use()) {
+    if (is_after_escape(use->instruction())) return true;
+  }
+  return false;
+}
+
+// Partial escape analysis: an allocation which is not a candidate for
+// sinking can still be removed from the paths where it does not escape if
+// every unsafe use is an instruction after which the allocation is dead.
+// Before each such escape the object is allocated with the state the
+// eliminated allocation would have had at that point (see
+// MaterializeAtEscapes). No path executes more than one of these escapes, so
+// the object identity is preserved.
+bool AllocationSinking::CollectPartialEscapes(Definition* alloc) {
+  const intptr_t kMaxEscapesPerAllocation = 4;
+
+  if (!CanCopyAllocation(alloc)) {
+    return false;
+  }
+
+  const bool is_aot = CompilerState::Current().is_aot();
+  auto* const partial_escape = new (Z) PartialEscape(Z, alloc);
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    Instruction* const instr = use->instruction();
+    Definition* const destination = StoreDestination(use);
+    if (destination == alloc) {
+      // Untagged fields can't be copied by a StoreField.
+      if (auto* const store = instr->AsStoreField()) {
+        if (store->slot().representation() == kUntagged) {
+          return false;
+        }
+      }
+    }
+    if (IsSafeUse(use, kOptimisticCheck)) {
+      if ((destination != nullptr) && (destination != alloc)) {
+        // Object stored into another candidate would need a copy at
+        // every exit of that candidate.
+        return false;
+      }
+      continue;
+    }
+    // The copy made before the escape reuses its environment: it has to
+    // exist and it must be possible to re-execute the escape after a lazy
+    // deoptimization at the allocation.
+    if (instr->IsPhi() || instr->IsLoadField() || instr->IsLoadIndexed() ||
+        (instr->env() == nullptr) ||
+        (!is_aot && (instr->deopt_id() == DeoptId::kNone)) ||
+        instr->GetBlock()->InsideTryBlock()) {
+      return false;
+    }
+    if (!partial_escape->escapes.Contains(instr)) {
+      if (partial_escape->escapes.length() == kMaxEscapesPerAllocation) {
+        return false;
+      }
+      partial_escape->escapes.Add(instr);
+    }
+  }
+
+  if (partial_escape->escapes.is_empty()) {
+    return false;
+  }
+
+  for (auto* const escape : partial_escape->escapes) {
+    if (IsUsedAfter(flow_graph_, alloc, escape)) {
+      return false;
+    }
+  }
+
+  if (FLAG_trace_optimization && flow_graph_->should_print()) {
+    THR_Print("allocation v%" Pd " escapes only at %" Pd " instruction(s)\n",
+              alloc->ssa_temp_index(), partial_escape->escapes.length());
+  }
+  partial_escapes_.Add(partial_escape);
+  return true;
+}
+
+AllocationSinking::PartialEscape* AllocationSinking::PartialEscapeFor(
+    Definition* alloc) const {
+  for (auto* const partial_escape : partial_escapes_) {
+    if (partial_escape->alloc == alloc) {
+      return partial_escape;
+    }
+  }
+  return nullptr;
+}
+
 // If materialization references an allocation sinking candidate then replace
 // this reference with a materialization which should have been computed for
 // this side-exit. CollectAllExits should have collected this exit.
@@ -3750,6 +4092,9 @@ void AllocationSinking::DiscoverFailedCandidates() {
       // use list: we will reconstruct it when we start removing
       // materializations.
       alloc->set_env_use_list(nullptr);
+      if (auto* const partial_escape = PartialEscapeFor(alloc)) {
+        RemoveCopiesAtEscapes(partial_escape);
+      }
       for (Value* use = alloc->input_use_list(); use != nullptr;
            use = use->next_use()) {
         if (use->instruction()->IsLoadField() ||
@@ -3761,7 +4106,8 @@ void AllocationSinking::DiscoverFailedCandidates() {
           ASSERT(use->instruction()->IsMaterializeObject() ||
                  use->instruction()->IsPhi() ||
                  use->instruction()->IsStoreField() ||
-                 use->instruction()->IsStoreIndexed());
+                 use->instruction()->IsStoreIndexed() ||
+                 (PartialEscapeFor(alloc) != nullptr));
         }
       }
     } else {
@@ -3825,6 +4171,14 @@ void AllocationSinking::Optimize() {
   //   v_{N+2} <- MaterializeObject([index_1] = v_1, ..., [index_N] = v_N,
   //                                type_arguments = v_{N+1})
   //
+  //
+  // Partially escaping candidates are copied before each of their escapes
+  // first, so that these copies get materializations as well.
+  for (auto* const partial_escape : partial_escapes_) {
+    if (partial_escape->alloc->Identity().IsAllocationSinkingCandidate()) {
+      MaterializeAtEscapes(partial_escape);
+    }
+  }
   for (intptr_t i = 0; i < candidates_.length(); i++) {
     InsertMaterializations(candidates_[i]);
   }
@@ -3944,6 +4298,40 @@ static InnerPointerAccess AccessForSlotInAllocatedObject(Definition* alloc,
   return InnerPointerAccess::kMayBeInnerPointer;
 }
 
+// Inserts a load of [slot] of [alloc] before [load_point].
+Definition* AllocationSinking::LoadFromAllocation(Instruction* load_point,
+                                                  Definition* alloc,
+                                                  const Slot& slot) {
+  Definition* load = nullptr;
+  if (slot.IsArrayElement()) {
+    intptr_t array_cid, index;
+    if (alloc->IsCreateArray()) {
+      array_cid = kArrayCid;
+      index = compiler::target::Array::index_at_offset(slot.offset_in_bytes());
+    } else if (auto alloc_typed_data = alloc->AsAllocateTypedData()) {
+      array_cid = alloc_typed_data->class_id();
+      index = slot.offset_in_bytes() /
+              compiler::target::Instance::ElementSizeFor(array_cid);
+    } else {
+      UNREACHABLE();
+    }
+    load = new (Z) LoadIndexedInstr(
+        new (Z) Value(alloc),
+        new (Z) Value(
+            flow_graph_->GetConstant(Smi::ZoneHandle(Z, Smi::New(index)))),
+        /*index_unboxed=*/false,
+        /*index_scale=*/compiler::target::Instance::ElementSizeFor(array_cid),
+        array_cid, kAlignedAccess, DeoptId::kNone, alloc->source());
+  } else {
+    InnerPointerAccess access = AccessForSlotInAllocatedObject(alloc, slot);
+    ASSERT(access != InnerPointerAccess::kMayBeInnerPointer);
+    load = new (Z)
+        LoadFieldInstr(new (Z) Value(alloc), slot, access, alloc->source());
+  }
+  flow_graph_->InsertBefore(load_point, load, nullptr, FlowGraph::kValue);
+  return load;
+}
+
 // Insert MaterializeObject instruction for the given allocation before
 // the given instruction that can deoptimize.
 void AllocationSinking::CreateMaterializationAt(
@@ -3959,35 +4347,7 @@ void AllocationSinking::CreateMaterializationAt(
 
   // Insert load instruction for every field and element.
   for (auto slot : slots) {
-    Definition* load = nullptr;
-    if (slot->IsArrayElement()) {
-      intptr_t array_cid, index;
-      if (alloc->IsCreateArray()) {
-        array_cid = kArrayCid;
-        index =
-            compiler::target::Array::index_at_offset(slot->offset_in_bytes());
-      } else if (auto alloc_typed_data = alloc->AsAllocateTypedData()) {
-        array_cid = alloc_typed_data->class_id();
-        index = slot->offset_in_bytes() /
-                compiler::target::Instance::ElementSizeFor(array_cid);
-      } else {
-        UNREACHABLE();
-      }
-      load = new (Z) LoadIndexedInstr(
-          new (Z) Value(alloc),
-          new (Z) Value(
-              flow_graph_->GetConstant(Smi::ZoneHandle(Z, Smi::New(index)))),
-          /*index_unboxed=*/false,
-          /*index_scale=*/compiler::target::Instance::ElementSizeFor(array_cid),
-          array_cid, kAlignedAccess, DeoptId::kNone, alloc->source());
-    } else {
-      InnerPointerAccess access = AccessForSlotInAllocatedObject(alloc, *slot);
-      ASSERT(access != InnerPointerAccess::kMayBeInnerPointer);
-      load = new (Z)
-          LoadFieldInstr(new (Z) Value(alloc), *slot, access, alloc->source());
-    }
-    flow_graph_->InsertBefore(load_point, load, nullptr, FlowGraph::kValue);
-    values.Add(new (Z) Value(load));
+    values.Add(new (Z) Value(LoadFromAllocation(load_point, alloc, *slot)));
   }
 
   const Class* cls = nullptr;
@@ -4113,7 +4473,8 @@ static bool IsDataFieldOfTypedDataView(Definition* alloc, const Slot& slot) {
   return IsTypedDataViewClassId(cid) || IsUnmodifiableTypedDataViewClassId(cid);
 }
 
-void AllocationSinking::InsertMaterializations(Definition* alloc) {
+ZoneGrowableArray<const Slot*>* AllocationSinking::CollectStoredSlots(
+    Definition* alloc) {
   // Collect all fields and array elements that are written for this instance.
   auto slots = new (Z) ZoneGrowableArray<const Slot*>(5);
 
@@ -4157,6 +4518,12 @@ void AllocationSinking::InsertMaterializations(Definition* alloc) {
     }
   }
 
+  return slots;
+}
+
+void AllocationSinking::InsertMaterializations(Definition* alloc) {
+  auto* const slots = CollectStoredSlots(alloc);
+
   // Collect all instructions that mention this object in the environment.
   exits_collector_.CollectTransitively(alloc);
 
@@ -4166,6 +4533,78 @@ void AllocationSinking::InsertMaterializations(Definition* alloc) {
   }
 }
 
+void AllocationSinking::MaterializeAtEscapes(PartialEscape* partial_escape) {
+  Definition* const alloc = partial_escape->alloc;
+  auto* const slots = CollectStoredSlots(alloc);
+
+  for (auto* const escape : partial_escape->escapes) {
+    // The copy is allocated right before the escape and can lazily deoptimize
+    // to it, so it takes over the escape's environment.
+    Definition* const copy = CopyAllocation(Z, alloc, escape->deopt_id());
+    flow_graph_->InsertSpeculativeBefore(escape, copy, escape->env(),
+                                         FlowGraph::kValue);
+
+    // Initialize the copy with the current state of the allocation. Loads
+    // are inserted before the copy and forwarded by the load optimizer just
+    // like loads inserted for materializations.
+    auto* const allocation = copy->AsAllocation();
+    for (auto* const slot : *slots) {
+      bool is_initialized_by_allocation = false;
+      for (intptr_t pos = 0; pos < allocation->InputCount(); pos++) {
+        if (allocation->SlotForInput(pos) == slot) {
+          is_initialized_by_allocation = true;
+          break;
+        }
+      }
+      if (is_initialized_by_allocation) continue;
+
+      Definition* const load = LoadFromAllocation(copy, alloc, *slot);
+      Instruction* store = nullptr;
+      if (slot->IsArrayElement()) {
+        ASSERT(alloc->IsCreateArray());
+        const intptr_t index =
+            compiler::target::Array::index_at_offset(slot->offset_in_bytes());
+        store = new (Z) StoreIndexedInstr(
+            new (Z) Value(copy),
+            new (Z) Value(
+                flow_graph_->GetConstant(Smi::ZoneHandle(Z, Smi::New(index)))),
+            new (Z) Value(load), kEmitStoreBarrier, /*index_unboxed=*/false,
+            compiler::target::Instance::ElementSizeFor(kArrayCid), kArrayCid,
+            kAlignedAccess, DeoptId::kNone, alloc->source());
+      } else {
+        store = new (Z) StoreFieldInstr(
+            *slot, new (Z) Value(copy), new (Z) Value(load), kEmitStoreBarrier,
+            alloc->source(), StoreFieldInstr::Kind::kInitializing);
+      }
+      flow_graph_->InsertBefore(escape, store, nullptr, FlowGraph::kEffect);
+    }
+
+    for (intptr_t i = 0; i < escape->InputCount(); i++) {
+      if (escape->InputAt(i)->definition() == alloc) {
+        escape->InputAt(i)->BindTo(copy);
+      }
+    }
+    escape->ReplaceInEnvironment(alloc, copy);
+    partial_escape->copies.Add(copy);
+  }
+}
+
+void AllocationSinking::RemoveCopiesAtEscapes(PartialEscape* partial_escape) {
+  for (auto* const copy : partial_escape->copies) {
+    Value* use = copy->input_use_list();
+    while (use != nullptr) {
+      Value* const next = use->next_use();
+      if (StoreDestination(use) == copy) {
+        use->instruction()->RemoveFromGraph();
+      }
+      use = next;
+    }
+    copy->ReplaceUsesWith(partial_escape->alloc);
+    copy->RemoveFromGraph();
+  }
+  partial_escape->copies.Clear();
+}
+
 // TryCatchAnalyzer tries to reduce the state that needs to be synchronized
 // on entry to the catch by discovering Parameter-s which are never used
 // or which are always constant.
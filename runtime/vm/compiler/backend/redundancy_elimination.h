@@ -21,7 +21,10 @@ class CSEInstructionSet;
 class AllocationSinking : public ZoneObject {
  public:
   explicit AllocationSinking(FlowGraph* flow_graph)
-      : flow_graph_(flow_graph), candidates_(5), materializations_(5) {}
+      : flow_graph_(flow_graph),
+        candidates_(5),
+        materializations_(5),
+        partial_escapes_(1) {}
 
   const GrowableArray<Definition*>& candidates() const { return candidates_; }
 
@@ -58,8 +61,40 @@ class AllocationSinking : public ZoneObject {
     GrowableArray<Definition*> worklist_;
   };
 
+  // Allocation which escapes only at a few instructions from which no
+  // other use of it is reachable (e.g. it is thrown or passed to a logging
+  // call on an error path). Such an allocation is still eliminated, and a copy
+  // reflecting its current state is allocated right before each of the
+  // escaping instructions instead.
+  struct PartialEscape : public ZoneObject {
+    PartialEscape(Zone* zone, Definition* alloc)
+        : alloc(alloc), escapes(zone, 2), copies(zone, 2) {}
+
+    Definition* const alloc;
+    GrowableArray<Instruction*> escapes;
+    // Copy of [alloc] made for each of [escapes] (once inserted).
+    GrowableArray<Definition*> copies;
+  };
+
   void CollectCandidates();
 
+  // Check if all unsafe uses of the given allocation are escapes after which
+  // the allocation is dead and record them in [partial_escapes_].
+  bool CollectPartialEscapes(Definition* alloc);
+
+  PartialEscape* PartialEscapeFor(Definition* alloc) const;
+
+  // Insert copies of the allocation before each of its escapes.
+  void MaterializeAtEscapes(PartialEscape* partial_escape);
+
+  // Undo MaterializeAtEscapes for an allocation which turned out not to be
+  // eliminable.
+  void RemoveCopiesAtEscapes(PartialEscape* partial_escape);
+
+  Definition* LoadFromAllocation(Instruction* load_point,
+                                 Definition* alloc,
+                                 const Slot& slot);
+
   void NormalizeMaterializations();
 
   void RemoveUnusedMaterializations();
@@ -68,6 +103,10 @@ class AllocationSinking : public ZoneObject {
 
   void InsertMaterializations(Definition* alloc);
 
+  // Collect all fields and array elements of the given allocation which
+  // have to be described by a materialization.
+  ZoneGrowableArray<const Slot*>* CollectStoredSlots(Definition* alloc);
+
   void CreateMaterializationAt(Instruction* exit,
                                Definition* alloc,
                                const ZoneGrowableArray<const Slot*>& fields);
@@ -86,6 +125,7 @@ class AllocationSinking : public ZoneObject {
 
   GrowableArray<Definition*> candidates_;
   GrowableArray<MaterializeObjectInstr*> materializations_;
+  GrowableArray<PartialEscape*> partial_escapes_;
 
   ExitsCollector exits_collector_;
 };
@@ -164,6 +204,19 @@ class DelayAllocations : public AllStatic {
                            BlockEntryInstr* def_block);
 };
 
+// Hoist allocations of small objects which don't escape a loop iteration
+// out of the loop, so that a single object is reused by all iterations.
+class ReuseLoopAllocations : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* graph);
+
+ private:
+  static bool IsReusable(Definition* alloc, BlockEntryInstr* pre_header);
+  static void ResetStoredSlots(FlowGraph* graph,
+                               Definition* alloc,
+                               Instruction* reset_point);
+};
+
 class CheckStackOverflowElimination : public AllStatic {
  public:
   // For leaf functions with only a single [StackOverflowInstr] we remove it.
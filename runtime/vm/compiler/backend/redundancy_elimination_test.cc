@@ -26,6 +26,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, reuse_loop_allocations);
+
 static void NoopNative(Dart_NativeArguments args) {}
 
 static Dart_NativeFunction NoopNativeLookup(Dart_Handle name,
@@ -1705,6 +1707,418 @@ ISOLATE_UNIT_TEST_CASE(CSE_Redefinitions) {
                             it.ArgumentAt(2)->OriginalDefinition() == load0);
 }
 
+// Finds the allocations of the graph and the call to sink(), which receives
+// the escaping object in the partial escape tests below.
+static void FindAllocationsAndSinkCall(FlowGraph* flow_graph,
+                                       intptr_t* num_allocations,
+                                       AllocateObjectInstr** allocate,
+                                       StaticCallInstr** sink) {
+  *num_allocations = 0;
+  *allocate = nullptr;
+  *sink = nullptr;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (auto* const alloc = instr->AsAllocateObject()) {
+        *allocate = alloc;
+        (*num_allocations)++;
+      } else if (auto* const call = instr->AsStaticCall()) {
+        if (strcmp(call->function().UserVisibleNameCString(), "sink") == 0) {
+          *sink = call;
+        }
+      }
+    }
+  }
+}
+
+// Allocation which escapes only on a cold path is moved into that path.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscape) {
+  const char* kScript = R"(
+    class K {
+      int x;
+      K(this.x);
+    }
+
+    @pragma("vm:never-inline")
+    void sink(Object o) {}
+
+    @pragma("vm:entry-point", "call")
+    int test(int v) {
+      final k = K(v);
+      if (v < 0) {
+        sink(k);
+        return -1;
+      }
+      return k.x;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t num_allocations;
+  AllocateObjectInstr* allocate;
+  StaticCallInstr* sink;
+  FindAllocationsAndSinkCall(flow_graph, &num_allocations, &allocate, &sink);
+
+  EXPECT_EQ(1, num_allocations);
+  RELEASE_ASSERT(allocate != nullptr && sink != nullptr);
+  EXPECT(allocate->GetBlock() == sink->GetBlock());
+  EXPECT(allocate->GetBlock() != flow_graph->graph_entry()->normal_entry());
+  EXPECT(sink->ArgumentAt(0) == allocate);
+}
+
+// Non-escaping allocation inside a loop is allocated once before the loop.
+ISOLATE_UNIT_TEST_CASE(ReuseLoopAllocations_Array) {
+  SetFlagScope<bool> sfs(&FLAG_reuse_loop_allocations, true);
+  const char* kScript = R"(
+    @pragma("vm:entry-point", "call")
+    int test(int n) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        final l = List<int>.filled(3, 0);
+        l[i % 3] = i;
+        sum += l[(i + 1) % 3] + l[i % 3];
+      }
+      return sum;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t num_allocations = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (instr->IsCreateArray()) {
+        EXPECT(block->loop_info() == nullptr);
+        num_allocations++;
+      }
+    }
+  }
+  EXPECT_EQ(1, num_allocations);
+}
+
+// An escape inside a loop which does not contain the allocation can be
+// executed several times for one allocation, so the allocation is kept.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscapeInLoop) {
+  const char* kScript = R"(
+    class K {
+      int x;
+      K(this.x);
+    }
+
+    @pragma("vm:never-inline")
+    void sink(Object o) {}
+
+    @pragma("vm:entry-point", "call")
+    int test(int v, int n) {
+      final k = K(v);
+      for (int i = 0; i < n; i++) {
+        if (i == v) {
+          sink(k);
+        }
+      }
+      return k.x;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t num_allocations;
+  AllocateObjectInstr* allocate;
+  StaticCallInstr* sink;
+  FindAllocationsAndSinkCall(flow_graph, &num_allocations, &allocate, &sink);
+
+  EXPECT_EQ(1, num_allocations);
+  RELEASE_ASSERT(allocate != nullptr && sink != nullptr);
+  flow_graph->ResetLoopHierarchy();
+  flow_graph->GetLoopHierarchy();
+  EXPECT(allocate->GetBlock() != sink->GetBlock());
+  EXPECT(allocate->GetBlock()->loop_info() == nullptr);
+  EXPECT(sink->GetBlock()->loop_info() != nullptr);
+  EXPECT(sink->ArgumentAt(0) == allocate);
+}
+
+// Escapes inside try blocks are not handled: the catch block could observe
+// the allocation after the escape.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscapeInTryCatch) {
+  const char* kScript = R"(
+    class K {
+      int x;
+      K(this.x);
+    }
+
+    @pragma("vm:never-inline")
+    void sink(Object o) {}
+
+    @pragma("vm:entry-point", "call")
+    int test(int v) {
+      final k = K(v);
+      try {
+        if (v < 0) {
+          sink(k);
+          return -1;
+        }
+      } catch (e) {
+        return -2;
+      }
+      return k.x;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t num_allocations;
+  AllocateObjectInstr* allocate;
+  StaticCallInstr* sink;
+  FindAllocationsAndSinkCall(flow_graph, &num_allocations, &allocate, &sink);
+
+  EXPECT_EQ(1, num_allocations);
+  RELEASE_ASSERT(allocate != nullptr && sink != nullptr);
+  EXPECT(!allocate->GetBlock()->InsideTryBlock());
+  EXPECT(sink->GetBlock()->InsideTryBlock());
+  EXPECT(sink->ArgumentAt(0) == allocate);
+}
+
+// A partially escaping allocation which is sunk into its escape is
+// materialized when the path without the escape deoptimizes.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_PartialEscapeDeoptimization) {
+  const char* kScript = R"(
+    class K {
+      int x;
+      K(this.x);
+    }
+
+    Object? escaped;
+
+    @pragma("vm:never-inline")
+    void sink(Object o) {
+      escaped = o;
+    }
+
+    @pragma("vm:never-inline")
+    int test(int v, num d) {
+      final k = K(v);
+      if (v < 0) {
+        sink(k);
+        return -1;
+      }
+      return (d + 1).toInt() + k.x;
+    }
+
+    @pragma("vm:entry-point", "call")
+    bool no_deopt() {
+      return test(5, 1) == 7 && test(-3, 1) == -1 && (escaped as K).x == -3;
+    }
+
+    @pragma("vm:entry-point", "call")
+    bool deopt() {
+      return test(5, 1.5) == 7;
+    }
+  )";
+
+  const auto& lib = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::ZoneHandle(GetFunction(lib, "test"));
+
+  // Run the unoptimized code to collect type feedback for d + 1.
+  auto& result = Object::Handle(Invoke(lib, "no_deopt"));
+  EXPECT(Bool::Cast(result).value());
+
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSetOuterInliningId,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kBranchSimplify,
+      CompilerPass::kIfConvert,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kOptimisticallySpecializeSmiPhis,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kCSE,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kLICM,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kDSE,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations,
+      CompilerPass::kEliminateEnvironments,
+      CompilerPass::kEliminateDeadPhis,
+      CompilerPass::kDCE,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kOptimizeBranches,
+      CompilerPass::kAllocationSinking_Sink,
+  });
+
+  intptr_t num_allocations;
+  AllocateObjectInstr* allocate;
+  StaticCallInstr* sink;
+  FindAllocationsAndSinkCall(flow_graph, &num_allocations, &allocate, &sink);
+
+  // Only the copy made for the escape is left.
+  EXPECT_EQ(1, num_allocations);
+  RELEASE_ASSERT(allocate != nullptr && sink != nullptr);
+  EXPECT(allocate->GetBlock() == sink->GetBlock());
+  EXPECT(sink->ArgumentAt(0) == allocate);
+
+  // The eliminated allocation is materialized on deoptimization.
+  intptr_t mat_count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (auto* const mat = instr->AsMaterializeObject()) {
+        if (mat->cls().ptr() == allocate->cls().ptr()) {
+          ++mat_count;
+        }
+      }
+    }
+  }
+  EXPECT(mat_count > 0);
+
+  pipeline.RunAdditionalPasses({
+      CompilerPass::kEliminateDeadPhis,
+      CompilerPass::kDCE,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kSelectRepresentations_Final,
+      CompilerPass::kUseTableDispatch,
+      CompilerPass::kEliminateStackOverflowChecks,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kAllocationSinking_DetachMaterializations,
+      CompilerPass::kEliminateWriteBarriers,
+      CompilerPass::kLoweringAfterCodeMotionDisabled,
+      CompilerPass::kFinalizeGraph,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kReorderBlocks,
+      CompilerPass::kAllocateRegisters,
+      CompilerPass::kTestILSerialization,
+  });
+  pipeline.CompileGraphAndAttachFunction();
+
+  // The escaping path allocates the object with its current state.
+  result = Invoke(lib, "no_deopt");
+  EXPECT(function.HasOptimizedCode());
+  EXPECT(Bool::Cast(result).value());
+
+  // Deoptimization at d + 1 materializes k for the unoptimized code.
+  result = Invoke(lib, "deopt");
+  EXPECT(!function.HasOptimizedCode());
+  EXPECT(Bool::Cast(result).value());
+}
+
+// Counts the array allocations of the graph inside and outside of loops.
+static void CountArrayAllocations(FlowGraph* flow_graph,
+                                  intptr_t* inside_loops,
+                                  intptr_t* outside_loops) {
+  flow_graph->ResetLoopHierarchy();
+  flow_graph->GetLoopHierarchy();
+  *inside_loops = 0;
+  *outside_loops = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (auto instr : block->instructions()) {
+      if (instr->IsCreateArray()) {
+        if (block->loop_info() != nullptr) {
+          (*inside_loops)++;
+        } else {
+          (*outside_loops)++;
+        }
+      }
+    }
+  }
+}
+
+// An allocation which flows into a phi can be observed by a later
+// iteration, so every iteration keeps allocating.
+ISOLATE_UNIT_TEST_CASE(ReuseLoopAllocations_EscapeThroughPhi) {
+  SetFlagScope<bool> sfs(&FLAG_reuse_loop_allocations, true);
+  const char* kScript = R"(
+    @pragma("vm:entry-point", "call")
+    int test(int n) {
+      int sum = 0;
+      var previous = List<int>.filled(3, 0);
+      for (int i = 0; i < n; i++) {
+        final l = List<int>.filled(3, 0);
+        l[i % 3] = i;
+        sum += previous[i % 3] + l[(i + 1) % 3];
+        previous = l;
+      }
+      return sum;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t inside_loops, outside_loops;
+  CountArrayAllocations(flow_graph, &inside_loops, &outside_loops);
+  EXPECT_EQ(1, inside_loops);
+  EXPECT_EQ(1, outside_loops);
+}
+
+// An allocation which is stored into another object on some iteration
+// outlives that iteration, so every iteration keeps allocating.
+ISOLATE_UNIT_TEST_CASE(ReuseLoopAllocations_StoredOnLaterIteration) {
+  SetFlagScope<bool> sfs(&FLAG_reuse_loop_allocations, true);
+  const char* kScript = R"(
+    @pragma("vm:entry-point", "call")
+    List<Object?> test(int n) {
+      final kept = List<Object?>.filled(1, null);
+      for (int i = 0; i < n; i++) {
+        final l = List<int>.filled(3, 0);
+        l[i % 3] = i;
+        if (i == 2) {
+          kept[0] = l;
+        }
+      }
+      return kept;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  ASSERT(flow_graph != nullptr);
+
+  intptr_t inside_loops, outside_loops;
+  CountArrayAllocations(flow_graph, &inside_loops, &outside_loops);
+  EXPECT_EQ(1, inside_loops);
+  EXPECT_EQ(1, outside_loops);
+}
+
 ISOLATE_UNIT_TEST_CASE(AllocationSinking_NoViewDataMaterialization) {
   auto* const kFunctionName = "unalignedUint16";
   auto* const kInvokeNoDeoptName = "no_deopt";
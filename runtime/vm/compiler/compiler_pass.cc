@@ -338,6 +338,7 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(AllocationSinking_Sink);
   INVOKE_PASS(EliminateDeadPhis);
   INVOKE_PASS(DCE);
+  INVOKE_PASS_AOT(ReuseLoopAllocations);
   INVOKE_PASS(Canonicalize);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(SelectRepresentations_Final);
@@ -487,6 +488,9 @@ COMPILER_PASS(DCE, { DeadCodeElimination::EliminateDeadCode(flow_graph); });
 
 COMPILER_PASS(DelayAllocations, { DelayAllocations::Optimize(flow_graph); });
 
+COMPILER_PASS(ReuseLoopAllocations,
+              { ReuseLoopAllocations::Optimize(flow_graph); });
+
 COMPILER_PASS(AllocationSinking_Sink, {
   // TODO(vegorov): Support allocation sinking with try-catch.
   if (flow_graph->try_entries().is_empty()) {
@@ -45,6 +45,7 @@ namespace dart {
   V(OptimizeTypedDataAccesses)                                                 \
   V(RangeAnalysis)                                                             \
   V(ReorderBlocks)                                                             \
+  V(ReuseLoopAllocations)                                                      \
   V(SelectRepresentations)                                                     \
   V(SelectRepresentations_Final)                                               \
   V(SetOuterInliningId)                                                        \
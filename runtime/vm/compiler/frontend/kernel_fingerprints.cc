@@ -4,6 +4,8 @@
 
 #include "vm/compiler/frontend/kernel_fingerprints.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/hash_map.h"
+#include "vm/kernel_loader.h"
 
 #define H (translation_helper_)
 #define I Isolate::Current()
@@ -16,13 +18,18 @@ class KernelFingerprintHelper : public KernelReaderHelper {
   KernelFingerprintHelper(Zone* zone,
                           TranslationHelper* translation_helper,
                           const TypedDataView& data,
-                          intptr_t data_program_offset)
+                          intptr_t data_program_offset,
+                          bool hash_values = false)
       : KernelReaderHelper(zone, translation_helper, data, data_program_offset),
+        hash_values_(hash_values),
+        constant_hashes_(zone),
         hash_(0) {}
 
   virtual ~KernelFingerprintHelper() {}
   uint32_t CalculateFieldFingerprint();
   uint32_t CalculateFunctionFingerprint();
+  uint32_t CalculateClassFingerprint();
+  uint32_t CalculateLibraryFingerprint(const LibraryIndex& library_index);
 
   static uint32_t CalculateHash(uint32_t current, uint32_t val) {
     return current * 31 + val;
@@ -56,7 +63,16 @@ class KernelFingerprintHelper : public KernelReaderHelper {
   void CalculateExpressionFingerprint();
   void CalculateStatementFingerprint();
   void CalculateFunctionNodeFingerprint();
-
+  void CalculateConstantReferenceFingerprint();
+  uint32_t CalculateConstantFingerprint(intptr_t constant_index);
+
+  // Whether the values of constants, integer literals and field initializers
+  // are hashed. They are not part of the source fingerprints of functions,
+  // which are compared against the recorded fingerprints of recognized
+  // methods.
+  const bool hash_values_;
+  // The hashes of the constants computed so far, by constant index.
+  IntMap<uint32_t> constant_hashes_;
   uint32_t hash_;
 
   DISALLOW_COPY_AND_ASSIGN(KernelFingerprintHelper);
@@ -674,6 +690,9 @@ void KernelFingerprintHelper::CalculateExpressionFingerprint() {
       return;
     case kSpecializedIntLiteral:
       ReadPosition();  // read position.
+      if (hash_values_) {
+        BuildHash(payload);
+      }
       return;
     case kNegativeIntLiteral:
       ReadPosition();         // read position.
@@ -703,13 +722,13 @@ void KernelFingerprintHelper::CalculateExpressionFingerprint() {
     case kConstantExpression:
       ReadPosition();
       SkipDartType();
-      SkipConstantReference();
+      CalculateConstantReferenceFingerprint();
       return;
     case kFileUriConstantExpression:
       ReadPosition();
       ReadUInt();  // skip uri
       SkipDartType();
-      SkipConstantReference();
+      CalculateConstantReferenceFingerprint();
       return;
     case kLoadLibrary:
     case kCheckLibraryIsLoaded:
@@ -905,6 +924,140 @@ void KernelFingerprintHelper::CalculateStatementFingerprint() {
   }
 }
 
+void KernelFingerprintHelper::CalculateConstantReferenceFingerprint() {
+  const intptr_t constant_index = ReadUInt();  // read constant index.
+  if (hash_values_) {
+    BuildHash(CalculateConstantFingerprint(constant_index));
+  }
+}
+
+uint32_t KernelFingerprintHelper::CalculateConstantFingerprint(
+    intptr_t constant_index) {
+  if (auto* pair = constant_hashes_.LookupPair(constant_index)) {
+    return pair->value;
+  }
+
+  // The constants table ends with the offsets of the constants, followed by
+  // their number.
+  const TypedDataView& constants_table = H.constants_table();
+  const intptr_t size = constants_table.LengthInBytes();
+  intptr_t constant_offset;
+  {
+    AlternativeReadingScopeWithNewData alt(&reader_, &constants_table,
+                                           size - 4);
+    const intptr_t num_constants = ReadUInt32();
+    SetOffset(size - 4 - (num_constants - constant_index) * 4);
+    constant_offset = ReadUInt32();
+  }
+
+  const uint32_t saved_hash = hash_;
+  hash_ = 0;
+  {
+    AlternativeReadingScopeWithNewData alt(&reader_, &constants_table,
+                                           constant_offset);
+    const uint8_t constant_tag = ReadByte();
+    BuildHash(constant_tag);
+    switch (constant_tag) {
+      case kNullConstant:
+        break;
+      case kBoolConstant:
+        BuildHash(ReadByte());
+        break;
+      case kIntConstant:
+        CalculateExpressionFingerprint();  // read integer literal.
+        break;
+      case kDoubleConstant: {
+        const uint64_t data = bit_cast<uint64_t>(ReadDouble());
+        BuildHash(static_cast<uint32_t>(data >> 32));
+        BuildHash(static_cast<uint32_t>(data));
+        break;
+      }
+      case kStringConstant:
+        CalculateStringReferenceFingerprint();
+        break;
+      case kSymbolConstant: {
+        const NameIndex library = ReadCanonicalNameReference();
+        if (library != -1) {
+          BuildHash(H.DartString(H.CanonicalNameString(library)).Hash());
+        }
+        CalculateStringReferenceFingerprint();
+        break;
+      }
+      case kListConstant:
+      case kSetConstant: {
+        CalculateDartTypeFingerprint();  // read element type.
+        const intptr_t length = ReadUInt();
+        BuildHash(length);
+        for (intptr_t i = 0; i < length; ++i) {
+          BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        }
+        break;
+      }
+      case kMapConstant: {
+        CalculateDartTypeFingerprint();  // read key type.
+        CalculateDartTypeFingerprint();  // read value type.
+        const intptr_t length = ReadUInt();
+        BuildHash(length);
+        for (intptr_t i = 0; i < 2 * length; ++i) {
+          BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        }
+        break;
+      }
+      case kRecordConstant: {
+        const intptr_t num_positional = ReadListLength();
+        BuildHash(num_positional);
+        for (intptr_t i = 0; i < num_positional; ++i) {
+          BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        }
+        const intptr_t num_named = ReadListLength();
+        BuildHash(num_named);
+        for (intptr_t i = 0; i < num_named; ++i) {
+          CalculateStringReferenceFingerprint();
+          BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        }
+        break;
+      }
+      case kInstanceConstant: {
+        CalculateCanonicalNameFingerprint();  // read class.
+        const intptr_t number_of_type_arguments = ReadUInt();
+        for (intptr_t i = 0; i < number_of_type_arguments; ++i) {
+          CalculateDartTypeFingerprint();
+        }
+        const intptr_t number_of_fields = ReadUInt();
+        BuildHash(number_of_fields);
+        for (intptr_t i = 0; i < number_of_fields; ++i) {
+          CalculateCanonicalNameFingerprint();  // read field.
+          BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        }
+        break;
+      }
+      case kInstantiationConstant: {
+        BuildHash(CalculateConstantFingerprint(ReadUInt()));
+        const intptr_t number_of_type_arguments = ReadUInt();
+        for (intptr_t i = 0; i < number_of_type_arguments; ++i) {
+          CalculateDartTypeFingerprint();
+        }
+        break;
+      }
+      case kStaticTearOffConstant:
+      case kConstructorTearOffConstant:
+      case kRedirectingFactoryTearOffConstant:
+        CalculateCanonicalNameFingerprint();  // read member.
+        break;
+      case kTypeLiteralConstant:
+        CalculateDartTypeFingerprint();
+        break;
+      default:
+        ReportUnexpectedTag("constant", static_cast<Tag>(constant_tag));
+        UNREACHABLE();
+    }
+  }
+  const uint32_t hash = hash_;
+  hash_ = saved_hash;
+  constant_hashes_.Insert(constant_index, hash);
+  return hash;
+}
+
 uint32_t KernelFingerprintHelper::CalculateFieldFingerprint() {
   hash_ = 0;
   FieldHelper field_helper(this);
@@ -913,6 +1066,12 @@ uint32_t KernelFingerprintHelper::CalculateFieldFingerprint() {
   const String& name = ReadNameAsFieldName();  // read name.
   field_helper.SetJustRead(FieldHelper::kName);
 
+  if (hash_values_) {
+    field_helper.ReadUntilExcluding(FieldHelper::kAnnotations);
+    CalculateListOfExpressionsFingerprint();  // read annotations.
+    field_helper.SetJustRead(FieldHelper::kAnnotations);
+  }
+
   field_helper.ReadUntilExcluding(FieldHelper::kType);
   CalculateDartTypeFingerprint();  // read type.
   field_helper.SetJustRead(FieldHelper::kType);
@@ -921,7 +1080,7 @@ uint32_t KernelFingerprintHelper::CalculateFieldFingerprint() {
     SkipVariable();  // read this_variable.
   }
   if (ReadTag() == kSomething) {
-    if (PeekTag() == kFunctionExpression) {
+    if (hash_values_ || PeekTag() == kFunctionExpression) {
       AlternativeReadingScope alt(&reader_);
       CalculateExpressionFingerprint();
     }
@@ -982,6 +1141,12 @@ uint32_t KernelFingerprintHelper::CalculateFunctionFingerprint() {
   const String& name = ReadNameAsMethodName();  // Read name.
   procedure_helper.SetJustRead(ProcedureHelper::kName);
 
+  if (hash_values_) {
+    procedure_helper.ReadUntilExcluding(ProcedureHelper::kAnnotations);
+    CalculateListOfExpressionsFingerprint();  // read annotations.
+    procedure_helper.SetJustRead(ProcedureHelper::kAnnotations);
+  }
+
   procedure_helper.ReadUntilExcluding(ProcedureHelper::kFunction);
   CalculateFunctionNodeFingerprint();
 
@@ -993,6 +1158,95 @@ uint32_t KernelFingerprintHelper::CalculateFunctionFingerprint() {
   return hash_;
 }
 
+uint32_t KernelFingerprintHelper::CalculateClassFingerprint() {
+  hash_ = 0;
+  ClassHelper class_helper(this);
+  class_helper.ReadUntilIncluding(ClassHelper::kNameIndex);
+  BuildHash(H.DartString(class_helper.name_index_).Hash());
+  BuildHash(class_helper.flags_);
+
+  class_helper.ReadUntilExcluding(ClassHelper::kAnnotations);
+  CalculateListOfExpressionsFingerprint();  // read annotations.
+  class_helper.SetJustRead(ClassHelper::kAnnotations);
+
+  class_helper.ReadUntilExcluding(ClassHelper::kTypeParameters);
+  CalculateTypeParametersListFingerprint();
+  CalculateOptionalDartTypeFingerprint();  // read super class type.
+  CalculateOptionalDartTypeFingerprint();  // read mixin type.
+  CalculateListOfDartTypesFingerprint();   // read implemented classes.
+  class_helper.SetJustRead(ClassHelper::kImplementedClasses);
+  uint32_t hash = hash_;
+
+  // Members are fingerprinted from their start and skipped by their helpers.
+  const intptr_t field_count = ReadListLength();  // read list length.
+  for (intptr_t i = 0; i < field_count; ++i) {
+    {
+      AlternativeReadingScope alt(&reader_);
+      hash = CalculateHash(hash, CalculateFieldFingerprint());
+    }
+    FieldHelper field_helper(this);
+    field_helper.ReadUntilExcluding(FieldHelper::kEnd);
+  }
+  class_helper.SetJustRead(ClassHelper::kFields);
+
+  const intptr_t constructor_count = ReadListLength();  // read list length.
+  for (intptr_t i = 0; i < constructor_count; ++i) {
+    {
+      AlternativeReadingScope alt(&reader_);
+      hash = CalculateHash(hash, CalculateFunctionFingerprint());
+    }
+    ConstructorHelper constructor_helper(this);
+    constructor_helper.ReadUntilExcluding(ConstructorHelper::kEnd);
+  }
+  class_helper.SetJustRead(ClassHelper::kConstructors);
+
+  const intptr_t procedure_count = ReadListLength();  // read list length.
+  for (intptr_t i = 0; i < procedure_count; ++i) {
+    {
+      AlternativeReadingScope alt(&reader_);
+      hash = CalculateHash(hash, CalculateFunctionFingerprint());
+    }
+    ProcedureHelper procedure_helper(this);
+    procedure_helper.ReadUntilExcluding(ProcedureHelper::kEnd);
+  }
+  class_helper.SetJustRead(ClassHelper::kProcedures);
+  return hash;
+}
+
+uint32_t KernelFingerprintHelper::CalculateLibraryFingerprint(
+    const LibraryIndex& library_index) {
+  // Offsets within library index are whole program offsets and not
+  // relative to the library.
+  const intptr_t correction = -data_program_offset_;
+  uint32_t hash = 0;
+  const intptr_t class_count = library_index.class_count();
+  for (intptr_t i = 0; i < class_count; ++i) {
+    SetOffset(library_index.ClassOffset(i) + correction);
+    hash = CalculateHash(hash, CalculateClassFingerprint());
+  }
+
+  // Toplevel fields follow the extensions, which are not indexed.
+  SetOffset(library_index.ClassOffset(class_count) + correction);
+  SkipListOfExtensions();
+  SkipListOfExtensionTypeDeclarations();
+  const intptr_t field_count = ReadListLength();  // read list length.
+  for (intptr_t i = 0; i < field_count; ++i) {
+    {
+      AlternativeReadingScope alt(&reader_);
+      hash = CalculateHash(hash, CalculateFieldFingerprint());
+    }
+    FieldHelper field_helper(this);
+    field_helper.ReadUntilExcluding(FieldHelper::kEnd);
+  }
+
+  const intptr_t procedure_count = library_index.procedure_count();
+  for (intptr_t i = 0; i < procedure_count; ++i) {
+    SetOffset(library_index.ProcedureOffset(i) + correction);
+    hash = CalculateHash(hash, CalculateFunctionFingerprint());
+  }
+  return hash;
+}
+
 uint32_t KernelSourceFingerprintHelper::CalculateClassFingerprint(
     const Class& klass) {
   Zone* zone = Thread::Current()->zone();
@@ -1071,5 +1325,25 @@ uint32_t KernelSourceFingerprintHelper::CalculateFunctionFingerprint(
   return helper.CalculateFunctionFingerprint();
 }
 
+uint32_t KernelSourceFingerprintHelper::CalculateLibraryFingerprint(
+    const Library& library) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const auto& info =
+      KernelProgramInfo::Handle(zone, library.kernel_program_info());
+
+  TranslationHelper translation_helper(thread);
+  translation_helper.InitFromKernelProgramInfo(info);
+
+  const auto& library_kernel_data =
+      TypedDataView::Handle(zone, library.KernelLibrary());
+  KernelFingerprintHelper helper(zone, &translation_helper,
+                                 library_kernel_data,
+                                 library.KernelLibraryOffset(),
+                                 /*hash_values=*/true);
+  LibraryIndex library_index(library_kernel_data);
+  return helper.CalculateLibraryFingerprint(library_index);
+}
+
 }  // namespace kernel
 }  // namespace dart
@@ -20,6 +20,10 @@ class KernelSourceFingerprintHelper : public AllStatic {
   static uint32_t CalculateClassFingerprint(const Class& klass);
   static uint32_t CalculateFieldFingerprint(const Field& field);
   static uint32_t CalculateFunctionFingerprint(const Function& func);
+
+  // Fingerprints the declarations and bodies in the kernel data of [library]
+  // without loading its classes.
+  static uint32_t CalculateLibraryFingerprint(const Library& library);
 };
 
 }  // namespace kernel
@@ -3161,6 +3161,64 @@ void KernelReaderHelper::SkipLibraryDependency() {
   }
 }
 
+void KernelReaderHelper::SkipListOfExtensions() {
+  const intptr_t extension_count = ReadListLength();  // read list length.
+  for (intptr_t i = 0; i < extension_count; ++i) {
+    ReadTag();                     // read tag.
+    SkipCanonicalNameReference();  // skip canonical name.
+    SkipStringReference();         // skip name.
+    SkipListOfExpressions();       // skip annotations.
+    ReadUInt();                    // read source uri index.
+    ReadPosition();                // read file offset.
+    ReadByte();                    // skip flags.
+    SkipTypeParametersList();      // skip type parameter list.
+    SkipDartType();                // skip on-type.
+
+    const intptr_t extension_member_count = ReadListLength();
+    for (intptr_t j = 0; j < extension_member_count; ++j) {
+      SkipName();                    // skip name.
+      ReadByte();                    // read kind.
+      ReadByte();                    // read flags.
+      SkipCanonicalNameReference();  // skip member reference
+      SkipCanonicalNameReference();  // skip tear-off reference
+    }
+  }
+}
+
+void KernelReaderHelper::SkipListOfExtensionTypeDeclarations() {
+  const intptr_t extension_type_declaration_count = ReadListLength();
+  for (intptr_t i = 0; i < extension_type_declaration_count; ++i) {
+    ReadTag();                     // read tag.
+    SkipCanonicalNameReference();  // skip canonical name.
+    SkipStringReference();         // skip name.
+    SkipListOfExpressions();       // skip annotations.
+    ReadUInt();                    // read source uri index.
+    ReadPosition();                // read file offset.
+    ReadByte();                    // skip flags.
+    SkipTypeParametersList();      // skip type parameter list.
+    SkipDartType();                // skip declared representation type.
+    SkipStringReference();         // skip representation name.
+    SkipListOfDartTypes();         // skip implements types.
+
+    // Skip extension type procedures.
+    const intptr_t extension_type_procedure_count =
+        ReadListLength();  // read list length.
+    for (intptr_t j = 0; j < extension_type_procedure_count; ++j) {
+      ProcedureHelper procedure_helper(this);
+      procedure_helper.ReadUntilExcluding(ProcedureHelper::kEnd);
+    }
+
+    const intptr_t extension_type_member_count = ReadListLength();
+    for (intptr_t j = 0; j < extension_type_member_count; ++j) {
+      SkipName();                    // skip name.
+      ReadByte();                    // read kind.
+      ReadByte();                    // read flags.
+      SkipCanonicalNameReference();  // skip member reference
+      SkipCanonicalNameReference();  // skip tear-off reference
+    }
+  }
+}
+
 void KernelReaderHelper::SkipScope() {
   Tag tag = ReadTag();  // read tag.
   if (tag == kSomething) {
@@ -3238,6 +3296,16 @@ const String& KernelReaderHelper::GetSourceFor(intptr_t index) {
   }
 }
 
+const uint8_t* KernelReaderHelper::GetSourceBytesFor(intptr_t index,
+                                                     intptr_t* size) {
+  AlternativeReadingScope alt(&reader_);
+  SetOffset(GetOffsetForSourceInfo(index));
+  SkipBytes(ReadUInt());  // skip uri.
+  *size = ReadUInt();     // read source List<byte> size.
+  ASSERT(*size >= 0);
+  return reader_.BufferAt(ReaderOffset());
+}
+
 TypedDataPtr KernelReaderHelper::GetLineStartsFor(intptr_t index) {
   // Line starts are delta encoded. So get the max delta first so that we
   // can store them as tightly as possible.
@@ -1361,6 +1361,8 @@ class KernelReaderHelper {
   void SkipVariable();
   void SkipLibraryCombinator();
   void SkipLibraryDependency();
+  void SkipListOfExtensions();
+  void SkipListOfExtensionTypeDeclarations();
   void SkipScope();
   void SkipCapturedContexts();
   TokenPosition ReadPosition();
@@ -1373,6 +1375,9 @@ class KernelReaderHelper {
   intptr_t GetOffsetForSourceInfo(intptr_t index);
   String& SourceTableUriFor(intptr_t index);
   const String& GetSourceFor(intptr_t index);
+  // Returns the UTF-8 encoded source of the entry at [index] without decoding
+  // it, and sets [size] to its length in bytes.
+  const uint8_t* GetSourceBytesFor(intptr_t index, intptr_t* size);
   TypedDataPtr GetLineStartsFor(intptr_t index);
   String& SourceTableImportUriFor(intptr_t index);
   TypedDataViewPtr GetConstantCoverageFor(intptr_t index);
@@ -0,0 +1,178 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_JIT_COMPILATION_QUEUE_H_
+#define RUNTIME_VM_COMPILER_JIT_COMPILATION_QUEUE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/jit/compiler.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/visitor.h"
+
+namespace dart {
+
+// C-heap allocated background compilation queue element.
+class QueueElement {
+ public:
+  QueueElement(const Function& function, intptr_t osr_id, int32_t priority)
+      : next_(nullptr),
+        function_(function.ptr()),
+        code_(Code::null()),
+        osr_id_(osr_id),
+        priority_(priority),
+        enqueue_micros_(OS::GetCurrentMonotonicMicrosForTimeline()),
+        code_micros_(0) {}
+
+  virtual ~QueueElement() {
+    next_ = nullptr;
+    function_ = Function::null();
+    code_ = Code::null();
+  }
+
+  FunctionPtr Function() const { return function_; }
+
+  void set_next(QueueElement* elem) { next_ = elem; }
+  QueueElement* next() const { return next_; }
+  QueueElement** next_link() { return &next_; }
+
+  ObjectPtr function() const { return function_; }
+  ObjectPtr* function_untag() {
+    return reinterpret_cast<ObjectPtr*>(&function_);
+  }
+
+  // Result of an OSR compilation, and when it was produced.
+  CodePtr code() const { return code_; }
+  void set_code(const Code& code) {
+    code_ = code.ptr();
+    code_micros_ = OS::GetCurrentMonotonicMicros();
+  }
+  int64_t code_micros() const { return code_micros_; }
+  ObjectPtr* code_untag() { return reinterpret_cast<ObjectPtr*>(&code_); }
+
+  intptr_t osr_id() const { return osr_id_; }
+  bool is_osr() const { return osr_id_ != Compiler::kNoOSRDeoptId; }
+
+  int32_t priority() const { return priority_; }
+  void set_priority(int32_t priority) { priority_ = priority; }
+
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
+ private:
+  QueueElement* next_;
+  FunctionPtr function_;
+  CodePtr code_;
+  const intptr_t osr_id_;
+  int32_t priority_;
+  const int64_t enqueue_micros_;
+  int64_t code_micros_;
+
+  DISALLOW_COPY_AND_ASSIGN(QueueElement);
+};
+
+// Allocated in C-heap. Handles both input and output of background compilation.
+// It implements a priority queue, using Peek, Add, Remove operations: elements
+// with higher priority are removed first, elements with equal priority are
+// removed in FIFO order.
+class BackgroundCompilationQueue {
+ public:
+  BackgroundCompilationQueue() : first_(nullptr), length_(0) {}
+  virtual ~BackgroundCompilationQueue() { Clear(); }
+
+  void VisitObjectPointers(ObjectPointerVisitor* visitor) {
+    ASSERT(visitor != nullptr);
+    QueueElement* p = first_;
+    while (p != nullptr) {
+      visitor->VisitPointer(p->function_untag());
+      visitor->VisitPointer(p->code_untag());
+      p = p->next();
+    }
+  }
+
+  bool IsEmpty() const { return first_ == nullptr; }
+  intptr_t Length() const { return length_; }
+
+  void Add(QueueElement* value) {
+    ASSERT(value != nullptr);
+    ASSERT(value->next() == nullptr);
+    QueueElement** link = &first_;
+    while ((*link != nullptr) && ((*link)->priority() >= value->priority())) {
+      link = (*link)->next_link();
+    }
+    value->set_next(*link);
+    *link = value;
+    length_++;
+  }
+
+  QueueElement* Peek() const { return first_; }
+
+  FunctionPtr PeekFunction() const {
+    QueueElement* e = Peek();
+    if (e == nullptr) {
+      return Function::null();
+    } else {
+      return e->Function();
+    }
+  }
+
+  QueueElement* Remove() {
+    ASSERT(first_ != nullptr);
+    QueueElement* result = first_;
+    first_ = first_->next();
+    result->set_next(nullptr);
+    length_--;
+    return result;
+  }
+
+  // Unlinks [value] from the queue, returns false if it was not present.
+  bool Remove(QueueElement* value) {
+    for (QueueElement** link = &first_; *link != nullptr;
+         link = (*link)->next_link()) {
+      if (*link == value) {
+        *link = value->next();
+        value->set_next(nullptr);
+        length_--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  QueueElement* Find(const Object& obj, intptr_t osr_id) const {
+    QueueElement* p = first_;
+    while (p != nullptr) {
+      if ((p->function() == obj.ptr()) && (p->osr_id() == osr_id)) {
+        return p;
+      }
+      p = p->next();
+    }
+    return nullptr;
+  }
+
+  bool ContainsObj(const Object& obj,
+                   intptr_t osr_id = Compiler::kNoOSRDeoptId) const {
+    return Find(obj, osr_id) != nullptr;
+  }
+
+  void Clear() {
+    while (!IsEmpty()) {
+      QueueElement* e = Remove();
+      delete e;
+    }
+    ASSERT((first_ == nullptr) && (length_ == 0));
+  }
+
+ private:
+  QueueElement* first_;
+  intptr_t length_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_JIT_COMPILATION_QUEUE_H_
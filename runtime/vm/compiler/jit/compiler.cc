@@ -25,12 +25,14 @@
 #include "vm/compiler/ffi/callback.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/compilation_queue.h"
 #include "vm/compiler/jit/jit_call_specializer.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
 #include "vm/exceptions.h"
 #include "vm/flags.h"
+#include "vm/json_stream.h"
 #include "vm/kernel.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
@@ -38,6 +40,7 @@
 #include "vm/os.h"
 #include "vm/parser.h"
 #include "vm/runtime_entry.h"
+#include "vm/startup_code_order.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
 #include "vm/timeline.h"
@@ -69,6 +72,14 @@ DEFINE_FLAG(bool,
             stress_test_background_compilation,
             false,
             "Keep background compiler running all the time");
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Maximum number of background compiler threads per isolate group");
+DEFINE_FLAG(bool,
+            background_osr,
+            false,
+            "Compile OSR entries in the background compiler");
 DEFINE_FLAG(bool,
             stop_on_excessive_deoptimization,
             false,
@@ -335,8 +346,8 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
       if (osr_id() == Compiler::kNoOSRDeoptId) {
         function.InstallOptimizedCode(code);
       } else {
-        // OSR is not compiled in background.
-        ASSERT(!Compiler::IsBackgroundCompilation());
+        // OSR code is handed to the frame which requested it (possibly via
+        // BackgroundCompiler::TakeOsrCode) rather than installed.
       }
       ASSERT(code.owner() == function.ptr());
     } else {
@@ -752,6 +763,10 @@ ObjectPtr Compiler::CompileFunction(Thread* thread, const Function& function) {
   TIMELINE_FUNCTION_COMPILATION_DURATION(thread, event_name, function);
 #endif  // defined(SUPPORT_TIMELINE)
 
+  if (!function.WasCompiled() && !IsBackgroundCompilation()) {
+    StartupCodeOrder::RecordFirstExecution(function);
+  }
+
   const bool optimized = function.ForceOptimize();
   return CompileFunctionHelper(function, optimized, kNoOSRDeoptId);
 }
@@ -888,112 +903,8 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
       deopt_id, Object::background_compilation_error());
 }
 
-// C-heap allocated background compilation queue element.
-class QueueElement {
- public:
-  explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
-
-  virtual ~QueueElement() {
-    next_ = nullptr;
-    function_ = Function::null();
-  }
-
-  FunctionPtr Function() const { return function_; }
-
-  void set_next(QueueElement* elem) { next_ = elem; }
-  QueueElement* next() const { return next_; }
-
-  ObjectPtr function() const { return function_; }
-  ObjectPtr* function_untag() {
-    return reinterpret_cast<ObjectPtr*>(&function_);
-  }
-
- private:
-  QueueElement* next_;
-  FunctionPtr function_;
-
-  DISALLOW_COPY_AND_ASSIGN(QueueElement);
-};
-
-// Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
-class BackgroundCompilationQueue {
- public:
-  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
-  virtual ~BackgroundCompilationQueue() { Clear(); }
-
-  void VisitObjectPointers(ObjectPointerVisitor* visitor) {
-    ASSERT(visitor != nullptr);
-    QueueElement* p = first_;
-    while (p != nullptr) {
-      visitor->VisitPointer(p->function_untag());
-      p = p->next();
-    }
-  }
-
-  bool IsEmpty() const { return first_ == nullptr; }
-
-  void Add(QueueElement* value) {
-    ASSERT(value != nullptr);
-    ASSERT(value->next() == nullptr);
-    if (first_ == nullptr) {
-      first_ = value;
-      ASSERT(last_ == nullptr);
-    } else {
-      ASSERT(last_ != nullptr);
-      last_->set_next(value);
-    }
-    last_ = value;
-    ASSERT(first_ != nullptr && last_ != nullptr);
-  }
-
-  QueueElement* Peek() const { return first_; }
-
-  FunctionPtr PeekFunction() const {
-    QueueElement* e = Peek();
-    if (e == nullptr) {
-      return Function::null();
-    } else {
-      return e->Function();
-    }
-  }
-
-  QueueElement* Remove() {
-    ASSERT(first_ != nullptr);
-    QueueElement* result = first_;
-    first_ = first_->next();
-    if (first_ == nullptr) {
-      last_ = nullptr;
-    }
-    return result;
-  }
-
-  bool ContainsObj(const Object& obj) const {
-    QueueElement* p = first_;
-    while (p != nullptr) {
-      if (p->function() == obj.ptr()) {
-        return true;
-      }
-      p = p->next();
-    }
-    return false;
-  }
-
-  void Clear() {
-    while (!IsEmpty()) {
-      QueueElement* e = Remove();
-      delete e;
-    }
-    ASSERT((first_ == nullptr) && (last_ == nullptr));
-  }
-
- private:
-  QueueElement* first_;
-  QueueElement* last_;
-
-  DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
-};
+// OSR results not claimed for this long are dropped.
+static constexpr int64_t kOsrResultLifetimeMicros = kMicrosecondsPerSecond;
 
 class BackgroundCompilerTask : public ThreadPool::Task {
  public:
@@ -1013,13 +924,18 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
     : isolate_group_(isolate_group),
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
+      active_queue_(new BackgroundCompilationQueue()),
+      osr_results_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
+      paused_(false),
+      num_workers_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete function_queue_;
+  delete active_queue_;
+  delete osr_results_;
 }
 
 void BackgroundCompiler::Run() {
@@ -1030,31 +946,67 @@ void BackgroundCompiler::Run() {
     StackZone stack_zone(thread);
     Zone* zone = stack_zone.GetZone();
     Function& function = Function::Handle(zone);
+    Object& result = Object::Handle(zone);
     QueueElement* element = nullptr;
     {
       SafepointMonitorLocker ml(&monitor_);
+      while (running_ && paused_) {
+        ml.Wait();
+      }
       if (running_ && !function_queue()->IsEmpty()) {
         element = function_queue()->Remove();
+        active_queue_->Add(element);
         function ^= element->function();
+        RecordQueueLength();
       }
     }
     if (element != nullptr) {
-      delete element;
-      Compiler::CompileOptimizedFunction(thread, function,
-                                         Compiler::kNoOSRDeoptId);
+      ReportQueueLength();
+      const intptr_t osr_id = element->osr_id();
+      const int64_t enqueue_micros = element->enqueue_micros();
+      result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
-      if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
-          FLAG_stress_test_background_compilation) {
-        if (Compiler::CanOptimizeFunction(thread, function)) {
-          SafepointMonitorLocker ml(&monitor_);
-          if (running_) {
-            QueueElement* repeat_qelem = new QueueElement(function);
-            function_queue()->Add(repeat_qelem);
+      const bool retry =
+          (osr_id == Compiler::kNoOSRDeoptId) &&
+          ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
+           FLAG_stress_test_background_compilation) &&
+          Compiler::CanOptimizeFunction(thread, function);
+
+      bool optimized = false;
+      bool requeued = false;
+      {
+        SafepointMonitorLocker ml(&monitor_);
+        active_queue_->Remove(element);
+        if (element->is_osr()) {
+          if (result.IsCode() && running_) {
+            optimized = true;
+            num_osr_compilations_.fetch_add(1);
+            element->set_code(Code::Cast(result));
+            PruneOsrResultsLocked();
+            osr_results_->Add(element);
+            element = nullptr;
           }
+        } else {
+          optimized = function.HasOptimizedCode();
+        }
+        delete element;
+
+        if (retry && running_ && !function_queue()->ContainsObj(function)) {
+          QueueElement* repeat_qelem = new QueueElement(
+              function, Compiler::kNoOSRDeoptId, function.usage_counter());
+          function_queue()->Add(repeat_qelem);
+          RecordQueueLength();
+          requeued = true;
         }
       }
+      if (optimized) {
+        RecordTimeToOptimize(enqueue_micros);
+      }
+      if (requeued) {
+        ReportQueueLength();
+      }
     }
   }
   Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/false);
@@ -1064,49 +1016,201 @@ void BackgroundCompiler::Run() {
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
     } else {
-      // Background compiler done. This notification must happen after the
-      // thread leaves to group to avoid a shutdown race with the thread
-      // registry.
-      running_ = false;
-      done_ = true;
+      // Worker done. The last one to leave stops the background compiler.
+      // This notification must happen after the thread leaves to group to
+      // avoid a shutdown race with the thread registry.
+      num_workers_--;
+      ASSERT(num_workers_ >= 0);
+      if (num_workers_ == 0) {
+        running_ = false;
+      }
       ml.NotifyAll();
     }
   }
 }
 
-bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
+bool BackgroundCompiler::StartWorkerLocked() {
+  // If we ever wanted to run the BG compiler on the
+  // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
+  // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
+  // notification would not work anymore.
+  if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    return false;
+  }
+  num_workers_++;
+  return true;
+}
+
+bool BackgroundCompiler::EnqueueCompilation(const Function& function,
+                                            intptr_t osr_id) {
   Thread* thread = Thread::Current();
   ASSERT(thread->IsDartMutatorThread());
   ASSERT(thread->CanAcquireSafepointLocks());
 
-  SafepointMonitorLocker ml(&monitor_);
-  if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
-    running_ = true;
-    done_ = false;
-    // If we ever wanted to run the BG compiler on the
-    // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
-    // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
-    // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+  {
+    SafepointMonitorLocker ml(&monitor_);
+    if (disabled_depth_ > 0) return false;
+    if (!running_) {
+      // Wait for the workers of a previous stop to leave before restarting.
+      if (num_workers_ > 0) return false;
+      running_ = true;
+    }
+    if (num_workers_ == 0 && !StartWorkerLocked()) {
       running_ = false;
-      done_ = true;
       return false;
     }
+
+    ASSERT(running_);
+    PruneOsrResultsLocked();
+    if (active_queue_->ContainsObj(function, osr_id)) {
+      return true;
+    }
+    const int32_t priority = function.usage_counter();
+    QueueElement* elem = function_queue()->Find(function, osr_id);
+    if (elem != nullptr) {
+      // Requested again: the function got hotter, move it forward.
+      if (elem->priority() < priority) {
+        function_queue()->Remove(elem);
+        elem->set_priority(priority);
+        function_queue()->Add(elem);
+      }
+      return true;
+    }
+    elem = new QueueElement(function, osr_id, priority);
+    function_queue()->Add(elem);
+    RecordQueueLength();
+    // Scale out while there is more pending work than workers.
+    if ((num_workers_ < FLAG_background_compiler_threads) &&
+        (function_queue()->Length() > num_workers_)) {
+      StartWorkerLocked();
+    }
+    ml.NotifyAll();
   }
+  ReportQueueLength();
+  return true;
+}
 
-  ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
-    return true;
+CodePtr BackgroundCompiler::TakeOsrCode(const Function& function,
+                                        intptr_t osr_id) {
+  Thread* thread = Thread::Current();
+  ASSERT(thread->IsDartMutatorThread());
+
+  Code& code = Code::Handle(thread->zone());
+  {
+    SafepointMonitorLocker ml(&monitor_);
+    PruneOsrResultsLocked();
+    QueueElement* elem = osr_results_->Find(function, osr_id);
+    if (elem == nullptr) {
+      return Code::null();
+    }
+    osr_results_->Remove(elem);
+    code = elem->code();
+    delete elem;
   }
-  QueueElement* elem = new QueueElement(function);
-  function_queue()->Add(elem);
+  // The code may have been invalidated by a CHA or field guard change since it
+  // was compiled.
+  if (code.IsDisabled() || !Compiler::CanOptimizeFunction(thread, function)) {
+    return Code::null();
+  }
+  return code.ptr();
+}
+
+intptr_t BackgroundCompiler::osr_results_length() {
+  SafepointMonitorLocker ml(&monitor_);
+  return osr_results_->Length();
+}
+
+void BackgroundCompiler::SetPausedForTesting(bool paused) {
+  SafepointMonitorLocker ml(&monitor_);
+  paused_ = paused;
   ml.NotifyAll();
-  return true;
 }
 
+void BackgroundCompiler::PruneOsrResultsLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (osr_results_->IsEmpty()) return;
+  // The mutator polls for the result while it keeps running the loop, so a
+  // result that was not claimed for a while belongs to a loop that was left.
+  const int64_t min_code_micros =
+      OS::GetCurrentMonotonicMicros() - kOsrResultLifetimeMicros;
+  Zone* zone = Thread::Current()->zone();
+  Function& function = Function::Handle(zone);
+  Code& code = Code::Handle(zone);
+  QueueElement* elem = osr_results_->Peek();
+  while (elem != nullptr) {
+    QueueElement* next = elem->next();
+    function = elem->Function();
+    code = elem->code();
+    if ((elem->code_micros() < min_code_micros) || code.IsDisabled() ||
+        function.HasOptimizedCode()) {
+      osr_results_->Remove(elem);
+      delete elem;
+    }
+    elem = next;
+  }
+}
+
+void BackgroundCompiler::RecordQueueLength() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  queue_length_ = function_queue_->Length();
+}
+
+void BackgroundCompiler::ReportQueueLength() {
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetCompilerStream()->StartEvent();
+  if (event != nullptr) {
+    event->Counter("BackgroundCompilerQueue");
+    event->SetNumArguments(2);
+    event->FormatArgument(0, "queueLength", "%" Pd, queue_length_.load());
+    event->FormatArgument(1, "activeWorkers", "%" Pd, num_workers_.load());
+    event->Complete();
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+void BackgroundCompiler::RecordTimeToOptimize(int64_t enqueue_micros) {
+  const int64_t now = OS::GetCurrentMonotonicMicrosForTimeline();
+  const int64_t time_to_optimize = now - enqueue_micros;
+  num_compilations_.fetch_add(1);
+  total_time_to_optimize_micros_.fetch_add(time_to_optimize);
+  // Several workers may finish at the same time.
+  int64_t max = max_time_to_optimize_micros_.load();
+  while ((time_to_optimize > max) &&
+         !max_time_to_optimize_micros_.compare_exchange_weak(
+             max, time_to_optimize)) {
+  }
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetCompilerStream()->StartEvent();
+  if (event != nullptr) {
+    event->Duration("BackgroundCompilerTimeToOptimize", enqueue_micros, now);
+    event->Complete();
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+#ifndef PRODUCT
+void BackgroundCompiler::PrintJSON(JSONObject* jsobj) const {
+  JSONObject bg(jsobj, "_backgroundCompiler");
+  bg.AddProperty("type", "_BackgroundCompiler");
+  bg.AddProperty("maxWorkers",
+                 static_cast<intptr_t>(FLAG_background_compiler_threads));
+  bg.AddProperty("activeWorkers", num_workers_.load());
+  bg.AddProperty("queueLength", queue_length_.load());
+  const intptr_t compilations = num_compilations_;
+  bg.AddProperty("compilations", compilations);
+  bg.AddProperty("osrCompilations", num_osr_compilations_.load());
+  bg.AddProperty64("averageTimeToOptimizeMicros",
+                   compilations == 0
+                       ? 0
+                       : total_time_to_optimize_micros_ / compilations);
+  bg.AddProperty64("maxTimeToOptimizeMicros", max_time_to_optimize_micros_);
+}
+#endif  // !PRODUCT
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  active_queue_->VisitObjectPointers(visitor);
+  osr_results_->VisitObjectPointers(visitor);
 }
 
 void BackgroundCompiler::Stop() {
@@ -1114,17 +1218,25 @@ void BackgroundCompiler::Stop() {
   ASSERT(thread->isolate() == nullptr || !thread->BypassSafepoints());
   ASSERT(thread->CanAcquireSafepointLocks());
 
-  SafepointMonitorLocker ml(&monitor_);
-  StopLocked(thread, &ml);
+  {
+    SafepointMonitorLocker ml(&monitor_);
+    StopLocked(thread, &ml);
+  }
+  ReportQueueLength();
 }
 
 void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  osr_results_->Clear();
+  RecordQueueLength();
+  // Wake up paused workers, so they can leave.
+  locker->NotifyAll();
+  while (num_workers_ > 0) {
     locker->Wait();
   }
+  ASSERT(active_queue_->IsEmpty());
 }
 
 void BackgroundCompiler::Enable() {
@@ -1144,10 +1256,13 @@ void BackgroundCompiler::Disable() {
   ASSERT(!thread->BypassSafepoints());
   ASSERT(thread->CanAcquireSafepointLocks());
 
-  SafepointMonitorLocker ml(&monitor_);
-  disabled_depth_++;
-  if (done_) return;
-  StopLocked(thread, &ml);
+  {
+    SafepointMonitorLocker ml(&monitor_);
+    disabled_depth_++;
+    if (num_workers_ == 0) return;
+    StopLocked(thread, &ml);
+  }
+  ReportQueueLength();
 }
 
 #else  // DART_PRECOMPILED_RUNTIME
@@ -1192,11 +1307,18 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
   UNREACHABLE();
 }
 
-bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
+bool BackgroundCompiler::EnqueueCompilation(const Function& function,
+                                            intptr_t osr_id) {
   UNREACHABLE();
   return false;
 }
 
+CodePtr BackgroundCompiler::TakeOsrCode(const Function& function,
+                                        intptr_t osr_id) {
+  UNREACHABLE();
+  return Code::null();
+}
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   UNREACHABLE();
 }
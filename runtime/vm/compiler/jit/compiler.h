@@ -21,6 +21,7 @@ class CompilationWorkQueue;
 class FlowGraph;
 class Function;
 class IndirectGotoInstr;
+class JSONObject;
 class Library;
 class ParsedFunction;
 class QueueElement;
@@ -82,10 +83,11 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
-// No OSR compilation in the background compiler.
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background_compiler_threads tasks per
+// isolate group pull functions from a queue ordered by hotness (usage counter
+// at the time of the request). The tasks die with the owning isolate group.
+// OSR compilation is done in the background only with --background_osr.
 class BackgroundCompiler {
  public:
   explicit BackgroundCompiler(IsolateGroup* isolate_group);
@@ -95,16 +97,43 @@ class BackgroundCompiler {
     isolate_group->background_compiler()->Stop();
   }
 
-  // Enqueues a function to be compiled in the background.
+  // Enqueues a function to be compiled in the background. If [osr_id] is
+  // not [Compiler::kNoOSRDeoptId] an OSR entry is compiled and the result
+  // can be retrieved with [TakeOsrCode].
   //
   // Return `true` if successful.
-  bool EnqueueCompilation(const Function& function);
+  bool EnqueueCompilation(const Function& function,
+                          intptr_t osr_id = Compiler::kNoOSRDeoptId);
+
+  // Returns OSR code for [function] at [osr_id] produced by a previously
+  // enqueued background OSR compilation and forgets about it. Returns
+  // Code::null() if no valid code is available (yet).
+  //
+  // Results are also forgotten when they are not claimed in time, when the
+  // function got optimized code installed or when the result was invalidated.
+  CodePtr TakeOsrCode(const Function& function, intptr_t osr_id);
 
   void VisitPointers(ObjectPointerVisitor* visitor);
 
   BackgroundCompilationQueue* function_queue() const { return function_queue_; }
   bool is_running() const { return running_; }
 
+  // Number of functions waiting to be compiled.
+  intptr_t queue_length() const { return queue_length_; }
+
+  // Number of finished OSR compilations.
+  intptr_t osr_compilations() const { return num_osr_compilations_; }
+
+  // Number of OSR compilation results waiting to be claimed.
+  intptr_t osr_results_length();
+
+  // While paused, workers do not take functions from the queue.
+  void SetPausedForTesting(bool paused);
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj) const;
+#endif  // !PRODUCT
+
   void Run();
 
  private:
@@ -114,16 +143,42 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return num_workers_ > 0; }
+
+  // Schedules one more task on the thread pool. Requires [monitor_].
+  bool StartWorkerLocked();
+  // Drops stale OSR results. Requires [monitor_].
+  void PruneOsrResultsLocked();
+
+  // Updates the queue length statistic. Requires [monitor_].
+  void RecordQueueLength();
+  // These emit timeline events, so they must not be called while holding
+  // [monitor_].
+  void ReportQueueLength();
+  void RecordTimeToOptimize(int64_t enqueue_micros);
 
   IsolateGroup* isolate_group_;
 
-  Monitor monitor_;  // Controls access to the queue and running state.
+  Monitor monitor_;  // Controls access to the queues and running state.
   BackgroundCompilationQueue* function_queue_;
+  // Elements taken from [function_queue_] which are being compiled.
+  BackgroundCompilationQueue* active_queue_;
+  // Finished background OSR compilations waiting to be picked up.
+  BackgroundCompilationQueue* osr_results_;
   bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  bool paused_;   // While true, workers wait before reading the queue.
+  // Number of tasks scheduled or running. Only changed while holding
+  // [monitor_].
+  RelaxedAtomic<intptr_t> num_workers_;
   int16_t disabled_depth_;
 
+  // Statistics, readable without holding [monitor_].
+  RelaxedAtomic<intptr_t> queue_length_ = {0};
+  RelaxedAtomic<intptr_t> num_compilations_ = {0};
+  RelaxedAtomic<intptr_t> num_osr_compilations_ = {0};
+  RelaxedAtomic<int64_t> total_time_to_optimize_micros_ = {0};
+  RelaxedAtomic<int64_t> max_time_to_optimize_micros_ = {0};
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
 };
 
@@ -793,7 +793,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -1617,7 +1617,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -2428,7 +2428,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -3254,7 +3254,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -4074,7 +4074,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -4896,7 +4896,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -5709,7 +5709,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -6534,7 +6534,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -7338,7 +7338,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -8154,7 +8154,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -8957,7 +8957,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -9775,7 +9775,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -10587,7 +10587,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -11401,7 +11401,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -12206,7 +12206,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -13023,7 +13023,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -13918,7 +13918,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -14828,7 +14828,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -15746,7 +15746,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -16658,7 +16658,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -17572,7 +17572,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -18478,7 +18478,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -19389,7 +19389,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -20285,7 +20285,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -21186,7 +21186,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -22095,7 +22095,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -22998,7 +22998,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -23903,7 +23903,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -24800,7 +24800,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -25702,7 +25702,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -7,6 +7,7 @@
 #include "platform/thread_sanitizer.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler/jit/compilation_queue.h"
 #include "vm/dart_api_impl.h"
 #include "vm/heap/safepoint.h"
 #include "vm/kernel_isolate.h"
@@ -17,6 +18,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -101,6 +104,277 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(BackgroundCompilationQueue_HottestFirst) {
+  const Function& function = Function::Handle();
+  BackgroundCompilationQueue queue;
+  QueueElement* cold = new QueueElement(function, Compiler::kNoOSRDeoptId, 10);
+  QueueElement* hot = new QueueElement(function, Compiler::kNoOSRDeoptId, 300);
+  QueueElement* warm = new QueueElement(function, Compiler::kNoOSRDeoptId, 100);
+  QueueElement* hot_osr = new QueueElement(function, /*osr_id=*/1, 300);
+  queue.Add(cold);
+  queue.Add(hot);
+  queue.Add(warm);
+  queue.Add(hot_osr);
+  EXPECT_EQ(4, queue.Length());
+
+  // The cold function was requested again after it got hotter.
+  EXPECT(queue.Remove(cold));
+  cold->set_priority(200);
+  queue.Add(cold);
+  EXPECT_EQ(4, queue.Length());
+
+  // Hotter elements first, equally hot elements in the order they were added.
+  EXPECT_EQ(hot, queue.Peek());
+  EXPECT_EQ(hot, queue.Remove());
+  EXPECT_EQ(hot_osr, queue.Remove());
+  EXPECT_EQ(cold, queue.Remove());
+  EXPECT_EQ(warm, queue.Remove());
+  EXPECT(queue.IsEmpty());
+  delete cold;
+  delete hot;
+  delete warm;
+  delete hot_osr;
+}
+
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnMultipleHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo0() { return 0; }\n"
+      "  static foo1() { return 1; }\n"
+      "  static foo2() { return 2; }\n"
+      "  static foo3() { return 3; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+
+  SetFlagScope<int> sfs(&FLAG_background_compiler_threads, 3);
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t kNumFunctions = 4;
+  const Function* functions[kNumFunctions];
+  auto isolate_group = thread->isolate_group();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    const String& name = String::Handle(String::NewFormatted("foo%" Pd, i));
+    Function& func = Function::ZoneHandle(cls.LookupStaticFunction(name));
+    EXPECT(!func.IsNull());
+    CompilerTest::TestCompileFunction(func);
+    EXPECT(func.HasCode());
+    EXPECT(!func.HasOptimizedCode());
+    func.SetUsageCounter(i * 100);
+    functions[i] = &func;
+  }
+  BackgroundCompiler* background_compiler =
+      isolate_group->background_compiler();
+  // Queue all functions before the workers start taking them.
+  background_compiler->SetPausedForTesting(true);
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    EXPECT(background_compiler->EnqueueCompilation(*functions[i]));
+  }
+  background_compiler->SetPausedForTesting(false);
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      while (!functions[i]->HasOptimizedCode()) {
+        // The three hottest functions are taken first, so the coldest one is
+        // only compiled after one of them is done.
+        if (functions[0]->HasOptimizedCode()) {
+          EXPECT(functions[1]->HasOptimizedCode() ||
+                 functions[2]->HasOptimizedCode() ||
+                 functions[3]->HasOptimizedCode());
+        }
+        ml.Wait(1);
+      }
+    }
+  }
+  delete m;
+  EXPECT_EQ(0, background_compiler->queue_length());
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompiler_HottestFirst) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo0() { return 0; }\n"
+      "  static foo1() { return 1; }\n"
+      "  static foo2() { return 2; }\n"
+      "  static foo3() { return 3; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+
+  SetFlagScope<int> sfs(&FLAG_background_compiler_threads, 1);
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t kNumFunctions = 4;
+  const Function* functions[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    const String& name = String::Handle(String::NewFormatted("foo%" Pd, i));
+    Function& func = Function::ZoneHandle(cls.LookupStaticFunction(name));
+    EXPECT(!func.IsNull());
+    CompilerTest::TestCompileFunction(func);
+    EXPECT(!func.HasOptimizedCode());
+    func.SetUsageCounter(i * 100);
+    functions[i] = &func;
+  }
+  BackgroundCompiler* background_compiler =
+      thread->isolate_group()->background_compiler();
+  background_compiler->SetPausedForTesting(true);
+  // Enqueued from the coldest to the hottest.
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    EXPECT(background_compiler->EnqueueCompilation(*functions[i]));
+  }
+  EXPECT_EQ(kNumFunctions, background_compiler->queue_length());
+  background_compiler->SetPausedForTesting(false);
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    while (!functions[0]->HasOptimizedCode()) {
+      // The only worker compiles the functions one by one, so a function
+      // only has optimized code once all hotter functions have it.
+      for (intptr_t i = 0; i < kNumFunctions - 1; i++) {
+        if (functions[i]->HasOptimizedCode()) {
+          EXPECT(functions[i + 1]->HasOptimizedCode());
+        }
+      }
+      ml.Wait(1);
+    }
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      EXPECT(functions[i]->HasOptimizedCode());
+    }
+  }
+  delete m;
+}
+
+// Returns the deopt id of the first OSR entry of the unoptimized code of
+// [function].
+static intptr_t FirstOsrId(const Function& function) {
+  const Code& code = Code::Handle(function.unoptimized_code());
+  const PcDescriptors& descriptors =
+      PcDescriptors::Handle(code.pc_descriptors());
+  PcDescriptors::Iterator iter(descriptors, UntaggedPcDescriptors::kOsrEntry);
+  EXPECT(iter.MoveNext());
+  return iter.DeoptId();
+}
+
+static FunctionPtr CompileLoopFunction(Thread* thread) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static loop(n) {\n"
+      "    var sum = 0;\n"
+      "    for (var i = 0; i < n; i++) {\n"
+      "      sum += i;\n"
+      "    }\n"
+      "    return sum;\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  Function& func = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("loop"))));
+  EXPECT(!func.IsNull());
+  CompilerTest::TestCompileFunction(func);
+  EXPECT(func.HasCode());
+  EXPECT(!func.HasOptimizedCode());
+  return func.ptr();
+}
+
+// Waits until the background compiler finished [count] OSR compilations.
+static void WaitForOsrCompilations(BackgroundCompiler* background_compiler,
+                                   intptr_t count) {
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    while (background_compiler->osr_compilations() < count) {
+      ml.Wait(1);
+    }
+  }
+  delete m;
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompiler_OsrCompilation) {
+  const Function& func = Function::Handle(CompileLoopFunction(thread));
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  BackgroundCompiler* background_compiler =
+      thread->isolate_group()->background_compiler();
+  const intptr_t osr_id = FirstOsrId(func);
+  const intptr_t compilations = background_compiler->osr_compilations();
+  EXPECT(background_compiler->EnqueueCompilation(func, osr_id));
+  WaitForOsrCompilations(background_compiler, compilations + 1);
+
+  // Claimed only once, and never installed as the function's code.
+  const Code& code =
+      Code::Handle(background_compiler->TakeOsrCode(func, osr_id));
+  EXPECT(!code.IsNull());
+  EXPECT(code.is_optimized());
+  EXPECT(!func.HasOptimizedCode());
+  EXPECT(background_compiler->TakeOsrCode(func, osr_id) == Code::null());
+  EXPECT_EQ(0, background_compiler->osr_results_length());
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompiler_DropsUnclaimedOsrCode) {
+  const Function& func = Function::Handle(CompileLoopFunction(thread));
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  BackgroundCompiler* background_compiler =
+      thread->isolate_group()->background_compiler();
+  const intptr_t osr_id = FirstOsrId(func);
+  const intptr_t compilations = background_compiler->osr_compilations();
+  EXPECT(background_compiler->EnqueueCompilation(func, osr_id));
+  WaitForOsrCompilations(background_compiler, compilations + 1);
+  EXPECT_EQ(1, background_compiler->osr_results_length());
+
+  // Once the function has optimized code installed, the OSR code is no
+  // longer needed.
+  const Object& result =
+      Object::Handle(Compiler::CompileOptimizedFunction(thread, func));
+  EXPECT(result.IsCode());
+  EXPECT(func.HasOptimizedCode());
+  EXPECT(background_compiler->TakeOsrCode(func, osr_id) == Code::null());
+  EXPECT_EQ(0, background_compiler->osr_results_length());
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
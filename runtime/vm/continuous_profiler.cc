@@ -0,0 +1,572 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/continuous_profiler.h"
+
+#include "platform/utils.h"
+#include "vm/dart.h"
+#include "vm/datastream.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/isolate.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
+#include "vm/profiler.h"
+#include "vm/profiler_service.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+#if defined(DART_INCLUDE_PROFILER)
+
+DEFINE_FLAG(charp,
+            continuous_profile_dir,
+            nullptr,
+            "Continuously profile all isolates and periodically write the "
+            "profiles in the pprof format to the given directory. The samples "
+            "are consumed, so getCpuSamples and DevTools see none of them.");
+DEFINE_FLAG(int,
+            continuous_profile_period,
+            60,
+            "Number of seconds covered by each continuous profile.");
+DEFINE_FLAG(int,
+            continuous_profile_cpu_budget,
+            1,
+            "Percentage of one core the continuous profiler may use to "
+            "process samples.");
+
+// Field numbers of the messages in profile.proto.
+static constexpr intptr_t kProfileSampleType = 1;
+static constexpr intptr_t kProfileSample = 2;
+static constexpr intptr_t kProfileLocation = 4;
+static constexpr intptr_t kProfileFunction = 5;
+static constexpr intptr_t kProfileStringTable = 6;
+static constexpr intptr_t kProfileTimeNanos = 9;
+static constexpr intptr_t kProfileDurationNanos = 10;
+static constexpr intptr_t kProfilePeriodType = 11;
+static constexpr intptr_t kProfilePeriod = 12;
+static constexpr intptr_t kValueTypeType = 1;
+static constexpr intptr_t kValueTypeUnit = 2;
+static constexpr intptr_t kSampleLocationId = 1;
+static constexpr intptr_t kSampleValue = 2;
+static constexpr intptr_t kLocationId = 1;
+static constexpr intptr_t kLocationLine = 4;
+static constexpr intptr_t kLineFunctionId = 1;
+static constexpr intptr_t kLineLine = 2;
+static constexpr intptr_t kFunctionId = 1;
+static constexpr intptr_t kFunctionName = 2;
+static constexpr intptr_t kFunctionSystemName = 3;
+static constexpr intptr_t kFunctionFilename = 4;
+
+static constexpr intptr_t kWireTypeVarint = 0;
+static constexpr intptr_t kWireTypeLengthDelimited = 2;
+
+// Strings interned by the constructor, in this order after the empty string.
+static constexpr intptr_t kSamplesString = 1;
+static constexpr intptr_t kCountString = 2;
+static constexpr intptr_t kCpuString = 3;
+static constexpr intptr_t kNanosecondsString = 4;
+
+static void WriteTag(MallocWriteStream* stream,
+                     intptr_t field,
+                     intptr_t wire_type) {
+  stream->WriteLEB128<uint64_t>((field << 3) | wire_type);
+}
+
+static void WriteVarint(MallocWriteStream* stream,
+                        intptr_t field,
+                        uint64_t value) {
+  WriteTag(stream, field, kWireTypeVarint);
+  stream->WriteLEB128<uint64_t>(value);
+}
+
+static void WriteLengthDelimited(MallocWriteStream* stream,
+                                 intptr_t field,
+                                 const void* data,
+                                 intptr_t length) {
+  WriteTag(stream, field, kWireTypeLengthDelimited);
+  stream->WriteLEB128<uint64_t>(length);
+  stream->WriteBytes(data, length);
+}
+
+static void WriteMessage(MallocWriteStream* stream,
+                         intptr_t field,
+                         const MallocWriteStream& message) {
+  WriteLengthDelimited(stream, field, message.buffer(),
+                       message.bytes_written());
+}
+
+uword PprofProfileBuilder::Location::Hash() const {
+  uint32_t hash = CombineHashes(function, url);
+  return FinalizeHash(CombineHashes(hash, line));
+}
+
+bool PprofProfileBuilder::Location::Equals(const Location& other) const {
+  return (function == other.function) && (url == other.url) &&
+         (line == other.line);
+}
+
+uword PprofProfileBuilder::Stack::Hash() const {
+  uint32_t hash = length;
+  for (intptr_t i = 0; i < length; i++) {
+    hash = CombineHashes(hash, locations[i]);
+  }
+  return FinalizeHash(hash);
+}
+
+bool PprofProfileBuilder::Stack::Equals(const Stack& other) const {
+  return (length == other.length) &&
+         (memcmp(locations, other.locations, length * sizeof(uint64_t)) == 0);
+}
+
+PprofProfileBuilder::PprofProfileBuilder(int64_t period_nanos)
+    : period_nanos_(period_nanos) {
+  char* empty = Utils::StrDup("");
+  strings_.Add(empty);
+  string_ids_.Insert({empty, 0});
+  Intern("samples");
+  Intern("count");
+  Intern("cpu");
+  Intern("nanoseconds");
+  ASSERT(strings_.length() == kNanosecondsString + 1);
+}
+
+PprofProfileBuilder::~PprofProfileBuilder() {
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    free(strings_[i]);
+  }
+  for (intptr_t i = 0; i < locations_.length(); i++) {
+    delete locations_[i];
+  }
+  for (intptr_t i = 0; i < stacks_.length(); i++) {
+    free(stacks_[i]->locations);
+    delete stacks_[i];
+  }
+}
+
+intptr_t PprofProfileBuilder::Intern(const char* str) {
+  if (str == nullptr) return 0;
+  const intptr_t id = string_ids_.LookupValue(str);
+  if (id != CStringIntMapKeyValueTrait::kNoValue) return id;
+  char* copy = Utils::StrDup(str);
+  strings_.Add(copy);
+  string_ids_.Insert({copy, strings_.length() - 1});
+  return strings_.length() - 1;
+}
+
+uint64_t PprofProfileBuilder::LocationFor(const char* function,
+                                          const char* url,
+                                          intptr_t line) {
+  Location key = {Intern(function), Intern(url), line, 0};
+  Location* location = location_ids_.LookupValue(&key);
+  if (location != nullptr) return location->id;
+  location = new Location(key);
+  // Ids must be non-zero.
+  location->id = locations_.length() + 1;
+  locations_.Add(location);
+  location_ids_.Insert(location);
+  return location->id;
+}
+
+void PprofProfileBuilder::AddSample(const uint64_t* locations,
+                                    intptr_t length) {
+  sample_count_++;
+  Stack key = {const_cast<uint64_t*>(locations), length, 0};
+  Stack* stack = stack_ids_.LookupValue(&key);
+  if (stack != nullptr) {
+    stack->count++;
+    return;
+  }
+  stack = new Stack();
+  stack->locations =
+      reinterpret_cast<uint64_t*>(malloc(length * sizeof(uint64_t)));
+  memmove(stack->locations, locations, length * sizeof(uint64_t));
+  stack->length = length;
+  stack->count = 1;
+  stacks_.Add(stack);
+  stack_ids_.Insert(stack);
+}
+
+uint8_t* PprofProfileBuilder::Serialize(int64_t start_micros,
+                                        int64_t duration_micros,
+                                        intptr_t* length) const {
+  MallocWriteStream stream(64 * KB);
+  MallocWriteStream message(KB);
+  MallocWriteStream nested(KB);
+
+  // sample_type: [samples/count, cpu/nanoseconds].
+  message.SetPosition(0);
+  WriteVarint(&message, kValueTypeType, kSamplesString);
+  WriteVarint(&message, kValueTypeUnit, kCountString);
+  WriteMessage(&stream, kProfileSampleType, message);
+  message.SetPosition(0);
+  WriteVarint(&message, kValueTypeType, kCpuString);
+  WriteVarint(&message, kValueTypeUnit, kNanosecondsString);
+  WriteMessage(&stream, kProfileSampleType, message);
+
+  for (intptr_t i = 0; i < stacks_.length(); i++) {
+    const Stack* stack = stacks_[i];
+    message.SetPosition(0);
+    nested.SetPosition(0);
+    for (intptr_t j = 0; j < stack->length; j++) {
+      nested.WriteLEB128<uint64_t>(stack->locations[j]);
+    }
+    WriteMessage(&message, kSampleLocationId, nested);
+    nested.SetPosition(0);
+    nested.WriteLEB128<uint64_t>(stack->count);
+    nested.WriteLEB128<uint64_t>(stack->count * period_nanos_);
+    WriteMessage(&message, kSampleValue, nested);
+    WriteMessage(&stream, kProfileSample, message);
+  }
+
+  for (intptr_t i = 0; i < locations_.length(); i++) {
+    const Location* location = locations_[i];
+    message.SetPosition(0);
+    WriteVarint(&message, kLocationId, location->id);
+    nested.SetPosition(0);
+    WriteVarint(&nested, kLineFunctionId, location->id);
+    if (location->line >= 0) {
+      WriteVarint(&nested, kLineLine, location->line);
+    }
+    WriteMessage(&message, kLocationLine, nested);
+    WriteMessage(&stream, kProfileLocation, message);
+  }
+
+  // Every location has a function of its own with the same id.
+  for (intptr_t i = 0; i < locations_.length(); i++) {
+    const Location* location = locations_[i];
+    message.SetPosition(0);
+    WriteVarint(&message, kFunctionId, location->id);
+    WriteVarint(&message, kFunctionName, location->function);
+    WriteVarint(&message, kFunctionSystemName, location->function);
+    if (location->url != 0) {
+      WriteVarint(&message, kFunctionFilename, location->url);
+    }
+    WriteMessage(&stream, kProfileFunction, message);
+  }
+
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    WriteLengthDelimited(&stream, kProfileStringTable, strings_[i],
+                         strlen(strings_[i]));
+  }
+
+  WriteVarint(&stream, kProfileTimeNanos,
+              start_micros * kNanosecondsPerMicrosecond);
+  WriteVarint(&stream, kProfileDurationNanos,
+              duration_micros * kNanosecondsPerMicrosecond);
+  message.SetPosition(0);
+  WriteVarint(&message, kValueTypeType, kCpuString);
+  WriteVarint(&message, kValueTypeUnit, kNanosecondsString);
+  WriteMessage(&stream, kProfilePeriodType, message);
+  WriteVarint(&stream, kProfilePeriod, period_nanos_);
+
+  return stream.Steal(length);
+}
+
+Dart_ContinuousProfileCallback ContinuousProfiler::callback_ = nullptr;
+
+// Guards [builder] and [profile_start_micros], which are updated both by the
+// profiler thread and by isolates shutting down.
+static Mutex* builder_mutex = new Mutex();
+static PprofProfileBuilder* builder = nullptr;
+static int64_t profile_start_micros = 0;
+static intptr_t profile_sequence = 0;
+
+static Monitor* monitor = new Monitor();
+static bool shutting_down = true;
+static bool thread_running = false;
+static ThreadJoinId thread_id = OSThread::kInvalidThreadJoinId;
+
+// Samples are taken from the sample buffer at least this often, so blocks are
+// not reused before they have been processed.
+static constexpr int64_t kDrainIntervalMicros = 1000 * 1000;
+
+bool ContinuousProfiler::IsEnabled() {
+  return (FLAG_continuous_profile_dir != nullptr) || (callback_ != nullptr);
+}
+
+void ContinuousProfiler::Startup() {
+  if (!IsEnabled()) return;
+  if (!Profiler::IsRunning()) {
+    Profiler::Config config = Profiler::CurrentConfig();
+    config.enabled = true;
+    Profiler::SetConfig(config);
+  }
+  {
+    MutexLocker ml(builder_mutex);
+    builder = new PprofProfileBuilder(Profiler::CurrentConfig().period_us *
+                                      kNanosecondsPerMicrosecond);
+    profile_start_micros = OS::GetCurrentTimeMicros();
+  }
+
+  MonitorLocker startup_ml(monitor);
+  shutting_down = false;
+  OSThread::Start("Dart Continuous Profiler", ThreadMain, 0);
+  while (!thread_running) {
+    startup_ml.Wait();
+  }
+}
+
+void ContinuousProfiler::Shutdown() {
+  {
+    MonitorLocker shutdown_ml(monitor);
+    if (shutting_down) return;
+    shutting_down = true;
+    shutdown_ml.Notify();
+  }
+  ASSERT(thread_id != OSThread::kInvalidThreadJoinId);
+  OSThread::Join(thread_id);
+  thread_id = OSThread::kInvalidThreadJoinId;
+  ASSERT(!thread_running);
+
+  // Isolates have already drained their remaining samples on shutdown.
+  WriteProfile();
+  MutexLocker ml(builder_mutex);
+  delete builder;
+  builder = nullptr;
+}
+
+void ContinuousProfiler::IsolateShutdown(Isolate* isolate) {
+  if (!IsEnabled()) return;
+  DrainSamples(isolate);
+}
+
+namespace {
+
+// A symbolized frame. Its location is assigned when the samples are added to
+// the profile.
+struct Frame : public ZoneObject {
+  const char* function = nullptr;
+  const char* url = nullptr;
+  intptr_t line = -1;
+  uint64_t location = 0;
+};
+
+}  // namespace
+
+static intptr_t LineOf(const Function& function) {
+  if (function.IsNull()) return -1;
+  const Script& script = Script::Handle(function.script());
+  intptr_t line = -1;
+  if (script.IsNull() ||
+      !script.GetTokenLocation(function.token_pos(), &line)) {
+    return -1;
+  }
+  return line;
+}
+
+static Frame* FrameOf(ProfileFunction* function) {
+  Frame* frame = new Frame();
+  frame->function = function->Name();
+  frame->url = function->ResolvedScriptUrl();
+  frame->line = LineOf(*function->function());
+  return frame;
+}
+
+void ContinuousProfiler::DrainSamples(Isolate* isolate) {
+  if (Isolate::IsSystemIsolate(isolate)) return;
+  Thread* thread = Thread::Current();
+  DisableThreadInterruptsScope dtis(thread);
+  StackZone stack_zone(thread);
+  Zone* zone = stack_zone.GetZone();
+
+  Profile profile;
+  NoAllocationSampleFilter filter(isolate->main_port(), Thread::kMutatorTask,
+                                  -1, -1, /*take_samples=*/true);
+  profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+  if (profile.sample_count() == 0) return;
+
+  // Symbolizing allocates, so every frame is symbolized before taking
+  // [builder_mutex].
+  const intptr_t num_functions = profile.NumFunctions();
+  Frame** frames = zone->Alloc<Frame*>(num_functions);
+  for (intptr_t i = 0; i < num_functions; i++) {
+    frames[i] = nullptr;
+  }
+  auto frame_of = [&](ProfileFunction* function) {
+    Frame*& frame = frames[function->table_index()];
+    if (frame == nullptr) frame = FrameOf(function);
+    return frame;
+  };
+
+  GrowableArray<ZoneGrowableArray<Frame*>*> stacks(zone,
+                                                   profile.sample_count());
+  auto* cache = new ProfileCodeInlinedFunctionsCache();
+  Code& code = Code::Handle(zone);
+  for (intptr_t i = 0; i < profile.sample_count(); i++) {
+    ProcessedSample* sample = profile.SampleAt(i);
+    auto* stack = new (zone) ZoneGrowableArray<Frame*>(zone, sample->length());
+    for (intptr_t frame_index = 0; frame_index < sample->length();
+         frame_index++) {
+      const uword pc = sample->At(frame_index);
+      ProfileCode* profile_code =
+          profile.GetCodeFromPC(pc, sample->timestamp());
+      ProfileFunction* function = profile_code->function();
+      if (!function->is_visible() ||
+          (function->kind() == ProfileFunction::kStubFunction)) {
+        continue;
+      }
+      GrowableArray<const Function*>* inlined_functions = nullptr;
+      GrowableArray<TokenPosition>* inlined_token_positions = nullptr;
+      TokenPosition token_position = TokenPosition::kNoSource;
+      if (profile_code->code().IsCode()) {
+        code ^= profile_code->code().ptr();
+        cache->Get(pc, code, sample, frame_index, &inlined_functions,
+                   &inlined_token_positions, &token_position);
+      }
+      if ((inlined_functions == nullptr) ||
+          (inlined_functions->length() <= 1)) {
+        stack->Add(frame_of(function));
+        continue;
+      }
+      // Innermost inlined function first.
+      for (intptr_t j = inlined_functions->length() - 1; j >= 0; j--) {
+        const Function& inlined = *(*inlined_functions)[j];
+        ProfileFunction* inlined_function = profile.FindFunction(inlined);
+        if (inlined_function != nullptr) {
+          stack->Add(frame_of(inlined_function));
+        } else {
+          Frame* frame = new Frame();
+          frame->function =
+              String::Handle(zone, inlined.QualifiedUserVisibleName())
+                  .ToCString();
+          const Script& script = Script::Handle(zone, inlined.script());
+          if (!script.IsNull()) {
+            frame->url =
+                String::Handle(zone, script.resolved_url()).ToCString();
+          }
+          frame->line = LineOf(inlined);
+          stack->Add(frame);
+        }
+      }
+    }
+    if (!stack->is_empty()) {
+      stacks.Add(stack);
+    }
+  }
+
+  GrowableArray<uint64_t> locations;
+  MutexLocker ml(builder_mutex);
+  if (builder == nullptr) return;
+  for (intptr_t i = 0; i < stacks.length(); i++) {
+    ZoneGrowableArray<Frame*>* stack = stacks[i];
+    locations.Clear();
+    for (intptr_t j = 0; j < stack->length(); j++) {
+      Frame* frame = (*stack)[j];
+      if (frame->location == 0) {
+        frame->location =
+            builder->LocationFor(frame->function, frame->url, frame->line);
+      }
+      locations.Add(frame->location);
+    }
+    builder->AddSample(locations.data(), locations.length());
+  }
+}
+
+void ContinuousProfiler::WriteProfile() {
+  PprofProfileBuilder* profile;
+  int64_t start_micros;
+  intptr_t sequence;
+  const int64_t now = OS::GetCurrentTimeMicros();
+  {
+    MutexLocker ml(builder_mutex);
+    if ((builder == nullptr) || (builder->sample_count() == 0)) return;
+    profile = builder;
+    start_micros = profile_start_micros;
+    sequence = profile_sequence++;
+    builder = new PprofProfileBuilder(Profiler::CurrentConfig().period_us *
+                                      kNanosecondsPerMicrosecond);
+    profile_start_micros = now;
+  }
+
+  intptr_t length = 0;
+  uint8_t* buffer =
+      profile->Serialize(start_micros, now - start_micros, &length);
+  delete profile;
+
+  if (callback_ != nullptr) {
+    callback_(buffer, length);
+  } else {
+    auto file_open = Dart::file_open_callback();
+    auto file_write = Dart::file_write_callback();
+    auto file_close = Dart::file_close_callback();
+    if ((file_open == nullptr) || (file_write == nullptr) ||
+        (file_close == nullptr)) {
+      OS::PrintErr("warning: Could not access file callbacks.");
+      free(buffer);
+      return;
+    }
+    char* filename = OS::SCreate(nullptr, "%s/dart-%" Pd "-%" Pd ".pb",
+                                 FLAG_continuous_profile_dir, OS::ProcessId(),
+                                 sequence);
+    void* file = file_open(filename, /*write=*/true);
+    if (file == nullptr) {
+      OS::PrintErr("warning: Failed to write continuous profile: %s\n",
+                   filename);
+    } else {
+      file_write(buffer, length, file);
+      file_close(file);
+    }
+    free(filename);
+  }
+  free(buffer);
+}
+
+void ContinuousProfiler::ThreadMain(uword parameters) {
+  {
+    // Signal to the starting thread that we are ready.
+    MonitorLocker startup_ml(monitor);
+    thread_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+    thread_running = true;
+    startup_ml.Notify();
+  }
+
+  const intptr_t budget =
+      Utils::Maximum<intptr_t>(1, FLAG_continuous_profile_cpu_budget);
+  const int64_t period_micros =
+      Utils::Maximum<int64_t>(1, FLAG_continuous_profile_period) *
+      kMicrosecondsPerSecond;
+  int64_t next_write_micros = OS::GetCurrentMonotonicMicros() + period_micros;
+  int64_t wait_micros = kDrainIntervalMicros;
+
+  MonitorLocker wait_ml(monitor);
+  while (!shutting_down) {
+    wait_ml.WaitMicros(wait_micros);
+    if (shutting_down) break;
+
+    const int64_t cpu_start_micros = OS::GetCurrentThreadCPUMicros();
+    IsolateGroup::ForEach([&](IsolateGroup* group) {
+      const bool kBypassSafepoint = false;
+      Thread::EnterIsolateGroupAsHelper(group, Thread::kSampleBlockTask,
+                                        kBypassSafepoint);
+      group->ForEachIsolate([&](Isolate* isolate) {
+        if (isolate->TakeHasCompletedBlocks()) {
+          DrainSamples(isolate);
+        }
+      });
+      Thread::ExitIsolateGroupAsHelper(kBypassSafepoint);
+    });
+    if (OS::GetCurrentMonotonicMicros() >= next_write_micros) {
+      WriteProfile();
+      next_write_micros += period_micros;
+    }
+
+    // Stay within the CPU budget by idling in proportion to the time spent.
+    const int64_t used_micros =
+        (cpu_start_micros < 0)
+            ? 0
+            : OS::GetCurrentThreadCPUMicros() - cpu_start_micros;
+    wait_micros = Utils::Maximum(kDrainIntervalMicros,
+                                 used_micros * 100 / budget - used_micros);
+  }
+
+  // Signal to the shutting down thread that we are exiting.
+  thread_running = false;
+}
+
+#endif  // defined(DART_INCLUDE_PROFILER)
+
+}  // namespace dart
@@ -0,0 +1,119 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_CONTINUOUS_PROFILER_H_
+#define RUNTIME_VM_CONTINUOUS_PROFILER_H_
+
+#include "include/dart_tools_api.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class Isolate;
+
+#if defined(DART_INCLUDE_PROFILER)
+
+// Aggregates stacks of CPU samples and serializes them as a pprof profile
+// (https://github.com/google/pprof/blob/main/proto/profile.proto).
+//
+// Every distinct (function, url, line) triple becomes one location with its
+// own function entry. Identical stacks are merged into a single sample whose
+// values are the number of ticks and the CPU time they represent.
+class PprofProfileBuilder {
+ public:
+  explicit PprofProfileBuilder(int64_t period_nanos);
+  ~PprofProfileBuilder();
+
+  // Returns the id of the location for [function] at [line] of [url].
+  // [url] may be nullptr and [line] may be -1 if they are unknown.
+  uint64_t LocationFor(const char* function, const char* url, intptr_t line);
+
+  // Adds one tick of the stack consisting of [locations], innermost frame
+  // first.
+  void AddSample(const uint64_t* locations, intptr_t length);
+
+  // Number of ticks added so far.
+  intptr_t sample_count() const { return sample_count_; }
+
+  // Returns the malloc-allocated serialized profile covering the given time
+  // range, and sets [*length] to its length.
+  uint8_t* Serialize(int64_t start_micros,
+                     int64_t duration_micros,
+                     intptr_t* length) const;
+
+ private:
+  struct Location {
+    intptr_t function;
+    intptr_t url;
+    intptr_t line;
+    uint64_t id;
+
+    uword Hash() const;
+    bool Equals(const Location& other) const;
+  };
+
+  struct Stack {
+    uint64_t* locations;
+    intptr_t length;
+    intptr_t count;
+
+    uword Hash() const;
+    bool Equals(const Stack& other) const;
+  };
+
+  intptr_t Intern(const char* str);
+
+  const int64_t period_nanos_;
+  intptr_t sample_count_ = 0;
+
+  MallocGrowableArray<char*> strings_;
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> string_ids_;
+  MallocGrowableArray<Location*> locations_;
+  MallocDirectChainedHashMap<PointerSetKeyValueTrait<Location>> location_ids_;
+  MallocGrowableArray<Stack*> stacks_;
+  MallocDirectChainedHashMap<PointerSetKeyValueTrait<Stack>> stack_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(PprofProfileBuilder);
+};
+
+// Always-on CPU profiling without the VM service.
+//
+// With --continuous_profile_dir=<dir> or an embedder callback set through
+// Dart_SetContinuousProfileCallback the profiler is enabled at startup and a
+// background thread periodically takes the completed sample blocks of all
+// isolates, symbolizes them and aggregates their stacks. Every
+// --continuous_profile_period seconds the aggregate is written as a pprof
+// profile. The time spent by the background thread is bounded by
+// --continuous_profile_cpu_budget.
+class ContinuousProfiler : public AllStatic {
+ public:
+  static bool IsEnabled();
+
+  static void Startup();
+  static void Shutdown();
+
+  // Takes the remaining samples of [isolate], which is shutting down. Called
+  // on the thread of [isolate].
+  static void IsolateShutdown(Isolate* isolate);
+
+  static void SetCallback(Dart_ContinuousProfileCallback callback) {
+    callback_ = callback;
+  }
+
+ private:
+  static void ThreadMain(uword parameters);
+  static void DrainSamples(Isolate* isolate);
+  static void WriteProfile();
+
+  static Dart_ContinuousProfileCallback callback_;
+};
+
+#endif  // defined(DART_INCLUDE_PROFILER)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_CONTINUOUS_PROFILER_H_
@@ -0,0 +1,176 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/continuous_profiler.h"
+
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/datastream.h"
+#include "vm/profiler.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_INCLUDE_PROFILER)
+
+// Collects the payloads of the length-delimited field [field] of the protobuf
+// message in [buffer]. Varint fields are skipped.
+static void ReadField(const uint8_t* buffer,
+                      intptr_t length,
+                      intptr_t field,
+                      MallocGrowableArray<const uint8_t*>* messages,
+                      MallocGrowableArray<intptr_t>* lengths) {
+  ReadStream stream(buffer, length);
+  while (stream.PendingBytes() > 0) {
+    const uint64_t tag = stream.ReadLEB128<uint64_t>();
+    if ((tag & 7) == 0) {
+      stream.ReadLEB128<uint64_t>();
+      continue;
+    }
+    EXPECT_EQ(2, static_cast<intptr_t>(tag & 7));
+    const intptr_t size = stream.ReadLEB128<uint64_t>();
+    if (static_cast<intptr_t>(tag >> 3) == field) {
+      messages->Add(stream.AddressOfCurrentPosition());
+      lengths->Add(size);
+    }
+    stream.Advance(size);
+  }
+}
+
+VM_UNIT_TEST_CASE(PprofProfileBuilder_AggregatesStacks) {
+  PprofProfileBuilder builder(/*period_nanos=*/1000);
+  const uint64_t main = builder.LocationFor("main", "file:///a.dart", 3);
+  const uint64_t foo = builder.LocationFor("foo", "file:///a.dart", 7);
+  const uint64_t bar = builder.LocationFor("bar", nullptr, -1);
+  EXPECT_EQ(main, builder.LocationFor("main", "file:///a.dart", 3));
+  EXPECT(main != foo);
+  EXPECT(foo != bar);
+
+  const uint64_t foo_stack[] = {foo, main};
+  const uint64_t bar_stack[] = {bar, foo, main};
+  builder.AddSample(foo_stack, ARRAY_SIZE(foo_stack));
+  builder.AddSample(bar_stack, ARRAY_SIZE(bar_stack));
+  builder.AddSample(foo_stack, ARRAY_SIZE(foo_stack));
+  EXPECT_EQ(3, builder.sample_count());
+
+  intptr_t length = 0;
+  uint8_t* profile = builder.Serialize(0, 1000, &length);
+
+  MallocGrowableArray<const uint8_t*> strings;
+  MallocGrowableArray<intptr_t> string_lengths;
+  ReadField(profile, length, /*string_table=*/6, &strings, &string_lengths);
+  EXPECT_EQ(0, string_lengths[0]);
+  bool found_foo = false;
+  bool found_url = false;
+  for (intptr_t i = 0; i < strings.length(); i++) {
+    const char* str = reinterpret_cast<const char*>(strings[i]);
+    found_foo |= (string_lengths[i] == 3) && (strncmp(str, "foo", 3) == 0);
+    found_url |=
+        (string_lengths[i] == 14) && (strncmp(str, "file:///a.dart", 14) == 0);
+  }
+  EXPECT(found_foo);
+  EXPECT(found_url);
+
+  MallocGrowableArray<const uint8_t*> locations;
+  MallocGrowableArray<intptr_t> location_lengths;
+  ReadField(profile, length, /*location=*/4, &locations, &location_lengths);
+  EXPECT_EQ(3, locations.length());
+
+  // The two identical stacks are merged into one sample with two ticks.
+  MallocGrowableArray<const uint8_t*> samples;
+  MallocGrowableArray<intptr_t> sample_lengths;
+  ReadField(profile, length, /*sample=*/2, &samples, &sample_lengths);
+  EXPECT_EQ(2, samples.length());
+  MallocGrowableArray<const uint8_t*> values;
+  MallocGrowableArray<intptr_t> value_lengths;
+  ReadField(samples[0], sample_lengths[0], /*value=*/2, &values,
+            &value_lengths);
+  EXPECT_EQ(1, values.length());
+  ReadStream counts(values[0], value_lengths[0]);
+  EXPECT_EQ(2u, counts.ReadLEB128<uint64_t>());
+  EXPECT_EQ(2000u, counts.ReadLEB128<uint64_t>());
+
+  free(profile);
+}
+
+// The last profile passed to ReceiveProfile.
+static uint8_t* received_profile = nullptr;
+static intptr_t received_profile_length = 0;
+
+static void ReceiveProfile(const uint8_t* buffer, intptr_t length) {
+  free(received_profile);
+  received_profile = reinterpret_cast<uint8_t*>(malloc(length));
+  memmove(received_profile, buffer, length);
+  received_profile_length = length;
+}
+
+VM_UNIT_TEST_CASE(ContinuousProfiler_DeliversProfileToCallback) {
+  const char* kScript = R"(
+@pragma('vm:never-inline')
+int continuouslyProfiled(int n) {
+  int x = 0;
+  for (int i = 0; i < n; i++) {
+    x = (x * 31 + i) & 0xFFFFFF;
+  }
+  return x;
+}
+
+main() {
+  final stopwatch = Stopwatch()..start();
+  int result = 0;
+  while (stopwatch.elapsedMilliseconds < 500) {
+    result += continuouslyProfiled(100000);
+  }
+  return result;
+}
+)";
+
+  const Profiler::Config saved_config = Profiler::CurrentConfig();
+  ContinuousProfiler::SetCallback(ReceiveProfile);
+  ContinuousProfiler::Startup();
+  EXPECT(Profiler::IsRunning());
+  {
+    TestIsolateScope __test_isolate__;
+    Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+    EXPECT_VALID(lib);
+    EXPECT_VALID(Dart_Invoke(lib, NewString("main"), 0, nullptr));
+  }
+  // The isolate drained its samples when it shut down, and the last profile
+  // is delivered when the continuous profiler shuts down.
+  ContinuousProfiler::Shutdown();
+  ContinuousProfiler::SetCallback(nullptr);
+  Profiler::SetConfig(saved_config);
+
+  EXPECT(received_profile != nullptr);
+  if (received_profile == nullptr) return;
+
+  MallocGrowableArray<const uint8_t*> samples;
+  MallocGrowableArray<intptr_t> sample_lengths;
+  ReadField(received_profile, received_profile_length, /*sample=*/2, &samples,
+            &sample_lengths);
+  EXPECT(samples.length() > 0);
+
+  const char* kFunction = "continuouslyProfiled";
+  const intptr_t function_length = strlen(kFunction);
+  MallocGrowableArray<const uint8_t*> strings;
+  MallocGrowableArray<intptr_t> string_lengths;
+  ReadField(received_profile, received_profile_length, /*string_table=*/6,
+            &strings, &string_lengths);
+  bool found_function = false;
+  for (intptr_t i = 0; i < strings.length(); i++) {
+    found_function |=
+        (string_lengths[i] == function_length) &&
+        (strncmp(reinterpret_cast<const char*>(strings[i]), kFunction,
+                 function_length) == 0);
+  }
+  EXPECT(found_function);
+
+  free(received_profile);
+  received_profile = nullptr;
+  received_profile_length = 0;
+}
+
+#endif  // defined(DART_INCLUDE_PROFILER)
+
+}  // namespace dart
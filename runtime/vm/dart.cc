@@ -13,6 +13,7 @@
 #include "vm/code_observers.h"
 #include "vm/compiler/runtime_offsets_extracted.h"
 #include "vm/compiler/runtime_offsets_list.h"
+#include "vm/continuous_profiler.h"
 #include "vm/cpu.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -30,6 +31,7 @@
 #include "vm/isolate.h"
 #include "vm/isolate_reload.h"
 #include "vm/kernel_isolate.h"
+#include "vm/lock_profiler.h"
 #include "vm/message_handler.h"
 #include "vm/metrics.h"
 #include "vm/microtask_mirror_queues.h"
@@ -59,6 +61,9 @@
 namespace dart {
 
 DECLARE_FLAG(bool, print_class_table);
+#if defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(bool, print_lazy_snapshot_statistics);
+#endif
 DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 DEFINE_FLAG(bool,
             check_core_snapshot_match,
@@ -329,6 +334,7 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   FreeListElement::Init();
   ForwardingCorpse::Init();
   NativeSymbolResolver::Init();
+  LockProfiler::Init();
   Page::Init();
   StoreBuffer::Init();
   MarkingStack::Init();
@@ -350,6 +356,7 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
 
 #if defined(DART_INCLUDE_PROFILER)
   Profiler::Init();
+  ContinuousProfiler::Startup();
 #endif
 
   Isolate::SetCreateGroupCallback(params->create_group);
@@ -488,6 +495,13 @@ char* Dart::Cleanup() {
                  UptimeMillis());
   }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+  if (FLAG_print_lazy_snapshot_statistics) {
+    LazySnapshotObjects::PrintStatistics();
+  }
+#endif
+  SnapshotLoadReport::WriteToFile();
+
 #if defined(DART_INCLUDE_PROFILER)
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Stopping profiling\n",
@@ -504,6 +518,7 @@ char* Dart::Cleanup() {
   Timeline::StopStreaming(/*reinitialize=*/false);
 #endif
 
+  LockProfiler::Cleanup();
   NativeSymbolResolver::Cleanup();
 
   // Disable the creation of new isolates.
@@ -554,6 +569,14 @@ char* Dart::Cleanup() {
   // before shutting down the thread pool.
   WaitForIsolateShutdown();
 
+#if defined(DART_INCLUDE_PROFILER)
+  if (FLAG_trace_shutdown) {
+    OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Writing continuous profile\n",
+                 UptimeMillis());
+  }
+  ContinuousProfiler::Shutdown();
+#endif  // defined(DART_INCLUDE_PROFILER)
+
   // Shutdown the thread pool. On return, all thread pool threads have exited.
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Deleting thread pool\n",
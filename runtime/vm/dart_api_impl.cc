@@ -20,6 +20,7 @@
 #include "vm/class_finalizer.h"
 #include "vm/coff.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/continuous_profiler.h"
 #include "vm/dart.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_message.h"
@@ -28,6 +29,7 @@
 #include "vm/debugger.h"
 #include "vm/dwarf.h"
 #include "vm/elf.h"
+#include "vm/event_loop_stats.h"
 #include "vm/exceptions.h"
 #include "vm/flags.h"
 #include "vm/growable_array.h"
@@ -65,6 +67,7 @@
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/frontend/kernel_fingerprints.h"
 #include "vm/kernel_loader.h"
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
@@ -1164,6 +1167,57 @@ DART_EXPORT bool Dart_IsVMFlagSet(const char* flag_name) {
 DART_API_ISOLATE_GROUP_METRIC_LIST(ISOLATE_GROUP_METRIC_API)
 #undef ISOLATE_GROUP_METRIC_API
 
+DART_EXPORT char* Dart_GetSnapshotLoadReport() {
+  return SnapshotLoadReport::ToJSON();
+}
+
+DART_EXPORT bool Dart_SetContinuousProfileCallback(
+    Dart_ContinuousProfileCallback callback) {
+#if defined(DART_INCLUDE_PROFILER)
+  ContinuousProfiler::SetCallback(callback);
+  return true;
+#else
+  return false;
+#endif  // defined(DART_INCLUDE_PROFILER)
+}
+
+DART_EXPORT bool Dart_GetEventLoopLatency(Dart_Isolate isolate,
+                                          Dart_EventLoopLatencyKind kind,
+                                          Dart_LatencySummary* summary) {
+  if (isolate == nullptr) {
+    FATAL("%s expects argument 'isolate' to be non-null.", CURRENT_FUNC);
+  }
+  CHECK_NULL(summary);
+  Isolate* iso = reinterpret_cast<Isolate*>(isolate);
+  EventLoopStats* stats = iso->message_handler()->event_loop_stats();
+  if (stats == nullptr) {
+    return false;
+  }
+  const LatencyHistogram* histogram = nullptr;
+  switch (kind) {
+    case Dart_EventLoopLatency_MessageQueue:
+      histogram = &stats->message_queue_latency();
+      break;
+    case Dart_EventLoopLatency_MessageHandler:
+      histogram = &stats->message_handler_time();
+      break;
+    case Dart_EventLoopLatency_MicrotaskDrain:
+      histogram = &stats->microtask_drain_time();
+      break;
+    default:
+      FATAL("%s: invalid kind %d.", CURRENT_FUNC, kind);
+  }
+  summary->count = histogram->count();
+  summary->min_micros = histogram->min_micros();
+  summary->max_micros = histogram->max_micros();
+  summary->total_micros = histogram->total_micros();
+  summary->p50_micros = histogram->ValueAtPercentile(50);
+  summary->p90_micros = histogram->ValueAtPercentile(90);
+  summary->p99_micros = histogram->ValueAtPercentile(99);
+  summary->p999_micros = histogram->ValueAtPercentile(99.9);
+  return true;
+}
+
 #if !defined(PRODUCT)
 #define ISOLATE_METRIC_API(type, variable, name, unit)                         \
   DART_EXPORT int64_t Dart_Isolate##variable##Metric(Dart_Isolate isolate) {   \
@@ -7130,6 +7184,64 @@ Dart_CreateAppJITSnapshotAsBlobs(uint8_t** isolate_snapshot_data_buffer,
 #endif
 }
 
+DART_EXPORT Dart_Handle Dart_GetLibraryFingerprints(uint8_t** buffer,
+                                                    intptr_t* buffer_length) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return Api::NewError("%s: Cannot compute fingerprints on an AOT runtime.",
+                       CURRENT_FUNC);
+#else
+  DARTSCOPE(Thread::Current());
+  CHECK_NULL(buffer);
+  CHECK_NULL(buffer_length);
+
+  const auto& libraries = GrowableObjectArray::Handle(
+      Z, T->isolate_group()->object_store()->libraries());
+  auto& library = Library::Handle(Z);
+  auto& imported = Library::Handle(Z);
+  auto& toplevel_class = Class::Handle(Z);
+  auto& url = String::Handle(Z);
+  auto& exports = Array::Handle(Z);
+  auto& ns = Namespace::Handle(Z);
+  ZoneTextBuffer text(Api::TopScope(T)->zone(), 1 * KB);
+  for (intptr_t i = 0; i < libraries.Length(); i++) {
+    library ^= libraries.At(i);
+    if (library.is_dart_scheme()) continue;
+
+    // The kernel data is fingerprinted so that no class has to be loaded.
+    uint32_t fingerprint = 0;
+    toplevel_class = library.toplevel_class();
+    if (library.kernel_program_info() != KernelProgramInfo::null() &&
+        !toplevel_class.is_declared_in_bytecode()) {
+      fingerprint =
+          kernel::KernelSourceFingerprintHelper::CalculateLibraryFingerprint(
+              library);
+    }
+
+    url = library.url();
+    text.Printf("%08x %s", fingerprint, url.ToCString());
+    for (intptr_t j = 0; j < library.num_imports(); j++) {
+      imported = library.ImportLibraryAt(j);
+      if (imported.IsNull() || imported.is_dart_scheme()) continue;
+      url = imported.url();
+      text.Printf(" %s", url.ToCString());
+    }
+    exports = library.exports();
+    for (intptr_t j = 0; j < exports.Length(); j++) {
+      ns ^= exports.At(j);
+      imported = ns.target();
+      if (imported.IsNull() || imported.is_dart_scheme()) continue;
+      url = imported.url();
+      text.Printf(" %s", url.ToCString());
+    }
+    text.AddChar('\n');
+  }
+
+  *buffer = reinterpret_cast<uint8_t*>(text.buffer());
+  *buffer_length = text.length();
+  return Api::Success();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 DART_EXPORT Dart_Handle Dart_GetObfuscationMap(uint8_t** buffer,
                                                intptr_t* buffer_length) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -754,13 +754,16 @@ static void DebuggerSetResumeIfStepping(Isolate* isolate) {
 }
 
 ObjectPtr DartLibraryCalls::HandleMessage(Dart_Port port_id,
-                                          const Instance& message) {
+                                          const Instance& message,
+                                          bool drain_microtasks) {
   auto* const thread = Thread::Current();
   auto* const zone = thread->zone();
   auto* const isolate = thread->isolate();
   auto* const object_store = thread->isolate_group()->object_store();
-  const auto& function =
-      Function::Handle(zone, object_store->handle_message_function());
+  const auto& function = Function::Handle(
+      zone, drain_microtasks
+                ? object_store->handle_message_function()
+                : object_store->handle_message_without_microtasks_function());
   ASSERT(!function.IsNull());
   Array& args =
       Array::Handle(zone, isolate->isolate_object_store()->dart_args_2());
@@ -305,7 +305,12 @@ class DartLibraryCalls : public AllStatic {
 
   // Returns handler on success, an ErrorPtr on failure, null if can't find
   // handler for this port id.
-  static ObjectPtr HandleMessage(Dart_Port port_id, const Instance& message);
+  //
+  // Unless [drain_microtasks] is false, the microtask queue is drained after
+  // the handler returns.
+  static ObjectPtr HandleMessage(Dart_Port port_id,
+                                 const Instance& message,
+                                 bool drain_microtasks = true);
 
   // Invokes the finalizer to run its callbacks.
   static ObjectPtr HandleFinalizerMessage(const FinalizerBase& finalizer);
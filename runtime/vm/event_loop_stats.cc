@@ -0,0 +1,124 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/event_loop_stats.h"
+
+#include <cmath>
+
+#include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/json_stream.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            record_event_loop_latency,
+            false,
+            "Record histograms of message queueing delay, message handling "
+            "time and microtask queue draining time for each isolate.");
+
+intptr_t LatencyHistogram::IndexOf(int64_t micros) {
+  ASSERT((0 <= micros) && (micros <= kMaxMicros));
+  if (micros < 2 * kSubBucketCount) {
+    return micros;
+  }
+  // The bucket of durations in [2^exponent, 2^(exponent + 1)) is split into
+  // sub-buckets of 2^shift microseconds each.
+  const intptr_t exponent = Utils::HighestBit(micros);
+  const intptr_t shift = exponent - kSubBucketBits;
+  return (shift * kSubBucketCount) + (micros >> shift);
+}
+
+int64_t LatencyHistogram::HighestEquivalentValue(intptr_t index) {
+  ASSERT((0 <= index) && (index < kNumCounts));
+  if (index < 2 * kSubBucketCount) {
+    return index;
+  }
+  const intptr_t shift = (index >> kSubBucketBits) - 1;
+  const int64_t sub_bucket = kSubBucketCount + (index & (kSubBucketCount - 1));
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t micros) {
+  micros = Utils::Minimum(Utils::Maximum<int64_t>(micros, 0), kMaxMicros);
+  counts_[IndexOf(micros)].fetch_add(1);
+  count_.fetch_add(1);
+  total_micros_.fetch_add(micros);
+  if (micros < min_micros_.load()) {
+    min_micros_.store(micros);
+  }
+  if (micros > max_micros_.load()) {
+    max_micros_.store(micros);
+  }
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  const int64_t count = this->count();
+  if (count == 0) {
+    return 0;
+  }
+  percentile = Utils::Minimum(Utils::Maximum(percentile, 0.0), 100.0);
+  const int64_t rank = Utils::Maximum<int64_t>(
+      1, static_cast<int64_t>(ceil(percentile * count / 100.0)));
+  int64_t seen = 0;
+  for (intptr_t i = 0; i < kNumCounts; i++) {
+    seen += counts_[i].load();
+    if (seen >= rank) {
+      return Utils::Minimum(HighestEquivalentValue(i), max_micros());
+    }
+  }
+  return max_micros();
+}
+
+#if !defined(PRODUCT)
+void LatencyHistogram::PrintJSON(JSONObject* jsobj, const char* name) const {
+  JSONObject histogram(jsobj, name);
+  histogram.AddProperty("type", "_LatencyHistogram");
+  histogram.AddProperty64("count", count());
+  histogram.AddProperty64("minMicros", min_micros());
+  histogram.AddProperty64("maxMicros", max_micros());
+  histogram.AddProperty64("totalMicros", total_micros());
+  histogram.AddProperty64("p50Micros", ValueAtPercentile(50));
+  histogram.AddProperty64("p90Micros", ValueAtPercentile(90));
+  histogram.AddProperty64("p99Micros", ValueAtPercentile(99));
+  histogram.AddProperty64("p999Micros", ValueAtPercentile(99.9));
+  // Pairs of the highest duration counted by a non-empty bucket and its count.
+  JSONArray buckets(&histogram, "buckets");
+  for (intptr_t i = 0; i < kNumCounts; i++) {
+    const int64_t bucket_count = counts_[i].load();
+    if (bucket_count != 0) {
+      JSONArray bucket(&buckets);
+      bucket.AddValue64(HighestEquivalentValue(i));
+      bucket.AddValue64(bucket_count);
+    }
+  }
+}
+#endif  // !defined(PRODUCT)
+
+void EventLoopStats::RecordMessage(int64_t posted_micros,
+                                   int64_t start_micros,
+                                   int64_t end_micros) {
+  message_queue_latency_.Record(start_micros - posted_micros);
+  message_handler_time_.Record(end_micros - start_micros -
+                               pending_drain_micros_);
+  pending_drain_micros_ = 0;
+}
+
+void EventLoopStats::RecordMicrotaskDrain(int64_t start_micros,
+                                          int64_t end_micros) {
+  microtask_drain_time_.Record(end_micros - start_micros);
+  pending_drain_micros_ += end_micros - start_micros;
+}
+
+#if !defined(PRODUCT)
+void EventLoopStats::PrintJSON(JSONStream* js) const {
+  JSONObject jsobj(js);
+  jsobj.AddProperty("type", "_EventLoopLatency");
+  message_queue_latency_.PrintJSON(&jsobj, "messageQueueLatency");
+  message_handler_time_.PrintJSON(&jsobj, "messageHandlerTime");
+  microtask_drain_time_.PrintJSON(&jsobj, "microtaskDrainTime");
+}
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
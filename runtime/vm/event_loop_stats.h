@@ -0,0 +1,112 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_EVENT_LOOP_STATS_H_
+#define RUNTIME_VM_EVENT_LOOP_STATS_H_
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class JSONObject;
+class JSONStream;
+
+// A histogram of durations in microseconds in the style of HdrHistogram.
+//
+// Durations below 2 * kSubBucketCount are counted exactly. Longer durations
+// are counted in buckets covering a power of two each, split into
+// kSubBucketCount linear sub-buckets, so percentiles are reported with a
+// relative error below 1 / kSubBucketCount.
+//
+// Durations are recorded by a single thread at a time. Other threads can read
+// the histogram while it is being recorded into, in which case they see a
+// recent but not necessarily consistent state.
+class LatencyHistogram {
+ public:
+  static constexpr intptr_t kSubBucketBits = 5;
+  static constexpr intptr_t kSubBucketCount = 1 << kSubBucketBits;
+  // Longer durations are recorded as the longest trackable duration.
+  static constexpr intptr_t kMaxBits = 36;
+  static constexpr int64_t kMaxMicros =
+      (static_cast<int64_t>(1) << kMaxBits) - 1;
+  static constexpr intptr_t kNumCounts =
+      (kMaxBits - kSubBucketBits + 1) * kSubBucketCount;
+
+  LatencyHistogram() {}
+
+  void Record(int64_t micros);
+
+  int64_t count() const { return count_.load(); }
+  int64_t min_micros() const { return count() == 0 ? 0 : min_micros_.load(); }
+  int64_t max_micros() const { return max_micros_.load(); }
+  int64_t total_micros() const { return total_micros_.load(); }
+
+  // Returns a duration that at least [percentile] percent of the recorded
+  // durations do not exceed, or 0 if nothing was recorded.
+  int64_t ValueAtPercentile(double percentile) const;
+
+#if !defined(PRODUCT)
+  void PrintJSON(JSONObject* jsobj, const char* name) const;
+#endif  // !defined(PRODUCT)
+
+  // Exposed for testing.
+  static intptr_t IndexOf(int64_t micros);
+  static int64_t HighestEquivalentValue(intptr_t index);
+
+ private:
+  RelaxedAtomic<int64_t> counts_[kNumCounts] = {};
+  RelaxedAtomic<int64_t> count_ = 0;
+  RelaxedAtomic<int64_t> min_micros_ = kMaxInt64;
+  RelaxedAtomic<int64_t> max_micros_ = 0;
+  RelaxedAtomic<int64_t> total_micros_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+// Latency histograms of the event loop of one message handler, recorded when
+// --record_event_loop_latency is set.
+class EventLoopStats {
+ public:
+  EventLoopStats() {}
+
+  // Time from posting a message until its handler starts.
+  const LatencyHistogram& message_queue_latency() const {
+    return message_queue_latency_;
+  }
+  // Time spent handling a message, without draining the microtask queue.
+  const LatencyHistogram& message_handler_time() const {
+    return message_handler_time_;
+  }
+  // Time spent draining the microtask queue.
+  const LatencyHistogram& microtask_drain_time() const {
+    return microtask_drain_time_;
+  }
+
+  // Records a message posted at [posted_micros] and handled from
+  // [start_micros] to [end_micros], including any microtask drains recorded
+  // in the meantime.
+  void RecordMessage(int64_t posted_micros,
+                     int64_t start_micros,
+                     int64_t end_micros);
+  void RecordMicrotaskDrain(int64_t start_micros, int64_t end_micros);
+
+#if !defined(PRODUCT)
+  void PrintJSON(JSONStream* js) const;
+#endif  // !defined(PRODUCT)
+
+ private:
+  LatencyHistogram message_queue_latency_;
+  LatencyHistogram message_handler_time_;
+  LatencyHistogram microtask_drain_time_;
+  // Time spent draining microtasks since the last message was recorded.
+  int64_t pending_drain_micros_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(EventLoopStats);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_EVENT_LOOP_STATS_H_
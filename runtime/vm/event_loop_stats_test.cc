@@ -0,0 +1,210 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/event_loop_stats.h"
+
+#include "include/dart_api.h"
+#include "include/dart_tools_api.h"
+#include "platform/assert.h"
+#include "vm/flags.h"
+#include "vm/json_stream.h"
+#include "vm/message_handler.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, record_event_loop_latency);
+
+VM_UNIT_TEST_CASE(LatencyHistogram_Buckets) {
+  // Short durations are counted exactly.
+  for (int64_t micros = 0; micros < 2 * LatencyHistogram::kSubBucketCount;
+       micros++) {
+    const intptr_t index = LatencyHistogram::IndexOf(micros);
+    EXPECT_EQ(micros, index);
+    EXPECT_EQ(micros, LatencyHistogram::HighestEquivalentValue(index));
+  }
+  // Every duration is counted in a bucket whose highest value is within the
+  // relative error of the duration.
+  for (int64_t micros = 1; micros <= LatencyHistogram::kMaxMicros;
+       micros = micros * 3 + 1) {
+    const intptr_t index = LatencyHistogram::IndexOf(micros);
+    EXPECT_LT(index, LatencyHistogram::kNumCounts);
+    const int64_t highest = LatencyHistogram::HighestEquivalentValue(index);
+    EXPECT_LE(micros, highest);
+    EXPECT_LE(highest - micros, micros / LatencyHistogram::kSubBucketCount);
+    EXPECT_EQ(index, LatencyHistogram::IndexOf(highest));
+    if (highest < LatencyHistogram::kMaxMicros) {
+      EXPECT_EQ(index + 1, LatencyHistogram::IndexOf(highest + 1));
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::kNumCounts - 1,
+            LatencyHistogram::IndexOf(LatencyHistogram::kMaxMicros));
+}
+
+VM_UNIT_TEST_CASE(LatencyHistogram_Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.min_micros());
+  EXPECT_EQ(0, histogram.ValueAtPercentile(50));
+
+  for (int64_t micros = 1; micros <= 1000; micros++) {
+    histogram.Record(micros);
+  }
+  EXPECT_EQ(1000, histogram.count());
+  EXPECT_EQ(1, histogram.min_micros());
+  EXPECT_EQ(1000, histogram.max_micros());
+  EXPECT_EQ(500500, histogram.total_micros());
+  EXPECT_LE(500, histogram.ValueAtPercentile(50));
+  EXPECT_GE(516, histogram.ValueAtPercentile(50));
+  EXPECT_LE(990, histogram.ValueAtPercentile(99));
+  EXPECT_GE(1000, histogram.ValueAtPercentile(99));
+  EXPECT_EQ(1000, histogram.ValueAtPercentile(100));
+
+  // Negative and overlong durations are clamped.
+  histogram.Record(-1);
+  histogram.Record(LatencyHistogram::kMaxMicros + 1);
+  EXPECT_EQ(0, histogram.min_micros());
+  EXPECT_EQ(LatencyHistogram::kMaxMicros, histogram.max_micros());
+}
+
+VM_UNIT_TEST_CASE(EventLoopStats_SeparatesMicrotaskDrains) {
+  EventLoopStats stats;
+  stats.RecordMicrotaskDrain(120, 150);
+  stats.RecordMessage(/*posted_micros=*/10, /*start_micros=*/100,
+                      /*end_micros=*/200);
+  stats.RecordMessage(/*posted_micros=*/200, /*start_micros=*/210,
+                      /*end_micros=*/215);
+
+  EXPECT_EQ(2, stats.message_queue_latency().count());
+  EXPECT_EQ(10, stats.message_queue_latency().min_micros());
+  EXPECT_EQ(90, stats.message_queue_latency().max_micros());
+  EXPECT_EQ(2, stats.message_handler_time().count());
+  EXPECT_EQ(5, stats.message_handler_time().min_micros());
+  EXPECT_EQ(70, stats.message_handler_time().max_micros());
+  EXPECT_EQ(1, stats.microtask_drain_time().count());
+  EXPECT_EQ(30, stats.microtask_drain_time().total_micros());
+
+#if !defined(PRODUCT)
+  JSONStream js;
+  stats.PrintJSON(&js);
+  const char* json = js.ToCString();
+  EXPECT_SUBSTRING("\"type\":\"_EventLoopLatency\"", json);
+  EXPECT_SUBSTRING("\"microtaskDrainTime\":{\"type\":\"_LatencyHistogram\","
+                   "\"count\":1",
+                   json);
+#endif  // !defined(PRODUCT)
+}
+
+// Posts messages whose handlers schedule microtasks, one of which throws, and
+// logs the order in which everything runs. Errors are not fatal, so the loop
+// continues past the exception and reports it to an error listener.
+static const char* kEventLoopScript = R"(
+import 'dart:async';
+import 'dart:isolate';
+
+final log = <String>[];
+
+@pragma('vm:entry-point', 'call')
+void start() {
+  Isolate.current.setErrorsFatal(false);
+  final errors = RawReceivePort();
+  errors.handler = (error) {
+    log.add('error ${error[0]}');
+    errors.close();
+  };
+  Isolate.current.addErrorListener(errors.sendPort);
+
+  final port = RawReceivePort();
+  port.handler = (int i) {
+    log.add('message $i');
+    scheduleMicrotask(() {
+      log.add('microtask $i');
+      scheduleMicrotask(() => log.add('nested microtask $i'));
+    });
+    if (i == 1) {
+      scheduleMicrotask(() => throw 'failure $i');
+      scheduleMicrotask(() => log.add('after failure $i'));
+    }
+    if (i == 2) port.close();
+  };
+  for (int i = 0; i < 3; i++) {
+    port.sendPort.send(i);
+  }
+}
+
+@pragma('vm:entry-point', 'call')
+String getLog() => log.join(', ');
+)";
+
+static const char* kExpectedEventLoopLog =
+    "message 0, microtask 0, nested microtask 0, "
+    "message 1, microtask 1, after failure 1, nested microtask 1, "
+    "message 2, microtask 2, nested microtask 2, "
+    "error failure 1";
+
+// Runs kEventLoopScript in a new isolate and checks the order of the log, and
+// whether the event loop latency of the isolate was recorded.
+static void RunEventLoopScript(bool record_latency) {
+  SetFlagScope<bool> sfs(&FLAG_record_event_loop_latency, record_latency);
+  TestCase::CreateTestIsolate();
+  Dart_EnterScope();
+  Dart_Handle lib = TestCase::LoadTestScript(kEventLoopScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("start"), 0, nullptr));
+  EXPECT_VALID(Dart_RunLoop());
+
+  Dart_Handle log = Dart_Invoke(lib, NewString("getLog"), 0, nullptr);
+  EXPECT_VALID(log);
+  const char* log_chars = nullptr;
+  EXPECT_VALID(Dart_StringToCString(log, &log_chars));
+  EXPECT_STREQ(kExpectedEventLoopLog, log_chars);
+
+  // The three messages and the error each were handled as a message, and each
+  // of them was followed by draining the microtask queue.
+  const Dart_EventLoopLatencyKind kinds[] = {
+      Dart_EventLoopLatency_MessageQueue,
+      Dart_EventLoopLatency_MessageHandler,
+      Dart_EventLoopLatency_MicrotaskDrain,
+  };
+  for (size_t i = 0; i < ARRAY_SIZE(kinds); i++) {
+    Dart_LatencySummary summary;
+    EXPECT_EQ(record_latency,
+              Dart_GetEventLoopLatency(Dart_CurrentIsolate(), kinds[i],
+                                       &summary));
+    if (record_latency) {
+      EXPECT_LE(4, summary.count);
+    }
+  }
+
+#if !defined(PRODUCT)
+  {
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    EventLoopStats* stats =
+        thread->isolate()->message_handler()->event_loop_stats();
+    EXPECT_EQ(record_latency, stats != nullptr);
+    if (stats != nullptr) {
+      // The response of the _getEventLoopLatency service RPC.
+      JSONStream js;
+      stats->PrintJSON(&js);
+      const char* json = js.ToCString();
+      EXPECT_SUBSTRING("\"type\":\"_EventLoopLatency\"", json);
+      EXPECT(strstr(json, "\"count\":0") == nullptr);
+    }
+  }
+#endif  // !defined(PRODUCT)
+
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+}
+
+// Draining the microtask queue in the VM when recording the latency must run
+// microtasks and report unhandled exceptions in the same order as draining it
+// in Dart.
+VM_UNIT_TEST_CASE(EventLoopStats_MicrotasksAndErrors) {
+  RunEventLoopScript(/*record_latency=*/false);
+  RunEventLoopScript(/*record_latency=*/true);
+}
+
+}  // namespace dart
@@ -124,6 +124,20 @@ const intptr_t kDefaultNewGenSemiMaxSize = (kWordSize <= 4) ? 8 : 16;
 #define DART_INCLUDE_STACK_DUMPER 1
 #endif
 
+// On Linux the profiler can interrupt threads with timers measuring their CPU
+// time (see --profiler_cpu_time_timers). The timers are directed at the kernel
+// thread ids recorded for the timeline.
+#if defined(DART_INCLUDE_PROFILER) && defined(DART_HOST_OS_LINUX) &&           \
+    !defined(DART_USE_ABSL) && defined(SUPPORT_TIMELINE)
+#define DART_SUPPORT_CPU_TIME_TIMERS 1
+#endif
+
+// On Linux profiler samples can record the performance counters of the sampled
+// thread (see --profile_perf_counters).
+#if defined(DART_INCLUDE_PROFILER) && defined(DART_HOST_OS_LINUX)
+#define DART_SUPPORT_PERF_COUNTERS 1
+#endif
+
 // Include IL printer and disassembler functionality into non-PRODUCT builds,
 // in all AOT compiler builds or when forced.
 #if !defined(PRODUCT) || defined(DART_PRECOMPILER) ||                          \
@@ -220,6 +234,30 @@ static constexpr intptr_t kAllocationCanary = 123;
 #define GET_FP_REGISTER() 0
 #endif
 
+// The layout of C stack frames.
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64) ||                       \
+    defined(HOST_ARCH_ARM) || defined(HOST_ARCH_ARM64)
+// +-------------+
+// | saved IP/LR |
+// +-------------+
+// | saved FP    |  <- FP
+// +-------------+
+static constexpr intptr_t kHostSavedCallerPcSlotFromFp = 1;
+static constexpr intptr_t kHostSavedCallerFpSlotFromFp = 0;
+#elif defined(HOST_ARCH_RISCV32) || defined(HOST_ARCH_RISCV64)
+// +-------------+
+// |             | <- FP
+// +-------------+
+// | saved RA    |
+// +-------------+
+// | saved FP    |
+// +-------------+
+static constexpr intptr_t kHostSavedCallerPcSlotFromFp = -1;
+static constexpr intptr_t kHostSavedCallerFpSlotFromFp = -2;
+#else
+#error What architecture?
+#endif
+
 #if defined(TARGET_ARCH_ARM) || defined(TARGET_ARCH_ARM64) ||                  \
     defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_RISCV32) ||                \
     defined(TARGET_ARCH_RISCV64)
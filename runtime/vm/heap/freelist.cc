@@ -73,7 +73,7 @@ intptr_t FreeListElement::HeaderSizeFor(intptr_t size) {
   return ((size > UntaggedObject::SizeTag::kMaxSizeTag) ? 3 : 2) * kWordSize;
 }
 
-FreeList::FreeList() : mutex_() {
+FreeList::FreeList() : mutex_("FreeList::mutex_") {
   Reset();
 }
 
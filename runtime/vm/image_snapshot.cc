@@ -21,6 +21,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/program_visitor.h"
+#include "vm/startup_code_order.h"
 #include "vm/stub_code.h"
 #include "vm/timeline.h"
 #include "vm/type_testing_stubs.h"
@@ -42,6 +43,8 @@ DEFINE_FLAG(charp,
             print_instructions_sizes_to,
             nullptr,
             "Print sizes of all instruction objects to the given file");
+
+DECLARE_FLAG(bool, trace_startup_code_order);
 #endif
 
 const UntaggedInstructionsSection* Image::ExtraInfo(const uword raw_memory,
@@ -871,6 +874,14 @@ void ImageWriter::WriteText() {
   uint8_t padding_bytes[64];
   memset(&padding_bytes[0], 0, sizeof(padding_bytes));
 
+#if defined(DART_PRECOMPILER)
+  // The end of the instructions of the last function listed in
+  // --startup_code_order, which the runtime may prefetch.
+  auto& owner = Object::Handle(zone_);
+  intptr_t startup_code_count = 0;
+  intptr_t startup_text_end = 0;
+#endif
+
   ASSERT(offset_space_ != IdSpace::kSnapshot);
   for (intptr_t i = 0; i < instructions_.length(); i++) {
     auto& data = instructions_[i];
@@ -968,11 +979,32 @@ void ImageWriter::WriteText() {
     text_offset += AlignWithBreakInstructions(alignment, text_offset);
 
     ASSERT_EQUAL(text_offset - instr_start, SizeInSnapshot(insns.ptr()));
+#if defined(DART_PRECOMPILER)
+    if (StartupCodeOrder::IsEnabled()) {
+      owner = WeakSerializationReference::Unwrap(code.owner());
+      if (owner.IsFunction() &&
+          StartupCodeOrder::RankOf(Function::Cast(owner)) !=
+              StartupCodeOrder::kNotInStartupOrder) {
+        startup_code_count++;
+        startup_text_end = text_offset;
+      }
+    }
+#endif
 #if defined(EMIT_UNWIND_DIRECTIVES_PER_FUNCTION)
     FrameUnwindEpilogue();
 #endif
   }
 
+#if defined(DART_PRECOMPILER)
+  if (FLAG_trace_startup_code_order && StartupCodeOrder::IsEnabled()) {
+    OS::PrintErr("Startup code: %" Pd
+                 " functions within the first %" Pd
+                 " bytes of the text section (prefetch with "
+                 "--prefetch_snapshot_text=%" Pd ")\n",
+                 startup_code_count, startup_text_end, startup_text_end);
+  }
+#endif
+
   // Should be a no-op unless writing bare instruction payloads, in which case
   // we need to add post-payload padding for the InstructionsSection object.
   // Since this follows instructions, we'll use break instructions for padding.
@@ -21,6 +21,7 @@
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/dispatch_table.h"
+#include "vm/event_loop_stats.h"
 #include "vm/ffi_callback_metadata.h"
 #include "vm/flags.h"
 #include "vm/heap/heap.h"
@@ -335,7 +336,7 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       background_compiler_(new BackgroundCompiler(this)),
 #endif
       callback_metadata_(new FfiCallbackMetadata()),
-      symbols_mutex_(),
+      symbols_mutex_("IsolateGroup::symbols_mutex_"),
       type_canonicalization_mutex_(),
       type_arguments_canonicalization_mutex_(),
       subtype_test_cache_mutex_(),
@@ -686,6 +687,9 @@ void IsolateGroup::PrintToJSONObject(JSONObject* jsobj, bool ref) {
       isolate_array.AddValue(isolate, /*ref=*/true);
     }
   }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  background_compiler()->PrintJSON(jsobj);
+#endif
 }
 
 void IsolateGroup::PrintMemoryUsageJSON(JSONStream* stream) {
@@ -1529,8 +1533,24 @@ MessageHandler::MessageStatus IsolateMessageHandler::HandleMessage(
       }
     }
   } else {
+    EventLoopStats* stats = event_loop_stats();
+    const bool drain_microtasks = stats == nullptr;
     Object& msg_handler = Object::Handle(
-        zone, DartLibraryCalls::HandleMessage(message->dest_port(), msg));
+        zone, DartLibraryCalls::HandleMessage(message->dest_port(), msg,
+                                              drain_microtasks));
+    if ((stats != nullptr) && !msg_handler.IsNull() &&
+        !msg_handler.IsError()) {
+      // Drain the microtask queue here rather than in Dart, so that draining
+      // is recorded separately from handling the message.
+      const int64_t start_micros = OS::GetCurrentMonotonicMicros();
+      const Object& error =
+          Object::Handle(zone, DartLibraryCalls::DrainMicrotaskQueue());
+      stats->RecordMicrotaskDrain(start_micros,
+                                  OS::GetCurrentMonotonicMicros());
+      if (error.IsError()) {
+        msg_handler = error.ptr();
+      }
+    }
     while (msg_handler.IsError()) {
       status = ProcessUnhandledException(Error::Cast(msg_handler));
       if (status == kOK) {
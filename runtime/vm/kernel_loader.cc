@@ -24,9 +24,24 @@
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
+#include "vm/thread_pool.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            kernel_loading_tasks,
+            4,
+            "The number of helper tasks to spawn for decoding the sources of a "
+            "kernel program while loading it (0 means decode all sources on "
+            "the main thread).");
+DEFINE_FLAG(int,
+            kernel_parallel_decoding_min_bytes,
+            256 * KB,
+            "Kernel programs whose sources are smaller than this in total are "
+            "decoded on the main thread even when --kernel_loading_tasks "
+            "allows helpers.");
+
 namespace kernel {
 
 #define Z (zone_)
@@ -447,13 +462,188 @@ void KernelLoader::InitializeFields(UriToSourceTable* uri_to_source_table) {
 
   H.InitFromKernelProgramInfo(kernel_program_info_);
 
+  // Programs loaded with a source table take their sources from it instead.
+  const Array& decoded_sources = Array::Handle(
+      Z, uri_to_source_table == nullptr
+             ? DecodeSourcesInParallel(source_table_size)
+             : Array::null());
   Script& script = Script::Handle(Z);
+  String& decoded_source = String::Handle(Z);
   for (intptr_t index = 0; index < source_table_size; ++index) {
-    script = LoadScriptAt(index, uri_to_source_table);
+    if (!decoded_sources.IsNull()) {
+      decoded_source ^= decoded_sources.At(index);
+    }
+    script = LoadScriptAt(index, uri_to_source_table, decoded_source);
     scripts.SetAt(index, script);
   }
 }
 
+// The sources decoded by DecodeSourcesInParallel, claimed in order by the
+// helpers and the isolate thread. The sources are decoded in two passes: the
+// first counts the code units of each source, after which the isolate thread
+// allocates the strings the second pass decodes the sources into.
+class ParallelSourceDecodingState : public ValueObject {
+ public:
+  struct Source {
+    intptr_t index;
+    const uint8_t* utf8;
+    intptr_t utf8_length;
+    Utf8::Type type;
+    intptr_t length;
+    // The payload of the string allocated for the source.
+    void* data;
+    bool valid;
+  };
+
+  explicit ParallelSourceDecodingState(intptr_t capacity)
+      : sources_(capacity) {}
+
+  void Add(intptr_t index, const uint8_t* utf8, intptr_t utf8_length) {
+    sources_.Add({index, utf8, utf8_length, Utf8::kLatin1, 0, nullptr, true});
+  }
+  intptr_t length() const { return sources_.length(); }
+  Source& At(intptr_t i) { return sources_[i]; }
+
+  // Counts the code units of (or, if [decode], decodes) all sources on up to
+  // [num_tasks] helper threads and the calling thread.
+  void RunPass(bool decode, intptr_t num_tasks);
+
+  // Counts or decodes sources until all of them have been claimed.
+  void ProcessSources() {
+    for (intptr_t i = next_.fetch_add(1); i < sources_.length();
+         i = next_.fetch_add(1)) {
+      Source& source = sources_[i];
+      if (!decode_) {
+        source.length =
+            Utf8::CodeUnitCount(source.utf8, source.utf8_length, &source.type);
+      } else if (source.type == Utf8::kLatin1) {
+        source.valid = Utf8::DecodeToLatin1(
+            source.utf8, source.utf8_length,
+            reinterpret_cast<uint8_t*>(source.data), source.length);
+      } else {
+        source.valid = Utf8::DecodeToUTF16(
+            source.utf8, source.utf8_length,
+            reinterpret_cast<uint16_t*>(source.data), source.length);
+      }
+    }
+  }
+
+  void TaskStarted() {
+    MonitorLocker ml(&monitor_);
+    running_tasks_++;
+  }
+  void TaskFinished() {
+    MonitorLocker ml(&monitor_);
+    if (--running_tasks_ == 0) {
+      ml.Notify();
+    }
+  }
+  void WaitForTasks() {
+    MonitorLocker ml(&monitor_);
+    while (running_tasks_ > 0) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  MallocGrowableArray<Source> sources_;
+  bool decode_ = false;
+  RelaxedAtomic<intptr_t> next_ = {0};
+  Monitor monitor_;
+  intptr_t running_tasks_ = 0;
+};
+
+class ParallelSourceDecodingTask : public ThreadPool::Task {
+ public:
+  explicit ParallelSourceDecodingTask(ParallelSourceDecodingState* state)
+      : state_(state) {}
+
+  void Run() override {
+    state_->ProcessSources();
+    state_->TaskFinished();
+  }
+
+ private:
+  ParallelSourceDecodingState* const state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelSourceDecodingTask);
+};
+
+void ParallelSourceDecodingState::RunPass(bool decode, intptr_t num_tasks) {
+  decode_ = decode;
+  next_ = 0;
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    TaskStarted();
+    if (!Dart::thread_pool()->Run<ParallelSourceDecodingTask>(this)) {
+      TaskFinished();
+      break;
+    }
+  }
+  // Help with (or do all of) the sources.
+  ProcessSources();
+  WaitForTasks();
+}
+
+ArrayPtr KernelLoader::DecodeSourcesInParallel(intptr_t source_table_size) {
+  if (FLAG_kernel_loading_tasks <= 0) return Array::null();
+
+  // The kernel binary is external, so the sources do not move while they are
+  // decoded.
+  ParallelSourceDecodingState state(source_table_size);
+  intptr_t total_size = 0;
+  for (intptr_t index = 0; index < source_table_size; ++index) {
+    intptr_t size = 0;
+    const uint8_t* utf8 = helper_.GetSourceBytesFor(index, &size);
+    if (size == 0) continue;
+    state.Add(index, utf8, size);
+    total_size += size;
+  }
+  if (total_size < FLAG_kernel_parallel_decoding_min_bytes) {
+    return Array::null();
+  }
+
+  TIMELINE_DURATION(thread_, Isolate, "DecodeSources");
+  const intptr_t num_tasks =
+      Utils::Minimum<intptr_t>(FLAG_kernel_loading_tasks, state.length() - 1);
+  state.RunPass(/*decode=*/false, num_tasks);
+
+  const Array& sources =
+      Array::Handle(Z, Array::New(source_table_size, Heap::kOld));
+  String& string = String::Handle(Z);
+  for (intptr_t i = 0; i < state.length(); i++) {
+    const auto& source = state.At(i);
+    if (source.type == Utf8::kLatin1) {
+      string = OneByteString::New(source.length, Heap::kOld);
+    } else {
+      string = TwoByteString::New(source.length, Heap::kOld);
+    }
+    sources.SetAt(source.index, string);
+  }
+
+  {
+    // The helpers write into the strings, which must not move until they are
+    // done.
+    NoSafepointScope no_safepoint;
+    for (intptr_t i = 0; i < state.length(); i++) {
+      auto& source = state.At(i);
+      string ^= sources.At(source.index);
+      source.data = (source.type == Utf8::kLatin1)
+                        ? static_cast<void*>(OneByteString::DataStart(string))
+                        : static_cast<void*>(TwoByteString::DataStart(string));
+    }
+    state.RunPass(/*decode=*/true, num_tasks);
+  }
+
+  // Sources with invalid UTF-8 are decoded again by LoadScriptAt, which
+  // reports the error.
+  for (intptr_t i = 0; i < state.length(); i++) {
+    if (!state.At(i).valid) {
+      sources.SetAt(state.At(i).index, Object::null_object());
+    }
+  }
+  return sources.ptr();
+}
+
 KernelLoader::KernelLoader(const KernelProgramInfo& kernel_program_info,
                            const TypedDataBase& kernel_data,
                            intptr_t data_program_offset)
@@ -911,59 +1101,8 @@ void KernelLoader::FinishTopLevelClassLoading(
   helper_.SetOffset(library_index.ClassOffset(library_index.class_count()) +
                     correction);
 
-  const intptr_t extension_count = helper_.ReadListLength();
-  for (intptr_t i = 0; i < extension_count; ++i) {
-    helper_.ReadTag();                     // read tag.
-    helper_.SkipCanonicalNameReference();  // skip canonical name.
-    helper_.SkipStringReference();         // skip name.
-    helper_.SkipListOfExpressions();       // skip annotations.
-    helper_.ReadUInt();                    // read source uri index.
-    helper_.ReadPosition();                // read file offset.
-    helper_.ReadByte();                    // skip flags.
-    helper_.SkipTypeParametersList();      // skip type parameter list.
-    helper_.SkipDartType();                // skip on-type.
-
-    const intptr_t extension_member_count = helper_.ReadListLength();
-    for (intptr_t j = 0; j < extension_member_count; ++j) {
-      helper_.SkipName();                    // skip name.
-      helper_.ReadByte();                    // read kind.
-      helper_.ReadByte();                    // read flags.
-      helper_.SkipCanonicalNameReference();  // skip member reference
-      helper_.SkipCanonicalNameReference();  // skip tear-off reference
-    }
-  }
-
-  const intptr_t extension_type_declaration_count = helper_.ReadListLength();
-  for (intptr_t i = 0; i < extension_type_declaration_count; ++i) {
-    helper_.ReadTag();                     // read tag.
-    helper_.SkipCanonicalNameReference();  // skip canonical name.
-    helper_.SkipStringReference();         // skip name.
-    helper_.SkipListOfExpressions();       // skip annotations.
-    helper_.ReadUInt();                    // read source uri index.
-    helper_.ReadPosition();                // read file offset.
-    helper_.ReadByte();                    // skip flags.
-    helper_.SkipTypeParametersList();      // skip type parameter list.
-    helper_.SkipDartType();                // skip declared representation type.
-    helper_.SkipStringReference();         // skip representation name.
-    helper_.SkipListOfDartTypes();         // skip implements types.
-
-    // Skip extension type procedures.
-    const intptr_t extension_type_procedure_count =
-        helper_.ReadListLength();  // read list length.
-    for (intptr_t i = 0; i < extension_type_procedure_count; ++i) {
-      ProcedureHelper procedure_helper(&helper_);
-      procedure_helper.ReadUntilExcluding(ProcedureHelper::kEnd);
-    }
-
-    const intptr_t extension_type_member_count = helper_.ReadListLength();
-    for (intptr_t j = 0; j < extension_type_member_count; ++j) {
-      helper_.SkipName();                    // skip name.
-      helper_.ReadByte();                    // read kind.
-      helper_.ReadByte();                    // read flags.
-      helper_.SkipCanonicalNameReference();  // skip member reference
-      helper_.SkipCanonicalNameReference();  // skip tear-off reference
-    }
-  }
+  helper_.SkipListOfExtensions();
+  helper_.SkipListOfExtensionTypeDeclarations();
 
   fields_.Clear();
   functions_.Clear();
@@ -1948,7 +2087,8 @@ const Object& KernelLoader::ClassForScriptAt(const Class& klass,
 }
 
 ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
-                                     UriToSourceTable* uri_to_source_table) {
+                                     UriToSourceTable* uri_to_source_table,
+                                     const String& decoded_source) {
   const String& uri_string = helper_.SourceTableUriFor(index);
   const String& import_uri_string = helper_.SourceTableImportUriFor(index);
   auto& constant_coverage = TypedDataView::Handle(Z);
@@ -1968,7 +2108,9 @@ ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
   }
 
   if (sources.IsNull() || line_starts.IsNull()) {
-    const String& script_source = helper_.GetSourceFor(index);
+    const String& script_source = decoded_source.IsNull()
+                                      ? helper_.GetSourceFor(index)
+                                      : decoded_source;
     line_starts = helper_.GetLineStartsFor(index);
 
     if (script_source.ptr() == Symbols::Empty().ptr() &&
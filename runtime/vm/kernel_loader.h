@@ -326,7 +326,14 @@ class KernelLoader : public ValueObject {
 
   ScriptPtr LoadScriptAt(
       intptr_t index,
-      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table);
+      DirectChainedHashMap<UriToSourceTableTrait>* uri_to_source_table,
+      const String& decoded_source);
+
+  // Decodes the sources of the program's source table on helper threads (see
+  // --kernel_loading_tasks). Returns an array with the source of each entry,
+  // null for entries that were not decoded, or null if the program's sources
+  // are too small to be worth decoding in parallel.
+  ArrayPtr DecodeSourcesInParallel(intptr_t source_table_size);
 
   // If klass's script is not the script at the uri index, return a PatchClass
   // for klass whose script corresponds to the uri index.
@@ -0,0 +1,130 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+DECLARE_FLAG(int, kernel_loading_tasks);
+DECLARE_FLAG(int, kernel_parallel_decoding_min_bytes);
+
+static const char* kMainUri = RESOLVED_USER_TEST_URI;
+static const char* kLibraryUri = "file:///library.dart";
+static const char* kInvalidUri = "file:///invalid.dart";
+
+static const char* kMainChars =
+    "import 'file:///library.dart';\n"
+    "import 'file:///invalid.dart';\n"
+    "main() => latin1() + twoByte() + invalid();\n";
+static const char* kLibraryChars =
+    "String latin1() => 'Caf\xC3\xA9';\n"
+    "String twoByte() => '\xE2\x82\xAC \xF0\x9F\x98\x80';\n";
+// The marker is replaced with an invalid UTF-8 byte in the kernel binary.
+static const char* kInvalidChars =
+    "// INVALID_UTF8\n"
+    "String invalid() => '';\n";
+
+// Loads [kernel] into a new isolate and returns the source of the script at
+// each of [uris], or "null" for a script without source.
+static void LoadScriptSources(const uint8_t* kernel,
+                              intptr_t kernel_size,
+                              const char** uris,
+                              intptr_t count,
+                              char** sources) {
+  TestCase::CreateTestIsolate();
+  Dart_EnterScope();
+  EXPECT_VALID(Dart_LoadScriptFromKernel(kernel, kernel_size));
+  {
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    auto& uri = String::Handle();
+    auto& library = Library::Handle();
+    auto& script = Script::Handle();
+    auto& source = String::Handle();
+    for (intptr_t i = 0; i < count; i++) {
+      uri = String::New(uris[i]);
+      library = Library::LookupLibrary(thread, uri);
+      EXPECT(!library.IsNull());
+      script = library.LookupScript(uri, /*useResolvedUri=*/true);
+      EXPECT(!script.IsNull());
+      source = script.Source();
+      sources[i] =
+          Utils::StrDup(source.IsNull() ? "null" : source.ToCString());
+    }
+  }
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+}
+
+VM_UNIT_TEST_CASE(KernelLoader_ParallelSourceDecoding) {
+  Dart_SourceFile sourcefiles[] = {
+      {kMainUri, kMainChars},
+      {kLibraryUri, kLibraryChars},
+      {kInvalidUri, kInvalidChars},
+  };
+  const intptr_t kNumSources = ARRAY_SIZE(sourcefiles);
+
+  uint8_t* kernel = nullptr;
+  intptr_t kernel_size = 0;
+  {
+    TestIsolateScope __test_isolate__;
+    const uint8_t* kernel_buffer = nullptr;
+    char* error = TestCase::CompileTestScriptWithDFE(
+        kMainUri, kNumSources, sourcefiles, &kernel_buffer, &kernel_size,
+        /*incrementally=*/false);
+    EXPECT(error == nullptr);
+    kernel = reinterpret_cast<uint8_t*>(malloc(kernel_size));
+    memmove(kernel, kernel_buffer, kernel_size);
+    free(const_cast<uint8_t*>(kernel_buffer));
+  }
+
+  const char* kMarker = "INVALID_UTF8";
+  const intptr_t marker_length = strlen(kMarker);
+  bool found = false;
+  for (intptr_t i = 0; i + marker_length <= kernel_size; i++) {
+    if (memcmp(kernel + i, kMarker, marker_length) == 0) {
+      kernel[i] = 0xFF;
+      found = true;
+      break;
+    }
+  }
+  EXPECT(found);
+
+  char* sequential[kNumSources];
+  {
+    SetFlagScope<int> tasks(&FLAG_kernel_loading_tasks, 0);
+    LoadScriptSources(kernel, kernel_size, &sourcefiles[0].uri, kNumSources,
+                      sequential);
+  }
+  char* parallel[kNumSources];
+  {
+    // The sources are decoded on helper threads although they are small.
+    SetFlagScope<int> tasks(&FLAG_kernel_loading_tasks, 4);
+    SetFlagScope<int> min_bytes(&FLAG_kernel_parallel_decoding_min_bytes, 0);
+    LoadScriptSources(kernel, kernel_size, &sourcefiles[0].uri, kNumSources,
+                      parallel);
+  }
+
+  EXPECT_STREQ(kMainChars, sequential[0]);
+  EXPECT_STREQ(kLibraryChars, sequential[1]);
+  // The invalid source is decoded again on the main thread, which drops it.
+  EXPECT_STREQ("null", sequential[2]);
+  for (intptr_t i = 0; i < kNumSources; i++) {
+    EXPECT_STREQ(sequential[i], parallel[i]);
+    free(sequential[i]);
+    free(parallel[i]);
+  }
+  free(kernel);
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
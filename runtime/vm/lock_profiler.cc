@@ -0,0 +1,345 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/lock_profiler.h"
+
+#include "platform/address_sanitizer.h"
+#include "platform/memory_sanitizer.h"
+#include "platform/synchronization.h"
+#include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/hash.h"
+#include "vm/hash_map.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+#include "vm/native_symbol.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
+#include "vm/timeline.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            profile_lock_contention,
+            false,
+            "Record contended acquisitions and long critical sections of "
+            "named VM locks.");
+DEFINE_FLAG(int,
+            lock_hold_threshold_micros,
+            1000,
+            "Critical sections of named locks longer than this many "
+            "microseconds are recorded by the lock contention profiler.");
+
+// Number of frames recorded per stack, and the number of innermost frames
+// above CollectStack that belong to the profiler and the lock implementation:
+// Record, the LockContentionRecorder method and the Mutex or
+// ConditionVariable method that reported to it.
+static constexpr intptr_t kMaxFrames = 16;
+static constexpr intptr_t kSkippedFrames = 3;
+
+// The contention of one kind on one lock from one stack.
+struct ContentionSite {
+  const char* lock;
+  bool is_wait;
+  intptr_t length;
+  uword pcs[kMaxFrames];
+  intptr_t count;
+  int64_t total_micros;
+  int64_t max_micros;
+
+  uword Hash() const {
+    uint32_t hash = Utils::StringHash(lock, strlen(lock));
+    hash = CombineHashes(hash, is_wait ? 1 : 0);
+    for (intptr_t i = 0; i < length; i++) {
+      hash = CombineHashes(hash, static_cast<uint32_t>(pcs[i]));
+    }
+    return FinalizeHash(hash);
+  }
+
+  bool Equals(const ContentionSite& other) const {
+    return (is_wait == other.is_wait) && (length == other.length) &&
+           (strcmp(lock, other.lock) == 0) &&
+           (memcmp(pcs, other.pcs, length * sizeof(uword)) == 0);
+  }
+};
+
+using ContentionSites =
+    MallocDirectChainedHashMap<PointerSetKeyValueTrait<ContentionSite>>;
+
+// Protects |sites|, which is nullptr while the profiler is disabled.
+static Mutex* sites_mutex = new Mutex();
+static ContentionSites* sites = nullptr;
+// Set while recording, so that locks taken by the recorder itself (for
+// example by the timeline) are not recorded.
+static thread_local bool recording = false;
+
+static void ClearSitesLocked() {
+  ASSERT(sites_mutex->IsOwnedByCurrentThread());
+  ContentionSites::Iterator it = sites->GetIterator();
+  while (ContentionSite** site = it.Next()) {
+    delete *site;
+  }
+  sites->Clear();
+}
+
+// Collects the return addresses of the current thread's native stack, outside
+// of the profiler and the lock implementation.
+DART_NOINLINE
+NO_SANITIZE_ADDRESS
+NO_SANITIZE_MEMORY
+static intptr_t CollectStack(uword* pcs) {
+  OSThread* os_thread = OSThread::TryCurrent();
+  if (os_thread == nullptr) return 0;
+  const uword lower = os_thread->stack_limit();
+  const uword upper = os_thread->stack_base();
+  uword* fp = reinterpret_cast<uword*>(GET_FP_REGISTER());
+  intptr_t frame = 0;
+  intptr_t length = 0;
+  while (length < kMaxFrames) {
+    const uword address = reinterpret_cast<uword>(fp);
+    if (!Utils::IsAligned(address, kWordSize) || (address < lower) ||
+        (address + kWordSize >= upper)) {
+      break;
+    }
+    const uword pc = fp[kHostSavedCallerPcSlotFromFp];
+    uword* caller_fp =
+        reinterpret_cast<uword*>(fp[kHostSavedCallerFpSlotFromFp]);
+    if (pc == 0) break;
+    if (frame++ >= kSkippedFrames) {
+      pcs[length++] = pc;
+    }
+    if (caller_fp <= fp) break;
+    fp = caller_fp;
+  }
+  return length;
+}
+
+// Not inlined, so that the frames to skip are known.
+DART_NOINLINE
+static void Record(const Mutex& mutex,
+                   bool is_wait,
+                   int64_t start_micros,
+                   int64_t end_micros) {
+  if (recording) return;
+  recording = true;
+
+  ContentionSite key;
+  key.lock = mutex.name();
+  key.is_wait = is_wait;
+  key.length = CollectStack(key.pcs);
+  const int64_t micros = end_micros - start_micros;
+  {
+    MutexLocker ml(sites_mutex);
+    if (sites != nullptr) {
+      ContentionSite* site = sites->LookupValue(&key);
+      if (site == nullptr) {
+        site = new ContentionSite(key);
+        site->count = 0;
+        site->total_micros = 0;
+        site->max_micros = 0;
+        sites->Insert(site);
+      }
+      site->count++;
+      site->total_micros += micros;
+      site->max_micros = Utils::Maximum(site->max_micros, micros);
+    }
+  }
+
+#if defined(SUPPORT_TIMELINE)
+  TimelineStream* stream = Timeline::GetVMStream();
+  if (stream->enabled()) {
+    TimelineEvent* event = stream->StartEvent();
+    if (event != nullptr) {
+      event->Duration(mutex.name(), start_micros, end_micros);
+      event->SetNumArguments(1);
+      event->CopyArgument(0, "contention", is_wait ? "wait" : "hold");
+      event->Complete();
+    }
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+
+  recording = false;
+}
+
+class LockContentionRecorder : public LockContentionObserver {
+ public:
+  int64_t CurrentMicros() override { return OS::GetCurrentMonotonicMicros(); }
+
+  void Contended(const Mutex& mutex,
+                 int64_t wait_start_micros,
+                 int64_t acquired_micros) override {
+    Record(mutex, /*is_wait=*/true, wait_start_micros, acquired_micros);
+  }
+
+  void Released(const Mutex& mutex,
+                int64_t acquired_micros,
+                int64_t released_micros,
+                bool contended) override {
+    if (!contended &&
+        (released_micros - acquired_micros < FLAG_lock_hold_threshold_micros)) {
+      return;
+    }
+    Record(mutex, /*is_wait=*/false, acquired_micros, released_micros);
+  }
+};
+
+// Never deleted, because threads might still report to it after it has been
+// removed.
+static LockContentionRecorder* recorder = new LockContentionRecorder();
+
+void LockProfiler::Init() {
+  if (FLAG_profile_lock_contention) {
+    SetEnabled(true);
+  }
+}
+
+void LockProfiler::Cleanup() {
+  SetEnabled(false);
+}
+
+bool LockProfiler::IsEnabled() {
+  MutexLocker ml(sites_mutex);
+  return sites != nullptr;
+}
+
+void LockProfiler::SetEnabled(bool enabled) {
+  MutexLocker ml(sites_mutex);
+  if (enabled == (sites != nullptr)) return;
+  if (enabled) {
+    sites = new ContentionSites();
+    Mutex::SetContentionObserver(recorder);
+  } else {
+    Mutex::SetContentionObserver(nullptr);
+    ClearSitesLocked();
+    delete sites;
+    sites = nullptr;
+  }
+}
+
+void LockProfiler::Clear() {
+  MutexLocker ml(sites_mutex);
+  if (sites != nullptr) {
+    ClearSitesLocked();
+  }
+}
+
+#if !defined(PRODUCT)
+
+// The contention of all sites of one lock.
+struct LockSummary {
+  const char* lock;
+  intptr_t waits;
+  int64_t wait_micros;
+  int64_t max_wait_micros;
+  intptr_t holds;
+  int64_t hold_micros;
+  int64_t max_hold_micros;
+};
+
+// Orders by descending total time.
+static int CompareSites(const ContentionSite* a, const ContentionSite* b) {
+  if (a->total_micros == b->total_micros) return 0;
+  return a->total_micros > b->total_micros ? -1 : 1;
+}
+
+// Orders by descending time spent waiting, then by descending time held.
+static int CompareLocks(const LockSummary* a, const LockSummary* b) {
+  if (a->wait_micros != b->wait_micros) {
+    return a->wait_micros > b->wait_micros ? -1 : 1;
+  }
+  if (a->hold_micros == b->hold_micros) return 0;
+  return a->hold_micros > b->hold_micros ? -1 : 1;
+}
+
+void LockProfiler::PrintJSON(JSONStream* js) {
+  // Copy the sites, so that threads can keep recording while their stacks are
+  // symbolized.
+  MallocGrowableArray<ContentionSite> copies;
+  bool enabled;
+  {
+    MutexLocker ml(sites_mutex);
+    enabled = sites != nullptr;
+    if (enabled) {
+      ContentionSites::Iterator it = sites->GetIterator();
+      while (ContentionSite** site = it.Next()) {
+        copies.Add(**site);
+      }
+    }
+  }
+  copies.Sort(CompareSites);
+
+  MallocGrowableArray<LockSummary> locks;
+  for (intptr_t i = 0; i < copies.length(); i++) {
+    const ContentionSite& site = copies[i];
+    LockSummary* summary = nullptr;
+    for (intptr_t j = 0; j < locks.length(); j++) {
+      if (strcmp(locks[j].lock, site.lock) == 0) {
+        summary = &locks[j];
+        break;
+      }
+    }
+    if (summary == nullptr) {
+      locks.Add({site.lock, 0, 0, 0, 0, 0, 0});
+      summary = &locks.Last();
+    }
+    if (site.is_wait) {
+      summary->waits += site.count;
+      summary->wait_micros += site.total_micros;
+      summary->max_wait_micros =
+          Utils::Maximum(summary->max_wait_micros, site.max_micros);
+    } else {
+      summary->holds += site.count;
+      summary->hold_micros += site.total_micros;
+      summary->max_hold_micros =
+          Utils::Maximum(summary->max_hold_micros, site.max_micros);
+    }
+  }
+  locks.Sort(CompareLocks);
+
+  JSONObject jsobj(js);
+  jsobj.AddProperty("type", "_LockContentionProfile");
+  jsobj.AddProperty("enabled", enabled);
+  jsobj.AddProperty64("holdThresholdMicros", FLAG_lock_hold_threshold_micros);
+  {
+    JSONArray locks_array(&jsobj, "locks");
+    for (intptr_t i = 0; i < locks.length(); i++) {
+      const LockSummary& summary = locks[i];
+      JSONObject lock(&locks_array);
+      lock.AddProperty("name", summary.lock);
+      lock.AddProperty64("waits", summary.waits);
+      lock.AddProperty64("waitMicros", summary.wait_micros);
+      lock.AddProperty64("maxWaitMicros", summary.max_wait_micros);
+      lock.AddProperty64("holds", summary.holds);
+      lock.AddProperty64("holdMicros", summary.hold_micros);
+      lock.AddProperty64("maxHoldMicros", summary.max_hold_micros);
+    }
+  }
+  JSONArray sites_array(&jsobj, "sites");
+  for (intptr_t i = 0; i < copies.length(); i++) {
+    const ContentionSite& site = copies[i];
+    JSONObject site_object(&sites_array);
+    site_object.AddProperty("lock", site.lock);
+    site_object.AddProperty("kind", site.is_wait ? "wait" : "hold");
+    site_object.AddProperty64("count", site.count);
+    site_object.AddProperty64("totalMicros", site.total_micros);
+    site_object.AddProperty64("maxMicros", site.max_micros);
+    JSONArray stack(&site_object, "stack");
+    for (intptr_t j = 0; j < site.length; j++) {
+      uword start = 0;
+      const char* name = NativeSymbolResolver::LookupSymbolName(
+          site.pcs[j], &start);
+      if (name != nullptr) {
+        stack.AddValueF("%s+0x%" Px, name, site.pcs[j] - start);
+        NativeSymbolResolver::FreeSymbolName(name);
+      } else {
+        stack.AddValueF("0x%" Px, site.pcs[j]);
+      }
+    }
+  }
+}
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
@@ -0,0 +1,46 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_LOCK_PROFILER_H_
+#define RUNTIME_VM_LOCK_PROFILER_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class JSONStream;
+
+// Profiles contention on the VM's named locks (see Mutex::Mutex).
+//
+// While enabled, every acquisition of a named Mutex or Monitor that had to
+// wait for another thread is recorded with the native stack of the waiting
+// thread, and every critical section that made another thread wait or took
+// longer than --lock_hold_threshold_micros is recorded with the native stack
+// of the holding thread. Reacquiring a Monitor after Wait counts as waiting
+// from the notification or timeout. Records of the same lock, kind and stack
+// are aggregated. When the VM timeline stream is enabled, each record is also
+// written as a duration event named after the lock.
+class LockProfiler : public AllStatic {
+ public:
+  // Enables the profiler if --profile_lock_contention is set.
+  static void Init();
+  static void Cleanup();
+
+  static bool IsEnabled();
+  static void SetEnabled(bool enabled);
+
+  // Discards all records.
+  static void Clear();
+
+#if !defined(PRODUCT)
+  // Prints the records as a _LockContentionProfile, with the locks and stacks
+  // that caused the most waiting first.
+  static void PrintJSON(JSONStream* js);
+#endif  // !defined(PRODUCT)
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_LOCK_PROFILER_H_
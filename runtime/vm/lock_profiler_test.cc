@@ -0,0 +1,169 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/lock_profiler.h"
+
+#include <atomic>
+
+#include "platform/assert.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+static const char* kWaitRecord =
+    "\"lock\":\"LockProfilerTest::mutex\",\"kind\":\"wait\"";
+static const char* kHoldRecord =
+    "\"lock\":\"LockProfilerTest::mutex\",\"kind\":\"hold\"";
+
+struct ContendingThreadArguments {
+  Monitor monitor;
+  Mutex* mutex;
+  std::atomic<bool> done = false;
+  ThreadJoinId join_id = OSThread::kInvalidThreadJoinId;
+};
+
+static void ContendingThreadMain(uword parameters) {
+  auto arguments = reinterpret_cast<ContendingThreadArguments*>(parameters);
+  while (!arguments->done.load()) {
+    arguments->mutex->Lock();
+    arguments->mutex->Unlock();
+  }
+  MonitorLocker ml(&arguments->monitor);
+  arguments->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  ml.Notify();
+}
+
+static bool HasLockProfileRecord(const char* record) {
+  JSONStream js;
+  LockProfiler::PrintJSON(&js);
+  return strstr(js.ToCString(), record) != nullptr;
+}
+
+ISOLATE_UNIT_TEST_CASE(LockProfiler_RecordsContention) {
+  LockProfiler::SetEnabled(true);
+
+  Mutex mutex("LockProfilerTest::mutex");
+  ContendingThreadArguments arguments;
+  arguments.mutex = &mutex;
+  OSThread::Start("ContendingThread", ContendingThreadMain,
+                  reinterpret_cast<uword>(&arguments));
+
+  // Hold the mutex longer than the threshold until the other thread has
+  // been recorded waiting for it.
+  const int64_t deadline =
+      OS::GetCurrentMonotonicMicros() + 10 * kMicrosecondsPerSecond;
+  bool recorded_wait = false;
+  while (!recorded_wait && OS::GetCurrentMonotonicMicros() < deadline) {
+    {
+      MutexLocker ml(&mutex);
+      OS::SleepMicros(2 * kMicrosecondsPerMillisecond);
+    }
+    recorded_wait = HasLockProfileRecord(kWaitRecord);
+  }
+  EXPECT(recorded_wait);
+
+  arguments.done.store(true);
+  {
+    MonitorLocker ml(&arguments.monitor);
+    while (arguments.join_id == OSThread::kInvalidThreadJoinId) {
+      ml.Wait();
+    }
+  }
+  OSThread::Join(arguments.join_id);
+
+  {
+    JSONStream js;
+    LockProfiler::PrintJSON(&js);
+    const char* json = js.ToCString();
+    EXPECT_SUBSTRING("\"type\":\"_LockContentionProfile\"", json);
+    EXPECT_SUBSTRING("\"name\":\"LockProfilerTest::mutex\"", json);
+    EXPECT_SUBSTRING(kWaitRecord, json);
+    // The critical sections are longer than the threshold.
+    EXPECT_SUBSTRING(kHoldRecord, json);
+    // Stacks start at the caller of the lock.
+    EXPECT_NOTSUBSTRING("LockContentionRecorder", json);
+    EXPECT_NOTSUBSTRING("dart::Mutex::", json);
+  }
+
+  LockProfiler::Clear();
+  {
+    JSONStream js;
+    LockProfiler::PrintJSON(&js);
+    EXPECT_NOTSUBSTRING("LockProfilerTest::mutex", js.ToCString());
+  }
+
+  LockProfiler::SetEnabled(false);
+  EXPECT(!LockProfiler::IsEnabled());
+}
+
+struct WaitingThreadArguments {
+  Monitor* monitor;
+  bool done = false;
+  ThreadJoinId join_id = OSThread::kInvalidThreadJoinId;
+};
+
+static void WaitingThreadMain(uword parameters) {
+  auto arguments = reinterpret_cast<WaitingThreadArguments*>(parameters);
+  MonitorLocker ml(arguments->monitor);
+  while (!arguments->done) {
+    ml.Wait();
+  }
+  arguments->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  ml.Notify();
+}
+
+ISOLATE_UNIT_TEST_CASE(LockProfiler_RecordsReacquisitionAfterWait) {
+  LockProfiler::SetEnabled(true);
+
+  Monitor monitor("LockProfilerTest::monitor");
+  WaitingThreadArguments arguments;
+  arguments.monitor = &monitor;
+  OSThread::Start("WaitingThread", WaitingThreadMain,
+                  reinterpret_cast<uword>(&arguments));
+
+  // Keep the monitor after notifying until the other thread has been
+  // recorded waiting to reacquire it.
+  const char* kReacquireRecord =
+      "\"lock\":\"LockProfilerTest::monitor\",\"kind\":\"wait\"";
+  const int64_t deadline =
+      OS::GetCurrentMonotonicMicros() + 10 * kMicrosecondsPerSecond;
+  bool recorded_wait = false;
+  while (!recorded_wait && OS::GetCurrentMonotonicMicros() < deadline) {
+    {
+      MonitorLocker ml(&monitor);
+      ml.Notify();
+      OS::SleepMicros(2 * kMicrosecondsPerMillisecond);
+    }
+    recorded_wait = HasLockProfileRecord(kReacquireRecord);
+  }
+  EXPECT(recorded_wait);
+  {
+    JSONStream js;
+    LockProfiler::PrintJSON(&js);
+    EXPECT_NOTSUBSTRING("dart::ConditionVariable::", js.ToCString());
+  }
+
+  {
+    MonitorLocker ml(&monitor);
+    arguments.done = true;
+    ml.Notify();
+    while (arguments.join_id == OSThread::kInvalidThreadJoinId) {
+      ml.Wait();
+    }
+  }
+  OSThread::Join(arguments.join_id);
+
+  LockProfiler::Clear();
+  LockProfiler::SetEnabled(false);
+}
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
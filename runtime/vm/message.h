@@ -125,6 +125,11 @@ class Message {
     }
   }
 
+  // Monotonic time at which the message was posted, if the receiving handler
+  // records event loop latency (see EventLoopStats), otherwise 0.
+  int64_t posted_micros() const { return posted_micros_; }
+  void set_posted_micros(int64_t micros) { posted_micros_ = micros; }
+
  private:
   static intptr_t const kPersistentHandleSnapshotLen = -1;
   static intptr_t const kFinalizerSnapshotLen = -2;
@@ -146,6 +151,7 @@ class Message {
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
   Priority priority_;
+  int64_t posted_micros_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
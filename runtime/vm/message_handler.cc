@@ -7,6 +7,7 @@
 #include "vm/message_handler.h"
 
 #include "vm/dart.h"
+#include "vm/event_loop_stats.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
@@ -18,6 +19,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, record_event_loop_latency);
 DECLARE_FLAG(bool, trace_service_pause_events);
 
 class MessageHandlerTask : public ThreadPool::Task {
@@ -67,7 +69,9 @@ MessageHandler::MessageHandler()
       task_running_(false),
       pool_(nullptr),
       end_callback_(nullptr),
-      callback_data_(0) {
+      callback_data_(0),
+      event_loop_stats_(FLAG_record_event_loop_latency ? new EventLoopStats()
+                                                       : nullptr) {
   ASSERT(queue_ != nullptr);
   ASSERT(oob_queue_ != nullptr);
 }
@@ -78,6 +82,8 @@ MessageHandler::~MessageHandler() {
   queue_ = nullptr;
   oob_queue_ = nullptr;
   pool_ = nullptr;
+  delete event_loop_stats_;
+  event_loop_stats_ = nullptr;
 }
 
 const char* MessageHandler::name() const {
@@ -148,6 +154,9 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
     }
 
     saved_priority = message->priority();
+    if ((event_loop_stats_ != nullptr) && !message->IsOOB()) {
+      message->set_posted_micros(OS::GetCurrentMonotonicMicros());
+    }
     if (message->IsOOB()) {
       oob_queue_->Enqueue(std::move(message), before_events);
     } else {
@@ -221,10 +230,18 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
     ml->Exit();
     Message::Priority saved_priority = message->priority();
     Dart_Port saved_dest_port = message->dest_port();
+    const int64_t posted_micros = message->posted_micros();
     MessageStatus status = kOK;
     {
       DisableIdleTimerScope disable_idle_timer(idle_time_handler);
-      status = HandleMessage(std::move(message));
+      if ((event_loop_stats_ != nullptr) && (posted_micros != 0)) {
+        const int64_t start_micros = OS::GetCurrentMonotonicMicros();
+        status = HandleMessage(std::move(message));
+        event_loop_stats_->RecordMessage(posted_micros, start_micros,
+                                         OS::GetCurrentMonotonicMicros());
+      } else {
+        status = HandleMessage(std::move(message));
+      }
     }
     if (status > max_status) {
       max_status = status;
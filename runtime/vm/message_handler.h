@@ -17,6 +17,8 @@
 
 namespace dart {
 
+class EventLoopStats;
+
 // A MessageHandler is an entity capable of accepting messages.
 class MessageHandler : public PortHandler {
  protected:
@@ -88,6 +90,10 @@ class MessageHandler : public PortHandler {
 
   MessageCount GetMessageCounts();
 
+  // The latency histograms of this handler's event loop, or nullptr if
+  // --record_event_loop_latency was not set when the handler was created.
+  EventLoopStats* event_loop_stats() const { return event_loop_stats_; }
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
@@ -231,6 +237,7 @@ class MessageHandler : public PortHandler {
   ThreadPool* pool_;
   EndCallback end_callback_;
   CallbackData callback_data_;
+  EventLoopStats* event_loop_stats_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageHandler);
 };
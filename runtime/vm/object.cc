@@ -13,6 +13,7 @@
 #include "platform/text_buffer.h"
 #include "platform/unaligned.h"
 #include "platform/unicode.h"
+#include "vm/app_snapshot.h"
 #include "vm/bit_vector.h"
 #include "vm/bootstrap.h"
 #include "vm/bytecode_reader.h"
@@ -18150,6 +18151,12 @@ void Code::set_owner(const Object& owner) const {
   untag()->set_owner(owner.ptr());
 }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+CodeSourceMapPtr Code::MaterializeCodeSourceMap() const {
+  return LazySnapshotObjects::MaterializeCodeSourceMap(*this);
+}
+#endif
+
 void Code::set_state_bits(intptr_t bits) const {
   StoreNonPointer(&untag()->state_bits_, bits);
 }
@@ -24193,6 +24200,17 @@ bool String::Equals(const String& str,
     return false;  // Lengths don't match.
   }
 
+  // memcmp is vectorized by the C library, unlike the loop below.
+  if (IsOneByteString() && str.IsOneByteString()) {
+    return memcmp(OneByteString::DataStart(*this),
+                  OneByteString::DataStart(str) + begin_index, len) == 0;
+  }
+  if (IsTwoByteString() && str.IsTwoByteString()) {
+    return memcmp(TwoByteString::DataStart(*this),
+                  TwoByteString::DataStart(str) + begin_index,
+                  len * kTwoByteChar) == 0;
+  }
+
   for (intptr_t i = 0; i < len; i++) {
     if (CharAt(i) != str.CharAt(begin_index + i)) {
       return false;
@@ -24229,6 +24247,10 @@ bool String::Equals(const uint8_t* latin1_array, intptr_t len) const {
     return false;
   }
 
+  if (IsOneByteString()) {
+    return memcmp(OneByteString::DataStart(*this), latin1_array, len) == 0;
+  }
+
   for (intptr_t i = 0; i < len; i++) {
     if (this->CharAt(i) != latin1_array[i]) {
       return false;
@@ -24279,6 +24301,15 @@ intptr_t String::CompareTo(const String& other) const {
   const intptr_t this_len = this->Length();
   const intptr_t other_len = other.IsNull() ? 0 : other.Length();
   const intptr_t len = (this_len < other_len) ? this_len : other_len;
+  if (IsOneByteString() && !other.IsNull() && other.IsOneByteString()) {
+    // Bytes compare as unsigned, which is the code unit order.
+    const int result = memcmp(OneByteString::DataStart(*this),
+                              OneByteString::DataStart(other), len);
+    if (result != 0) return (result < 0) ? -1 : 1;
+    if (this_len < other_len) return -1;
+    if (this_len > other_len) return 1;
+    return 0;
+  }
   for (intptr_t i = 0; i < len; i++) {
     uint16_t this_code_unit = this->CharAt(i);
     uint16_t other_code_unit = other.CharAt(i);
@@ -24320,6 +24351,10 @@ bool String::EndsWith(const String& other) const {
   if ((other_len == 0) || (other_len > len)) {
     return false;
   }
+  if (IsOneByteString() && other.IsOneByteString()) {
+    return memcmp(OneByteString::DataStart(*this) + offset,
+                  OneByteString::DataStart(other), other_len) == 0;
+  }
   for (int i = offset; i < len; i++) {
     if (this->CharAt(i) != other.CharAt(i - offset)) {
       return false;
@@ -27309,6 +27344,10 @@ void RegExp::set_bytecode(bool is_one_byte,
   }
 }
 
+void RegExp::set_literal_prefix(const TypedData& prefix) const {
+  untag()->set_literal_prefix(prefix.ptr());
+}
+
 void RegExp::set_capture_name_map(const Array& array) const {
   untag()->set_capture_name_map<std::memory_order_release>(array.ptr());
 }
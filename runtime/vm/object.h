@@ -7123,7 +7123,16 @@ class Code : public Object {
     untag()->set_pc_descriptors(descriptors.ptr());
   }
 
+  // With --lazy_snapshot_clusters=CodeSourceMap, the map may still be in the
+  // snapshot, so this can allocate and must not be called in a
+  // NoSafepointScope.
   CodeSourceMapPtr code_source_map() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+    // Left in the snapshot by --lazy_snapshot_clusters.
+    if (untag()->code_source_map()->IsSmi()) [[unlikely]] {
+      return MaterializeCodeSourceMap();
+    }
+#endif
     return untag()->code_source_map();
   }
 
@@ -7465,6 +7474,10 @@ class Code : public Object {
  private:
   void set_state_bits(intptr_t bits) const;
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+  CodeSourceMapPtr MaterializeCodeSourceMap() const;
+#endif
+
   friend class UntaggedObject;  // For UntaggedObject::SizeFromClass().
   friend class UntaggedCode;
   friend struct RelocatorTestHelper;
@@ -13294,7 +13307,13 @@ class RegExp : public Instance {
     return Function::null();
   }
 
+  // The Uint16 code units every match of the pattern starts with, used to
+  // skip to candidate positions before running the bytecode. Set before the
+  // bytecode is published and null if the pattern has no such prefix.
+  TypedDataPtr literal_prefix() const { return untag()->literal_prefix(); }
+
   void set_pattern(const String& pattern) const;
+  void set_literal_prefix(const TypedData& prefix) const;
   void set_bytecode(bool is_one_byte,
                     bool sticky,
                     const TypedData& bytecode) const;
@@ -573,6 +573,8 @@ void ObjectStore::LazyInitIsolateMembers() {
   if (lookup_port_handler_.load() == Type::null()) {
     ASSERT(lookup_open_ports_.load() == Type::null());
     ASSERT(handle_message_function_.load() == Type::null());
+    ASSERT(handle_message_without_microtasks_function_.load() ==
+           Type::null());
 
     auto* const zone = thread->zone();
     const auto& isolate_lib = Library::Handle(zone, Library::IsolateLibrary());
@@ -607,6 +609,11 @@ void ObjectStore::LazyInitIsolateMembers() {
     function = cls.LookupFunctionAllowPrivate(Symbols::_handleMessage());
     ASSERT(!function.IsNull());
     handle_message_function_.store(function.ptr());
+
+    function = cls.LookupFunctionAllowPrivate(
+        Symbols::_handleMessageWithoutMicrotasks());
+    ASSERT(!function.IsNull());
+    handle_message_without_microtasks_function_.store(function.ptr());
   }
 }
 
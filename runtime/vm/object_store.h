@@ -75,6 +75,7 @@ class ObjectPointerVisitor;
   LAZY_ISOLATE(Function, lookup_port_handler)                                  \
   LAZY_ISOLATE(Function, lookup_open_ports)                                    \
   LAZY_ISOLATE(Function, handle_message_function)                              \
+  LAZY_ISOLATE(Function, handle_message_without_microtasks_function)           \
   RW(Class, object_class)                                                      \
   RW(Type, object_type)                                                        \
   RW(Type, non_nullable_object_type)                                           \
@@ -215,12 +216,16 @@ class ObjectPointerVisitor;
   RW(GrowableObjectArray, ffi_callback_code)                                   \
   ARW_AR(Class, typed_data_class)                                              \
   RW(Array, ffi_callback_functions)                                            \
+  /* RegExps compiled by the precompiler, kept alive for regexp_table.      */ \
+  RW(Array, precompiled_regexps)                                               \
   /* Roots for JIT/AOT snapshots are up until here (see to_snapshot() below)*/ \
   RW(Array, dispatch_table_code_entries)                                       \
   RW(GrowableObjectArray, instructions_tables)                                 \
   RW(GrowableObjectArray, tag_table)                                           \
   RW(Array, obfuscation_map)                                                   \
   RW(Array, loading_unit_uris)                                                 \
+  /* Code source maps left in the snapshot by --lazy_snapshot_clusters.     */ \
+  RW(Array, lazy_code_source_maps)                                             \
   // Please remember the last entry must be referred in the 'to' function below.
 
 #define ISOLATE_OBJECT_STORE_FIELD_LIST(R_, RW)                                \
@@ -442,14 +447,16 @@ class ObjectStore {
 #undef DECLARE_OBJECT_STORE_FIELD
 #undef DECLARE_ATOMIC_OBJECT_STORE_FIELD
 #undef DECLARE_LAZY_OBJECT_STORE_FIELD
-  ObjectPtr* to() { return reinterpret_cast<ObjectPtr*>(&loading_unit_uris_); }
+  ObjectPtr* to() {
+    return reinterpret_cast<ObjectPtr*>(&lazy_code_source_maps_);
+  }
   ObjectPtr* to_snapshot(Snapshot::Kind kind) {
     switch (kind) {
       case Snapshot::kFull:
         return reinterpret_cast<ObjectPtr*>(&global_object_pool_);
       case Snapshot::kFullJIT:
       case Snapshot::kFullAOT:
-        return reinterpret_cast<ObjectPtr*>(&ffi_callback_functions_);
+        return reinterpret_cast<ObjectPtr*>(&precompiled_regexps_);
       case Snapshot::kModule:
       case Snapshot::kInvalid:
         break;
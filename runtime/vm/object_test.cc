@@ -467,6 +467,108 @@ ISOLATE_UNIT_TEST_CASE(StringCompareTo) {
   EXPECT(monkey_face.CompareTo(abce) > 0);
 }
 
+// String comparisons use memcmp for strings of the same representation.
+// Check lengths around the 16 byte blocks a vectorized memcmp compares,
+// with mismatches in every position, including tails shorter than 16 bytes.
+ISOLATE_UNIT_TEST_CASE(StringCompareBlockBoundaries) {
+  const intptr_t kLengths[] = {1, 15, 16, 17, 21, 31, 32, 33};
+  const intptr_t kMaxLength = 33;
+  uint8_t latin1[kMaxLength];
+  uint16_t utf16[kMaxLength];
+  for (intptr_t len : kLengths) {
+    for (intptr_t i = 0; i < len; i++) {
+      latin1[i] = 'a' + i % 26;
+      utf16[i] = 0x100 + i;
+    }
+    const String& one_byte = String::Handle(String::FromLatin1(latin1, len));
+    const String& two_byte = String::Handle(String::FromUTF16(utf16, len));
+    EXPECT(one_byte.IsOneByteString());
+    EXPECT(two_byte.IsTwoByteString());
+    EXPECT(one_byte.Equals(String::Handle(String::FromLatin1(latin1, len))));
+    EXPECT(one_byte.EqualsLatin1(latin1, len));
+    EXPECT(two_byte.Equals(String::Handle(String::FromUTF16(utf16, len))));
+    EXPECT_EQ(0, one_byte.CompareTo(
+                     String::Handle(String::FromLatin1(latin1, len))));
+    EXPECT(one_byte.EndsWith(one_byte));
+
+    // A prefix is smaller than the whole string.
+    if (len > 1) {
+      const String& prefix =
+          String::Handle(String::FromLatin1(latin1, len - 1));
+      EXPECT(prefix.CompareTo(one_byte) < 0);
+      EXPECT(one_byte.CompareTo(prefix) > 0);
+      EXPECT(!prefix.Equals(one_byte));
+    }
+
+    for (intptr_t pos = 0; pos < len; pos++) {
+      const uint8_t saved_latin1 = latin1[pos];
+      const uint16_t saved_utf16 = utf16[pos];
+      latin1[pos] = 0xFF;  // Compares as unsigned: larger than any letter.
+      utf16[pos] = 0xFFFF;
+      const String& other_one_byte =
+          String::Handle(String::FromLatin1(latin1, len));
+      const String& other_two_byte =
+          String::Handle(String::FromUTF16(utf16, len));
+      EXPECT(!one_byte.Equals(other_one_byte));
+      EXPECT(!one_byte.EqualsLatin1(latin1, len));
+      EXPECT(!two_byte.Equals(other_two_byte));
+      EXPECT(one_byte.CompareTo(other_one_byte) < 0);
+      EXPECT(other_one_byte.CompareTo(one_byte) > 0);
+      EXPECT(!one_byte.EndsWith(other_one_byte));
+      // Mismatch before the suffix.
+      const String& suffix = String::Handle(
+          String::FromLatin1(latin1 + pos + 1, len - pos - 1));
+      if (suffix.Length() > 0) {
+        EXPECT(one_byte.EndsWith(suffix));
+      }
+      latin1[pos] = saved_latin1;
+      utf16[pos] = saved_utf16;
+    }
+
+    // Equals with an offset into the other string.
+    const String& padded = String::Handle(String::Concat(
+        String::Handle(String::New("xy")), one_byte));
+    EXPECT(one_byte.Equals(padded, 2, len));
+    EXPECT(!one_byte.Equals(padded, 1, len));
+  }
+}
+
+// The _substringMatches intrinsic compares one-byte strings 16 bytes at a
+// time. Check the String methods built on it around these blocks.
+TEST_CASE(StringSubstringMatchesBlockBoundaries) {
+  const char* kScript = R"(
+    String letters(int n, int mismatch) {
+      final codes = List<int>.generate(n, (i) => 97 + i % 26);
+      if (mismatch >= 0) codes[mismatch] = 90;
+      return String.fromCharCodes(codes);
+    }
+
+    String test() {
+      for (final n in [1, 15, 16, 17, 21, 31, 32, 33]) {
+        final s = letters(n, -1);
+        final padded = 'xy' + s + 'z';
+        if (!padded.startsWith(s, 2)) return 'startsWith $n';
+        if (padded.indexOf(s) != 2) return 'indexOf $n';
+        if (!('xy' + s).endsWith(s)) return 'endsWith $n';
+        for (int m = 0; m < n; m++) {
+          final t = letters(n, m);
+          if (padded.startsWith(t, 2)) return 'startsWith $n/$m';
+          if (padded.indexOf(t) != -1) return 'indexOf $n/$m';
+          if (('xy' + s).endsWith(t)) return 'endsWith $n/$m';
+        }
+      }
+      return 'ok';
+    }
+  )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+  Dart_Handle result = Dart_Invoke(lib, NewString("test"), 0, nullptr);
+  EXPECT_VALID(result);
+  const char* result_str = nullptr;
+  EXPECT_VALID(Dart_StringToCString(result, &result_str));
+  EXPECT_STREQ("ok", result_str);
+}
+
 ISOLATE_UNIT_TEST_CASE(StringEncodeIRI) {
   const char* kInput =
       "file:///usr/local/johnmccutchan/workspace/dart-repo/dart/test.dart";
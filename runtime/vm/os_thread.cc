@@ -98,6 +98,9 @@ OSThread::~OSThread() {
     FATAL("Thread exited without calling Dart_ExitIsolate");
   }
   RemoveThreadFromList(this);
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+  ThreadInterrupter::StopCpuTimeTimer(this);
+#endif
   delete log_;
   log_ = nullptr;
 #if defined(SUPPORT_TIMELINE)
@@ -14,6 +14,7 @@
 #include "platform/utils.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
+#include "vm/perf_counters.h"
 
 // Declare the OS-specific types ahead of defining the generic classes.
 #if defined(DART_USE_ABSL)
@@ -155,6 +156,11 @@ class OSThread : public BaseThread {
   bool ThreadInterruptsEnabled() { return false; }
 #endif  // defined(DART_INCLUDE_PROFILER)
 
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  // The performance counters recorded in this thread's profiler samples.
+  PerfCounters::Group* perf_counters() { return &perf_counters_; }
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
   // The currently executing thread, or nullptr if not yet initialized.
   static OSThread* TryCurrent() {
     BaseThread* thread = GetCurrentTLS();
@@ -303,6 +309,19 @@ class OSThread : public BaseThread {
   RelaxedAtomic<uintptr_t> thread_interrupt_disabled_ = {1};
 #endif  // defined(DART_INCLUDE_PROFILER)
 
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+  // Timer sending SIGPROF to this thread as it consumes CPU time. Only
+  // accessed with the monitor of the ThreadInterrupter held, or by the
+  // destructor once the thread has been removed from the thread list.
+  timer_t cpu_time_timer_;
+  bool has_cpu_time_timer_ = false;
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
+
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  // Only accessed by this thread while it is being sampled.
+  PerfCounters::Group perf_counters_;
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
   Log* log_;
   uword stack_base_ = 0;
   uword stack_limit_ = 0;
@@ -332,6 +351,7 @@ class OSThread : public BaseThread {
 
   friend class Thread;  // to access set_thread(Thread*).
   friend class OSThreadIterator;
+  friend class ThreadInterrupter;
   friend class ThreadInterrupterFuchsia;
   friend class ThreadInterrupterMacOS;
   friend class ThreadInterrupterWin;
@@ -0,0 +1,253 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/perf_counters.h"
+
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+#include <errno.h>             // NOLINT
+#include <linux/perf_event.h>  // NOLINT
+#include <sys/syscall.h>       // NOLINT
+#include <unistd.h>            // NOLINT
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
+#include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/json_stream.h"
+#include "vm/os.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            profile_perf_counters,
+            false,
+            "Record the hardware performance counters (or software counters "
+            "where those are unavailable) of sampled threads in CPU profile "
+            "samples. Linux only.");
+
+PerfCounters::Mode PerfCounters::mode_ = PerfCounters::kDisabled;
+
+// The counters of each mode, with the cycles or time counter first.
+static const char* const kHardwareCounterNames[] = {
+    "cycles",
+    "instructions",
+    "cacheMisses",
+    "branchMisses",
+};
+static const char* const kSoftwareCounterNames[] = {
+    "taskClockNanos",
+    "pageFaults",
+    "majorPageFaults",
+};
+static_assert(ARRAY_SIZE(kHardwareCounterNames) <= PerfCounters::kMaxCounters);
+static_assert(ARRAY_SIZE(kSoftwareCounterNames) <= PerfCounters::kMaxCounters);
+
+const char* PerfCounters::ModeToCString(Mode mode) {
+  switch (mode) {
+    case kDisabled:
+      return "disabled";
+    case kHardware:
+      return "hardware";
+    case kSoftware:
+      return "software";
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+intptr_t PerfCounters::NumCounters() {
+  switch (mode_) {
+    case kDisabled:
+      return 0;
+    case kHardware:
+      return ARRAY_SIZE(kHardwareCounterNames);
+    case kSoftware:
+      return ARRAY_SIZE(kSoftwareCounterNames);
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+const char* PerfCounters::CounterName(intptr_t index) {
+  ASSERT((0 <= index) && (index < NumCounters()));
+  return mode_ == kHardware ? kHardwareCounterNames[index]
+                            : kSoftwareCounterNames[index];
+}
+
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+static const CounterConfig kHardwareCounters[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+static const CounterConfig kSoftwareCounters[] = {
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+};
+static_assert(ARRAY_SIZE(kHardwareCounters) ==
+              ARRAY_SIZE(kHardwareCounterNames));
+static_assert(ARRAY_SIZE(kSoftwareCounters) ==
+              ARRAY_SIZE(kSoftwareCounterNames));
+
+// Opens a counter of the current thread on any CPU. Only user mode is counted,
+// which unprivileged processes may do with perf_event_paranoid up to 2. Reads
+// include how long the group was enabled and running, which differ when the
+// kernel multiplexes more counters than the PMU has.
+static int OpenCounter(const CounterConfig& counter, int group_fd) {
+  struct perf_event_attr attr = {};
+  attr.size = sizeof(attr);
+  attr.type = counter.type;
+  attr.config = counter.config;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd,
+                 PERF_FLAG_FD_CLOEXEC);
+}
+
+PerfCounters::Group::~Group() {
+  for (intptr_t i = 0; i < kMaxCounters; i++) {
+    if (fds_[i] != -1) {
+      close(fds_[i]);
+    }
+  }
+}
+
+void PerfCounters::Group::Open() {
+  ASSERT(status_ == kUnopened);
+  const CounterConfig* counters =
+      mode_ == kHardware ? kHardwareCounters : kSoftwareCounters;
+  const intptr_t num_counters = NumCounters();
+  status_ = kFailed;
+  for (intptr_t i = 0; i < num_counters; i++) {
+    fds_[i] = OpenCounter(counters[i], leader_fd_);
+    if (fds_[i] == -1) {
+      return;
+    }
+    if (i == 0) {
+      leader_fd_ = fds_[0];
+    }
+  }
+  status_ = kOpen;
+}
+
+bool PerfCounters::ReadDeltas(Group* group, uint32_t* deltas) {
+  if (mode_ == kDisabled) {
+    return false;
+  }
+  // Signal handlers must not change errno.
+  const int saved_errno = errno;
+  if (group->status_ == Group::kUnopened) {
+    group->Open();
+  }
+  bool success = false;
+  if (group->status_ == Group::kOpen) {
+    // The layout of a read with the read_format of OpenCounter.
+    struct {
+      uint64_t nr;
+      uint64_t time_enabled;
+      uint64_t time_running;
+      uint64_t values[kMaxCounters];
+    } data;
+    const intptr_t num_counters = NumCounters();
+    const ssize_t expected = (3 + num_counters) * sizeof(uint64_t);
+    // A group that has not run yet has not counted anything.
+    if ((read(group->leader_fd_, &data, sizeof(data)) == expected) &&
+        (data.nr == static_cast<uint64_t>(num_counters)) &&
+        (data.time_running != 0)) {
+      for (intptr_t i = 0; i < num_counters; i++) {
+        // While multiplexed, the group only counted for part of the time it
+        // was enabled. Extrapolate to the whole time, as perf stat does.
+        uint64_t value = data.values[i];
+        if (data.time_running < data.time_enabled) {
+          value = static_cast<uint64_t>(static_cast<double>(value) *
+                                        data.time_enabled / data.time_running);
+        }
+        // Estimates can decrease slightly when the group runs again.
+        const uint64_t delta = value > group->last_values_[i]
+                                   ? value - group->last_values_[i]
+                                   : 0;
+        deltas[i] = static_cast<uint32_t>(
+            Utils::Minimum<uint64_t>(delta, kMaxUint32));
+        group->last_values_[i] = Utils::Maximum(value, group->last_values_[i]);
+      }
+      success = true;
+    }
+  }
+  errno = saved_errno;
+  return success;
+}
+
+// Returns whether the counters of the current mode can be read on this thread.
+// Fails if the group is opened but never scheduled on the PMU, for example
+// because pinned counters of other processes occupy it.
+static bool CanReadCounters() {
+  uint32_t deltas[PerfCounters::kMaxCounters];
+  PerfCounters::Group group;
+  return PerfCounters::ReadDeltas(&group, deltas);
+}
+
+void PerfCounters::Init() {
+  if (!FLAG_profile_perf_counters) {
+    return;
+  }
+  mode_ = kHardware;
+  if (!CanReadCounters()) {
+    mode_ = kSoftware;
+    if (!CanReadCounters()) {
+      mode_ = kDisabled;
+    }
+  }
+  if (FLAG_trace_profiler) {
+    OS::PrintErr("Profiler uses %s performance counters.\n",
+                 ModeToCString(mode_));
+  }
+}
+
+#else
+
+void PerfCounters::Init() {}
+
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
+void PerfCounters::Cleanup() {
+  mode_ = kDisabled;
+}
+
+#if !defined(PRODUCT)
+void PerfCounters::PrintJSON(JSONObject* jsobj,
+                             const char* name,
+                             const int64_t* values) {
+  JSONObject counters(jsobj, name);
+  const intptr_t num_counters = NumCounters();
+  for (intptr_t i = 0; i < num_counters; i++) {
+    counters.AddProperty64(CounterName(i), values[i]);
+  }
+  if (mode_ != kHardware) {
+    return;
+  }
+  const int64_t cycles = values[0];
+  const int64_t instructions = values[1];
+  if (cycles > 0) {
+    counters.AddProperty("instructionsPerCycle",
+                         static_cast<double>(instructions) / cycles);
+  }
+  if (instructions > 0) {
+    counters.AddProperty("cacheMissesPerKiloInstructions",
+                         1000.0 * values[2] / instructions);
+    counters.AddProperty("branchMissesPerKiloInstructions",
+                         1000.0 * values[3] / instructions);
+  }
+}
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
@@ -0,0 +1,96 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PERF_COUNTERS_H_
+#define RUNTIME_VM_PERF_COUNTERS_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class JSONObject;
+
+// Performance counters of the threads sampled by the CPU profiler, recorded
+// when --profile_perf_counters is set on Linux.
+//
+// Hardware counters count cycles, instructions, cache misses (usually of the
+// last level cache) and branch misses in user mode. Where they are not
+// available, for example in containers or virtual machines without a PMU,
+// software counters counting the task clock and page faults are used instead.
+//
+// Every CPU sample records how far the counters of the sampled thread advanced
+// since the thread's previous sample. Profiles attribute these deltas to the
+// executing code and function, in the same way as exclusive ticks.
+class PerfCounters : public AllStatic {
+ public:
+  enum Mode {
+    kDisabled,
+    kHardware,
+    kSoftware,
+  };
+
+  static constexpr intptr_t kMaxCounters = 4;
+
+  // Chooses the counters if --profile_perf_counters is set.
+  static void Init();
+  static void Cleanup();
+
+  static Mode mode() { return mode_; }
+  static const char* ModeToCString(Mode mode);
+
+  // The number of counters of the current mode, and their names.
+  static intptr_t NumCounters();
+  static const char* CounterName(intptr_t index);
+
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  // The counters of one thread, opened on the first read.
+  class Group {
+   public:
+    Group() {}
+    ~Group();
+
+   private:
+    enum Status {
+      kUnopened,
+      kOpen,
+      kFailed,
+    };
+
+    void Open();
+
+    Status status_ = kUnopened;
+    int leader_fd_ = -1;
+    int fds_[kMaxCounters] = {-1, -1, -1, -1};
+    uint64_t last_values_[kMaxCounters] = {};
+
+    friend class PerfCounters;
+    DISALLOW_COPY_AND_ASSIGN(Group);
+  };
+
+  // Stores how far the counters of the current thread advanced since the
+  // previous call in [deltas], saturating at kMaxUint32. Counts are scaled
+  // up while the kernel multiplexes the group with other counters. [group]
+  // must belong to the current thread. Returns false if the counters are
+  // disabled, could not be opened or have not run yet.
+  //
+  // Can be called from a signal handler.
+  static bool ReadDeltas(Group* group, uint32_t* deltas);
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
+#if !defined(PRODUCT)
+  // Prints the counters as a property [name], with instructions per cycle and
+  // misses per thousand instructions for hardware counters.
+  static void PrintJSON(JSONObject* jsobj,
+                        const char* name,
+                        const int64_t* values);
+#endif  // !defined(PRODUCT)
+
+ private:
+  static Mode mode_;
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PERF_COUNTERS_H_
@@ -0,0 +1,69 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/perf_counters.h"
+
+#include "platform/assert.h"
+#include "vm/flags.h"
+#include "vm/json_stream.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+
+DECLARE_FLAG(bool, profile_perf_counters);
+
+static DART_NOINLINE uint64_t BusyLoop(uint64_t n) {
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < n; i++) {
+    sum = sum + i * i;
+  }
+  return sum;
+}
+
+VM_UNIT_TEST_CASE(PerfCounters_ReadDeltas) {
+  SetFlagScope<bool> sfs(&FLAG_profile_perf_counters, true);
+  PerfCounters::Init();
+  if (PerfCounters::mode() == PerfCounters::kDisabled) {
+    // Neither hardware nor software counters are available here.
+    PerfCounters::Cleanup();
+    return;
+  }
+
+  PerfCounters::Group group;
+  uint32_t deltas[PerfCounters::kMaxCounters];
+  EXPECT(PerfCounters::ReadDeltas(&group, deltas));
+  BusyLoop(10 * 1000 * 1000);
+  EXPECT(PerfCounters::ReadDeltas(&group, deltas));
+  // Cycles, or the task clock, advanced during the loop.
+  EXPECT_LT(0u, deltas[0]);
+  if (PerfCounters::mode() == PerfCounters::kHardware) {
+    EXPECT_LT(0u, deltas[1]);
+  }
+
+#if !defined(PRODUCT)
+  const int64_t values[PerfCounters::kMaxCounters] = {2000, 1000, 5, 10};
+  JSONStream js;
+  {
+    JSONObject jsobj(&js);
+    PerfCounters::PrintJSON(&jsobj, "counters", values);
+  }
+  const char* json = js.ToCString();
+  EXPECT_SUBSTRING(PerfCounters::CounterName(0), json);
+  if (PerfCounters::mode() == PerfCounters::kHardware) {
+    EXPECT_SUBSTRING("\"instructionsPerCycle\":0.5", json);
+    EXPECT_SUBSTRING("\"cacheMissesPerKiloInstructions\":5", json);
+    EXPECT_SUBSTRING("\"branchMissesPerKiloInstructions\":10", json);
+  } else {
+    EXPECT_NOTSUBSTRING("instructionsPerCycle", json);
+  }
+#endif  // !defined(PRODUCT)
+
+  PerfCounters::Cleanup();
+}
+
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
+}  // namespace dart
@@ -292,7 +292,7 @@ bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
 
 void PortMap::Init() {
   if (mutex_ == nullptr) {
-    mutex_ = new Mutex();
+    mutex_ = new Mutex("PortMap::mutex_");
   }
   ASSERT(mutex_ != nullptr);
   if (prng_ == nullptr) {
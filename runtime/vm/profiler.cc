@@ -19,6 +19,7 @@
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/compiler_state.h"
 #endif
+#include "vm/continuous_profiler.h"
 #include "vm/debugger.h"
 #include "vm/globals.h"
 #include "vm/heap/safepoint.h"
@@ -212,30 +213,6 @@ static uword* LoadStackSlot(uword* ptr) {
 #define WINDOWS_EXTRA_NO_SANITIZE_ADDRESS
 #endif
 
-// The layout of C stack frames.
-#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64) ||                       \
-    defined(HOST_ARCH_ARM) || defined(HOST_ARCH_ARM64)
-// +-------------+
-// | saved IP/LR |
-// +-------------+
-// | saved FP    |  <- FP
-// +-------------+
-static constexpr intptr_t kHostSavedCallerPcSlotFromFp = 1;
-static constexpr intptr_t kHostSavedCallerFpSlotFromFp = 0;
-#elif defined(HOST_ARCH_RISCV32) || defined(HOST_ARCH_RISCV64)
-// +-------------+
-// |             | <- FP
-// +-------------+
-// | saved RA    |
-// +-------------+
-// | saved FP    |
-// +-------------+
-static constexpr intptr_t kHostSavedCallerPcSlotFromFp = -1;
-static constexpr intptr_t kHostSavedCallerFpSlotFromFp = -2;
-#else
-#error What architecture?
-#endif
-
 // If the VM is compiled without frame pointers (which is the default on
 // recent GCC versions with optimizing enabled) the stack walking code may
 // fail.
@@ -553,6 +530,7 @@ void Profiler::Init() {
 #if defined(SUPPORT_TIMELINE) && defined(SUPPORT_PERFETTO)
   SampleBlockProcessor::Init();
 #endif
+  PerfCounters::Init();
   SetConfig({});
 }
 
@@ -566,6 +544,7 @@ void Profiler::Cleanup() {
   SampleBlockProcessor::Cleanup();
 #endif
   ThreadInterrupter::Cleanup();
+  PerfCounters::Cleanup();
   delete monitor_;
 }
 
@@ -1158,6 +1137,24 @@ static void CopyStackBuffer(Sample* sample, uword sp_addr) {
 #endif
 }
 
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+// Called on the sampled thread from the SIGPROF handler.
+static void RecordPerfCounters(OSThread* os_thread, Sample* sample) {
+  if (PerfCounters::mode() == PerfCounters::kDisabled) {
+    return;
+  }
+  ASSERT(os_thread == OSThread::Current());
+  uint32_t deltas[PerfCounters::kMaxCounters];
+  if (!PerfCounters::ReadDeltas(os_thread->perf_counters(), deltas)) {
+    return;
+  }
+  const intptr_t num_counters = PerfCounters::NumCounters();
+  for (intptr_t i = 0; i < num_counters; i++) {
+    sample->set_perf_counter(i, deltas[i]);
+  }
+}
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
 static Sample* SetupSample(Thread* thread,
                            bool allocation_sample,
                            ThreadId tid) {
@@ -1323,6 +1320,10 @@ void Profiler::SampleThread(Thread* thread,
     return;
   }
 
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  RecordPerfCounters(os_thread, sample);
+#endif
+
 #if !defined(PRODUCT)
   // Increment counter for vm tag.
   VMTagCounters* counters = isolate->vm_tag_counters();
@@ -1919,6 +1920,9 @@ ProcessedSample* SampleBuffer::BuildProcessedSample(
         sample->allocation_identity_hash());
   }
   processed_sample->set_first_frame_executing(!sample->exit_frame_sample());
+  for (intptr_t i = 0; i < PerfCounters::kMaxCounters; i++) {
+    processed_sample->set_perf_counter(i, sample->perf_counter(i));
+  }
 
   // Copy stack trace from sample(s).
   bool truncated = false;
@@ -2089,6 +2093,7 @@ void SampleBlockProcessor::Shutdown() {
 void Profiler::IsolateShutdown(Isolate* isolate) {
   FlushSampleBlocks(isolate);
   NOT_IN_PRECOMPILED(Timeline::DrainCompletedSampleBlocksIntoRecorder(isolate));
+  ContinuousProfiler::IsolateShutdown(isolate);
 }
 
 void Profiler::IsolateGroupShutdown(IsolateGroup* isolate_group) {
@@ -14,6 +14,7 @@
 #include "vm/growable_array.h"
 #include "vm/native_symbol.h"
 #include "vm/object.h"
+#include "vm/perf_counters.h"
 #include "vm/tags.h"
 #include "vm/thread_interrupter.h"
 
@@ -273,6 +274,11 @@ class Sample {
     state_ = 0;
     next_ = nullptr;
     allocation_identity_hash_ = 0;
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+    for (intptr_t i = 0; i < PerfCounters::kMaxCounters; i++) {
+      perf_counters_[i] = 0;
+    }
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
     set_head_sample(true);
   }
 
@@ -368,6 +374,24 @@ class Sample {
     allocation_identity_hash_ = hash;
   }
 
+  // How far the |i|th performance counter of the sampled thread advanced
+  // since its previous sample (see PerfCounters). Always 0 where performance
+  // counters are not supported.
+  uint32_t perf_counter(intptr_t i) const {
+    ASSERT((i >= 0) && (i < PerfCounters::kMaxCounters));
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+    return perf_counters_[i];
+#else
+    return 0;
+#endif
+  }
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  void set_perf_counter(intptr_t i, uint32_t delta) {
+    ASSERT((i >= 0) && (i < PerfCounters::kMaxCounters));
+    perf_counters_[i] = delta;
+  }
+#endif  // defined(DART_SUPPORT_PERF_COUNTERS)
+
   Thread::TaskKind thread_task() const { return ThreadTaskBit::decode(state_); }
 
   void set_thread_task(Thread::TaskKind task) {
@@ -444,6 +468,9 @@ class Sample {
   RelaxedAtomic<Sample*> next_;
   RelaxedAtomic<uint32_t> state_;
   RelaxedAtomic<uint32_t> allocation_identity_hash_;
+#if defined(DART_SUPPORT_PERF_COUNTERS)
+  RelaxedAtomic<uint32_t> perf_counters_[PerfCounters::kMaxCounters];
+#endif
 
   using HeadSampleBit = BitField<decltype(state_), bool, 0, 1>;
   using LeafFrameIsDart =
@@ -941,6 +968,16 @@ class ProcessedSample : public ZoneObject {
     first_frame_executing_ = first_frame_executing;
   }
 
+  // See Sample::perf_counter.
+  int64_t perf_counter(intptr_t i) const {
+    ASSERT((i >= 0) && (i < PerfCounters::kMaxCounters));
+    return perf_counters_[i];
+  }
+  void set_perf_counter(intptr_t i, int64_t delta) {
+    ASSERT((i >= 0) && (i < PerfCounters::kMaxCounters));
+    perf_counters_[i] = delta;
+  }
+
  private:
   void FixupCaller(const CodeLookupTable& clt,
                    uword pc_marker,
@@ -960,6 +997,7 @@ class ProcessedSample : public ZoneObject {
   uint32_t allocation_identity_hash_;
   bool truncated_;
   bool first_frame_executing_;
+  int64_t perf_counters_[PerfCounters::kMaxCounters] = {};
 
   friend class SampleBuffer;
   DISALLOW_COPY_AND_ASSIGN(ProcessedSample);
@@ -1020,11 +1058,13 @@ class NoAllocationSampleFilter : public SampleFilter {
   NoAllocationSampleFilter(Dart_Port port,
                            intptr_t thread_task_mask,
                            int64_t time_origin_micros,
-                           int64_t time_extent_micros)
+                           int64_t time_extent_micros,
+                           bool take_samples = false)
       : SampleFilter(port,
                      thread_task_mask,
                      time_origin_micros,
-                     time_extent_micros) {}
+                     time_extent_micros,
+                     take_samples) {}
 
   bool FilterSample(Sample* sample) { return !sample->is_allocation_sample(); }
 };
@@ -123,6 +123,12 @@ void ProfileFunction::Tick(bool exclusive,
   TickSourcePosition(token_position, false);
 }
 
+void ProfileFunction::AddPerfCounters(const ProcessedSample* sample) {
+  for (intptr_t i = 0; i < PerfCounters::kMaxCounters; i++) {
+    perf_counters_[i] += sample->perf_counter(i);
+  }
+}
+
 void ProfileFunction::TickSourcePosition(TokenPosition token_position,
                                          bool exclusive) {
   intptr_t i = 0;
@@ -204,6 +210,9 @@ void ProfileFunction::PrintToJSONArray(JSONArray* functions,
   obj.AddProperty("kind", KindToCString(kind()));
   obj.AddProperty("inclusiveTicks", inclusive_ticks());
   obj.AddProperty("exclusiveTicks", exclusive_ticks());
+  if (PerfCounters::mode() != PerfCounters::kDisabled) {
+    PerfCounters::PrintJSON(&obj, "_perfCounters", perf_counters_);
+  }
   obj.AddProperty("resolvedUrl", ResolvedScriptUrl());
   if (kind() == kDartFunction) {
     ASSERT(!function_.IsNull());
@@ -344,6 +353,12 @@ void ProfileCode::Tick(uword pc, bool exclusive, intptr_t serial) {
   TickAddress(pc, false);
 }
 
+void ProfileCode::AddPerfCounters(const ProcessedSample* sample) {
+  for (intptr_t i = 0; i < PerfCounters::kMaxCounters; i++) {
+    perf_counters_[i] += sample->perf_counter(i);
+  }
+}
+
 void ProfileCode::TickAddress(uword pc, bool exclusive) {
   const intptr_t length = address_ticks_.length();
 
@@ -465,6 +480,9 @@ void ProfileCode::PrintToJSONArray(JSONArray* codes) {
   obj.AddProperty("kind", ProfileCode::KindToCString(kind()));
   obj.AddProperty("inclusiveTicks", inclusive_ticks());
   obj.AddProperty("exclusiveTicks", exclusive_ticks());
+  if (PerfCounters::mode() != PerfCounters::kDisabled) {
+    PerfCounters::PrintJSON(&obj, "_perfCounters", perf_counters_);
+  }
   if (kind() == kDartCode) {
     ASSERT(!code_.IsNull());
     obj.AddProperty("code", *code_.handle());
@@ -983,7 +1001,11 @@ class ProfileBuilder : public ValueObject {
         ASSERT(pc != 0);
         ProfileCode* code = FindOrRegisterProfileCode(pc, timestamp);
         ASSERT(code != nullptr);
-        code->Tick(pc, IsExecutingFrame(sample, frame_index), sample_index);
+        const bool exclusive = IsExecutingFrame(sample, frame_index);
+        code->Tick(pc, exclusive, sample_index);
+        if (exclusive) {
+          code->AddPerfCounters(sample);
+        }
       }
 
       TickExitFrame(sample->vm_tag(), sample_index, sample);
@@ -1176,8 +1198,11 @@ class ProfileBuilder : public ValueObject {
                 frame_index, function->Name(), token_position.ToCString(),
                 sample->At(frame_index));
     }
-    function->Tick(IsExecutingFrame(sample, frame_index), sample_index,
-                   token_position);
+    const bool exclusive = IsExecutingFrame(sample, frame_index);
+    function->Tick(exclusive, sample_index, token_position);
+    if (exclusive) {
+      function->AddPerfCounters(sample);
+    }
     function->AddProfileCode(code_index);
   }
 
@@ -1224,6 +1249,7 @@ class ProfileBuilder : public ValueObject {
     ProfileCode* code = tag_table->FindCodeForPC(vm_tag);
     ASSERT(code != nullptr);
     code->Tick(vm_tag, true, serial);
+    code->AddPerfCounters(sample);
   }
 
   void TickExitFrameFunction(uword vm_tag, intptr_t serial) {
@@ -1599,6 +1625,8 @@ void Profile::PrintHeaderJSON(JSONObject* obj) {
   obj->AddPropertyTimeMicros("timeOriginMicros", min_time());
   obj->AddPropertyTimeMicros("timeExtentMicros", GetTimeSpan());
   obj->AddProperty64("pid", pid);
+  obj->AddProperty("_perfCounterMode",
+                   PerfCounters::ModeToCString(PerfCounters::mode()));
   ProfilerCounters counters = Profiler::counters();
   {
     JSONObject counts(obj, "_counters");
@@ -180,6 +180,11 @@ class ProfileFunction : public ZoneObject {
             intptr_t inclusive_serial,
             TokenPosition token_position);
 
+  // Adds the performance counters of a sample that ticked this function
+  // exclusively.
+  void AddPerfCounters(const ProcessedSample* sample);
+  int64_t perf_counter(intptr_t i) const { return perf_counters_[i]; }
+
   static const char* KindToCString(Kind kind);
 
   void PrintToJSONArray(JSONArray* functions, bool print_only_ids = false);
@@ -208,6 +213,7 @@ class ProfileFunction : public ZoneObject {
   intptr_t exclusive_ticks_;
   intptr_t inclusive_ticks_;
   intptr_t inclusive_serial_;
+  int64_t perf_counters_[PerfCounters::kMaxCounters] = {};
 
   void PrintToJSONObject(JSONObject* func);
   // A |ProfileCode| that contains this function.
@@ -284,6 +290,11 @@ class ProfileCode : public ZoneObject {
   }
   void IncInclusiveTicks() { inclusive_ticks_++; }
 
+  // Adds the performance counters of a sample that ticked this code
+  // exclusively.
+  void AddPerfCounters(const ProcessedSample* sample);
+  int64_t perf_counter(intptr_t i) const { return perf_counters_[i]; }
+
   bool IsOptimizedDart() const;
   const AbstractCode code() const { return code_; }
 
@@ -318,6 +329,7 @@ class ProfileCode : public ZoneObject {
   intptr_t exclusive_ticks_;
   intptr_t inclusive_ticks_;
   intptr_t inclusive_serial_;
+  int64_t perf_counters_[PerfCounters::kMaxCounters] = {};
 
   const AbstractCode code_;
   char* name_;
@@ -13,6 +13,7 @@
 #include "vm/profiler_service.h"
 #include "vm/source_report.h"
 #include "vm/symbols.h"
+#include "vm/thread_interrupter.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -2572,6 +2573,127 @@ void main() {
   }
 }
 
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+DECLARE_FLAG(bool, profiler_cpu_time_timers);
+
+static int64_t ProcessCPUMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * kMicrosecondsPerSecond +
+         ts.tv_nsec / kNanosecondsPerMicrosecond;
+}
+
+// Threads which enable interrupts and then block, like mutators waiting for
+// messages.
+class IdleProfiledThreads : public ValueObject {
+ public:
+  static constexpr intptr_t kCount = 64;
+
+  IdleProfiledThreads() {
+    for (intptr_t i = 0; i < kCount; i++) {
+      OSThread::Start("IdleProfiledThread", &ThreadMain,
+                      reinterpret_cast<uword>(this));
+    }
+    MonitorLocker ml(&monitor_);
+    while (running_ < kCount) {
+      ml.Wait();
+    }
+  }
+
+  ~IdleProfiledThreads() {
+    {
+      MonitorLocker ml(&monitor_);
+      done_ = true;
+      ml.NotifyAll();
+    }
+    for (intptr_t i = 0; i < kCount; i++) {
+      OSThread::Join(join_ids_[i]);
+    }
+  }
+
+ private:
+  static void ThreadMain(uword parameter) {
+    auto* threads = reinterpret_cast<IdleProfiledThreads*>(parameter);
+    OSThread* os_thread = OSThread::Current();
+    os_thread->EnableThreadInterrupts();
+    {
+      MonitorLocker ml(&threads->monitor_);
+      threads->join_ids_[threads->running_++] =
+          OSThread::GetCurrentThreadJoinId(os_thread);
+      ml.NotifyAll();
+      while (!threads->done_) {
+        ml.Wait();
+      }
+    }
+    os_thread->DisableThreadInterrupts();
+  }
+
+  Monitor monitor_;
+  intptr_t running_ = 0;
+  bool done_ = false;
+  ThreadJoinId join_ids_[kCount];
+};
+
+// Runs a busy loop next to idle threads and returns the number of samples of
+// the loop and the CPU time used by threads other than the loop's.
+static void MeasureSampling(const Library& root_library,
+                            bool cpu_time_timers,
+                            intptr_t* sample_count,
+                            int64_t* overhead_micros) {
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  Profiler::SetConfig({.enabled = false});
+  delete Profiler::sample_block_buffer();
+  Profiler::set_sample_block_buffer(new SampleBlockBuffer());
+
+  SetFlagScope<bool> sfs(&FLAG_profiler_cpu_time_timers, cpu_time_timers);
+  Profiler::SetConfig({
+      .enabled = true,
+      .period_us = 100,
+  });
+  EXPECT_EQ(cpu_time_timers, ThreadInterrupter::UsesCpuTimeTimers());
+  {
+    IdleProfiledThreads idle_threads;
+    const int64_t process_start = ProcessCPUMicros();
+    const int64_t thread_start = OS::GetCurrentThreadCPUMicros();
+    Invoke(root_library, "main");
+    *overhead_micros = (ProcessCPUMicros() - process_start) -
+                       (OS::GetCurrentThreadCPUMicros() - thread_start);
+  }
+
+  SampleFilter filter(isolate->main_port(), Thread::kMutatorTask, -1, -1);
+  Profile profile;
+  profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+  *sample_count = profile.sample_count();
+  Profiler::SetConfig({.enabled = false});
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_CpuTimeTimers) {
+  const char* kScript = R"(
+void main() {
+  final sw = Stopwatch()..start();
+  while (sw.elapsedMilliseconds < 500) {
+  }
+})";
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+
+  intptr_t interrupter_samples, timer_samples;
+  int64_t interrupter_overhead, timer_overhead;
+  MeasureSampling(root_library, /*cpu_time_timers=*/false,
+                  &interrupter_samples, &interrupter_overhead);
+  MeasureSampling(root_library, /*cpu_time_timers=*/true, &timer_samples,
+                  &timer_overhead);
+  // Both sample the busy loop, but only the interrupter signals idle threads.
+  EXPECT_LT(0, interrupter_samples);
+  EXPECT_LT(0, timer_samples);
+
+  // Signalling the idle threads every 100us costs far more CPU time than the
+  // tolerance, which covers other VM threads like the background compiler.
+  const int64_t kToleranceMicros = 10 * 1000;
+  EXPECT_LT(timer_overhead + kToleranceMicros, interrupter_overhead);
+}
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
+
 #endif  // !PRODUCT
 
 }  // namespace dart
@@ -3838,7 +3838,10 @@ class UntaggedRegExp : public UntaggedInstance {
   COMPRESSED_POINTER_FIELD(TypedDataPtr, two_byte)
   COMPRESSED_POINTER_FIELD(TypedDataPtr, one_byte_sticky)
   COMPRESSED_POINTER_FIELD(TypedDataPtr, two_byte_sticky)
-  VISIT_TO(two_byte_sticky)
+  // Code units every match starts with, or null. See
+  // RegExpStatics::Interpret.
+  COMPRESSED_POINTER_FIELD(TypedDataPtr, literal_prefix)
+  VISIT_TO(literal_prefix)
   CompressedObjectPtr* to_snapshot(Snapshot::Kind kind) { return to(); }
 
   std::atomic<intptr_t> num_bracket_expressions_;
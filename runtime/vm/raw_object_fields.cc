@@ -179,6 +179,7 @@ namespace dart {
   F(RegExp, two_byte_)                                                         \
   F(RegExp, one_byte_sticky_)                                                  \
   F(RegExp, two_byte_sticky_)                                                  \
+  F(RegExp, literal_prefix_)                                                   \
   F(SuspendState, function_data_)                                              \
   F(SuspendState, then_callback_)                                              \
   F(SuspendState, error_callback_)                                             \
@@ -0,0 +1,147 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_BYTECODE_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_BYTECODE_H_
+
+#include "vm/regexp/regexp-ast.h"
+
+// ----------------------------------------------------------------------------
+// Definition and semantics of the EXPERIMENTAL bytecode.
+// Background:
+// - Russ Cox's blog post series on regular expression matching, in particular
+//   https://swtch.com/~rsc/regexp/regexp2.html
+// - The re2 regular regexp library: https://github.com/google/re2
+//
+// The experimental bytecode describes a non-deterministic finite automaton. It
+// runs on a multithreaded virtual machine (VM), i.e. in several threads
+// concurrently. (These "threads" are not operating system threads.) Apart
+// from a list of threads, the VM maintains an immutable shared input string
+// which threads can read from. Each thread is given by a program counter (PC,
+// index of the current instruction), a fixed number of registers of indices
+// into the input string, and a monotonically increasing index which
+// represents the current position within the input string.
+//
+// The instructions are:
+// - CONSUME_RANGE: Check whether the code unit at the current position is
+//   contained in the closed interval [min, max] given in the payload. Abort
+//   this thread if not, otherwise advance the input position by 1 and
+//   continue with the next instruction.
+// - ACCEPT: Stop this thread and signify the end of a match at the current
+//   input position.
+// - FORK: Spawn a new thread whose registers and input position agree with
+//   those of the current thread, but whose PC is the value in the payload.
+//   The spawned thread has lower priority than the current thread.
+// - JMP: Continue at the PC given in the payload.
+// - SET_REGISTER_TO_CP: Set the register given in the payload to the current
+//   position within the input, then continue with the next instruction.
+// - CLEAR_REGISTER: Reset the register given in the payload to -1.
+// - ASSERTION: Abort this thread unless the assertion given in the payload
+//   holds at the current position.
+//
+// Threads are ordered by priority, with the initial thread having the highest
+// priority. A thread spawned by a FORK has lower priority than its parent,
+// but higher priority than all threads the parent had lower priority than
+// before. The match found by the highest priority thread executing ACCEPT is
+// the match the backtracking engine would find, which lets the interpreter
+// (see experimental-interpreter.h) find JavaScript matches in time linear in
+// the length of the input.
+
+namespace dart {
+
+struct RegExpInstruction {
+  enum Opcode : int32_t {
+    ACCEPT,
+    ASSERTION,
+    CLEAR_REGISTER,
+    CONSUME_RANGE,
+    FORK,
+    JMP,
+    SET_REGISTER_TO_CP,
+  };
+
+  struct Uc16Range {
+    uint16_t min;  // Inclusive.
+    uint16_t max;  // Inclusive.
+  };
+
+  static RegExpInstruction ConsumeRange(uint16_t min, uint16_t max) {
+    RegExpInstruction result;
+    result.opcode = CONSUME_RANGE;
+    result.payload.consume_range = Uc16Range{min, max};
+    return result;
+  }
+
+  static RegExpInstruction ConsumeAnyChar() {
+    return ConsumeRange(0x0000, 0xFFFF);
+  }
+
+  static RegExpInstruction Fail() {
+    // This is encoded as the empty CONSUME_RANGE of characters 0xFFFF <= c <=
+    // 0x0000.
+    return ConsumeRange(0xFFFF, 0x0000);
+  }
+
+  static RegExpInstruction Fork(int32_t alt_index) {
+    RegExpInstruction result;
+    result.opcode = FORK;
+    result.payload.pc = alt_index;
+    return result;
+  }
+
+  static RegExpInstruction Jmp(int32_t alt_index) {
+    RegExpInstruction result;
+    result.opcode = JMP;
+    result.payload.pc = alt_index;
+    return result;
+  }
+
+  static RegExpInstruction Accept() {
+    RegExpInstruction result;
+    result.opcode = ACCEPT;
+    return result;
+  }
+
+  static RegExpInstruction SetRegisterToCp(int32_t register_index) {
+    RegExpInstruction result;
+    result.opcode = SET_REGISTER_TO_CP;
+    result.payload.register_index = register_index;
+    return result;
+  }
+
+  static RegExpInstruction ClearRegister(int32_t register_index) {
+    RegExpInstruction result;
+    result.opcode = CLEAR_REGISTER;
+    result.payload.register_index = register_index;
+    return result;
+  }
+
+  static RegExpInstruction Assertion(RegExpAssertion::Type t) {
+    RegExpInstruction result;
+    result.opcode = ASSERTION;
+    result.payload.assertion_type = t;
+    return result;
+  }
+
+  Opcode opcode;
+  union {
+    // Payload of CONSUME_RANGE:
+    Uc16Range consume_range;
+    // Payload of FORK and JMP, the next/forked program counter (pc):
+    int32_t pc;
+    // Payload of SET_REGISTER_TO_CP and CLEAR_REGISTER:
+    int32_t register_index;
+    // Payload of ASSERTION:
+    RegExpAssertion::Type assertion_type;
+  } payload;
+  static_assert(sizeof(payload) == 4);
+};
+static_assert(sizeof(RegExpInstruction) == 8);
+// This is encoded in bytecode arrays (kTypedDataInt32ArrayCid) as two int32
+// words per instruction.
+static_assert(alignof(RegExpInstruction) <= alignof(int32_t));
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_BYTECODE_H_
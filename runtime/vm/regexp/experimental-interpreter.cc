@@ -0,0 +1,400 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/experimental-interpreter.h"
+
+#include "vm/regexp/char-predicates-inl.h"
+#include "vm/regexp/zone-list-inl.h"
+
+namespace dart {
+
+namespace {
+
+constexpr int kUndefinedRegisterValue = -1;
+
+inline bool IsLineTerminator(uint32_t c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+template <class Character>
+bool SatisfiesAssertion(RegExpAssertion::Type type,
+                        base::Vector<const Character> context,
+                        int position) {
+  ASSERT(position <= context.length());
+  ASSERT(position >= 0);
+
+  switch (type) {
+    case RegExpAssertion::Type::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::Type::END_OF_INPUT:
+      return position == context.length();
+    case RegExpAssertion::Type::START_OF_LINE:
+      if (position == 0) return true;
+      return IsLineTerminator(context[position - 1]);
+    case RegExpAssertion::Type::END_OF_LINE:
+      if (position == context.length()) return true;
+      return IsLineTerminator(context[position]);
+    case RegExpAssertion::Type::BOUNDARY:
+      if (context.length() == 0) {
+        return false;
+      } else if (position == 0) {
+        return IsRegExpWord(context[position]);
+      } else if (position == context.length()) {
+        return IsRegExpWord(context[position - 1]);
+      } else {
+        return IsRegExpWord(context[position - 1]) !=
+               IsRegExpWord(context[position]);
+      }
+    case RegExpAssertion::Type::NON_BOUNDARY:
+      return !SatisfiesAssertion(RegExpAssertion::Type::BOUNDARY, context,
+                                 position);
+  }
+  UNREACHABLE();
+  return false;
+}
+
+// Executes a bytecode program in breadth-first mode, without backtracking.
+// `Character` can be instantiated with `uint8_t` or `uint16_t` for one byte or
+// two byte input strings.
+//
+// In contrast to the backtracking implementation, this has linear time
+// complexity in the length of the input string. Breadth-first mode means
+// that threads are executed in lockstep with respect to their input
+// position, i.e. the threads share a common input index. This is similar
+// to breadth-first simulation of a non-deterministic finite automaton (nfa),
+// hence the name of the class.
+//
+// To follow the semantics of a backtracking VM implementation, we have to be
+// careful about whether we stop execution when a thread executes ACCEPT.
+// For example, consider execution of the bytecode generated by the regexp
+//
+//   r = /abc|..|[a-c]{10,}/
+//
+// on input "abcccccccccccccc". Clearly the three alternatives
+// - /abc/
+// - /../
+// - /[a-c]{10,}/
+// all match this input. A backtracking implementation will report "abc" as
+// match, because it explores the first alternative before the others.
+//
+// However, if we execute breadth first, then we execute the 3 threads
+// - t1, which tries to match /abc/
+// - t2, which tries to match /../
+// - t3, which tries to match /[a-c]{10,}/
+// in lockstep i.e. by iterating over the input and feeding all threads one
+// character at a time. t2 will execute an ACCEPT after two characters,
+// while t1 will only execute ACCEPT after three characters. Thus we find a
+// match for the second alternative before a match of the first alternative.
+//
+// This shows that we cannot always stop searching as soon as some thread t
+// executes ACCEPT: If there is a thread u with higher priority than t, then
+// it must be finished first. If u produces a match, then we can discard the
+// match of t because matches produced by threads with higher priority are
+// preferred over matches of threads with lower priority. On the other hand,
+// we are allowed to abort all threads with lower priority than t if t
+// produces a match: Such threads can only produce worse matches. In the
+// example above, we can abort t3 after two characters because of t2's match.
+//
+// Thus the interpreter keeps track of a priority-ordered list of threads.
+// If a thread ACCEPTs, all threads with lower priority are discarded, and
+// the search continues with the threads with higher priority. If no threads
+// with high priority are left, we return the match that was produced by the
+// ACCEPTing thread with highest priority.
+template <class Character>
+class NfaInterpreter {
+ public:
+  NfaInterpreter(Thread* thread,
+                 const TypedData& bytecode_array,
+                 int register_count_per_match,
+                 const String& input_string,
+                 int input_index,
+                 Zone* zone)
+      : thread_(thread),
+        bytecode_array_(bytecode_array),
+        bytecode_length_(
+            static_cast<int>(bytecode_array.Length() *
+                             bytecode_array.ElementSizeInBytes() /
+                             sizeof(RegExpInstruction))),
+        input_string_(input_string),
+        input_index_(input_index),
+        pc_last_input_index_(zone->Alloc<int>(bytecode_length_)),
+        active_threads_(0, zone),
+        blocked_threads_(0, zone),
+        free_register_arrays_(0, zone),
+        register_count_per_match_(register_count_per_match),
+        zone_(zone) {
+    ASSERT(bytecode_length_ > 0);
+    ASSERT(register_count_per_match_ >= 2);
+    ASSERT(0 <= input_index && input_index <= input_string.Length());
+    for (int i = 0; i < bytecode_length_; ++i) {
+      pc_last_input_index_[i] = -1;
+    }
+    ReloadPointers();
+  }
+
+  // Finds the first match at or after the input index passed to the
+  // constructor and copies its capture registers to `output_registers`.
+  int FindMatch(int32_t* output_registers) {
+    active_threads_.Add(InterpreterThread{0, NewRegisterArray()}, zone_);
+
+    // Run the initial thread, potentially forking new threads, until every
+    // thread is blocked without further input.
+    RunActiveThreads();
+
+    // We stop if one of the following conditions hold:
+    // - We have exhausted the entire input.
+    // - We have found a match at some point, and there are no remaining
+    //   threads with higher priority than the thread that produced the match.
+    //   Threads with low priority have been aborted earlier, and the remaining
+    //   threads are blocked here, so the latter simply means that
+    //   `blocked_threads_` is empty.
+    while (input_index_ != input_.length() && !blocked_threads_.is_empty()) {
+      if (UNLIKELY(thread_->HasScheduledInterrupts())) {
+        ErrorPtr error = thread_->HandleInterrupts();
+        if (error != Object::null()) {
+          thread_->set_sticky_error(Error::Handle(error));
+          return RegExpStatics::RE_EXCEPTION;
+        }
+        // Interrupts may have moved the input and the bytecode.
+        ReloadPointers();
+      }
+
+      // We unblock all blocked_threads_ by feeding them the input char.
+      uint16_t input_char = input_[input_index_];
+      ++input_index_;
+      FlushBlockedThreads(input_char);
+
+      // Run all threads until they block or accept.
+      RunActiveThreads();
+    }
+
+    if (best_match_registers_ == nullptr) {
+      return RegExpStatics::RE_FAILURE;
+    }
+    memcpy(output_registers, best_match_registers_,  // NOLINT
+           register_count_per_match_ * sizeof(int32_t));
+    return RegExpStatics::RE_SUCCESS;
+  }
+
+ private:
+  // The state of a "thread" executing experimental regexp bytecode. (Not to
+  // be confused with an OS thread.)
+  struct InterpreterThread {
+    // This thread's program counter, i.e. the index within `bytecode_` of the
+    // next instruction to be executed.
+    int pc;
+    // Pointer to the array of registers, which is always of size
+    // `register_count_per_match_`. Should be deallocated with
+    // `FreeRegisterArray`.
+    int32_t* register_array_begin;
+  };
+
+  void ReloadPointers() {
+    NoSafepointScope no_safepoint(thread_);
+    bytecode_ =
+        reinterpret_cast<const RegExpInstruction*>(bytecode_array_.DataAddr(0));
+    if constexpr (sizeof(Character) == 1) {
+      input_ = {OneByteString::DataStart(input_string_),
+                static_cast<size_t>(input_string_.Length())};
+    } else {
+      input_ = {TwoByteString::DataStart(input_string_),
+                static_cast<size_t>(input_string_.Length())};
+    }
+  }
+
+  int32_t* NewRegisterArrayUninitialized() {
+    if (!free_register_arrays_.is_empty()) {
+      return free_register_arrays_.RemoveLast();
+    }
+    return zone_->Alloc<int32_t>(register_count_per_match_);
+  }
+
+  int32_t* NewRegisterArray() {
+    int32_t* registers = NewRegisterArrayUninitialized();
+    for (int i = 0; i < register_count_per_match_; ++i) {
+      registers[i] = kUndefinedRegisterValue;
+    }
+    return registers;
+  }
+
+  void FreeRegisterArray(int32_t* register_array_begin) {
+    free_register_arrays_.Add(register_array_begin, zone_);
+  }
+
+  void DestroyThread(InterpreterThread t) {
+    FreeRegisterArray(t.register_array_begin);
+  }
+
+  // It is redundant to have two threads t, t0 execute at the same PC value,
+  // because:
+  // 1. They have the same input index, since threads execute in lockstep.
+  // 2. Their future execution only depends on the PC value and the input
+  //    index, not on their registers.
+  // 3. Only the register values of the thread with higher priority are
+  //    relevant, because the other thread's match is discarded in favor of
+  //    the higher priority one.
+  // So if a thread arrives at a PC value that a thread with higher priority
+  // has already been at for the current input index, it is destroyed. This
+  // bounds the number of threads by the length of the bytecode.
+  bool IsPcProcessed(int pc) {
+    return pc_last_input_index_[pc] == input_index_;
+  }
+
+  void MarkPcProcessed(int pc) { pc_last_input_index_[pc] = input_index_; }
+
+  // Run an active thread `t` until it executes a CONSUME_RANGE or ACCEPT
+  // instruction, or its PC value was already processed.
+  // - If processing of `t` can't continue because of CONSUME_RANGE, it is
+  //   pushed on `blocked_threads_`.
+  // - If `t` executes ACCEPT, set `best_match_registers_` and discard all
+  //   threads with lower priority.
+  void RunActiveThread(InterpreterThread t) {
+    while (true) {
+      if (IsPcProcessed(t.pc)) {
+        DestroyThread(t);
+        return;
+      }
+      MarkPcProcessed(t.pc);
+
+      RegExpInstruction inst = bytecode_[t.pc];
+      switch (inst.opcode) {
+        case RegExpInstruction::CONSUME_RANGE: {
+          blocked_threads_.Add(t, zone_);
+          return;
+        }
+        case RegExpInstruction::ASSERTION:
+          if (!SatisfiesAssertion(inst.payload.assertion_type, input_,
+                                  input_index_)) {
+            DestroyThread(t);
+            return;
+          }
+          ++t.pc;
+          break;
+        case RegExpInstruction::FORK: {
+          InterpreterThread fork{inst.payload.pc,
+                                 NewRegisterArrayUninitialized()};
+          memcpy(fork.register_array_begin,  // NOLINT
+                 t.register_array_begin,
+                 register_count_per_match_ * sizeof(int32_t));
+          active_threads_.Add(fork, zone_);
+          ++t.pc;
+          break;
+        }
+        case RegExpInstruction::JMP:
+          t.pc = inst.payload.pc;
+          break;
+        case RegExpInstruction::ACCEPT:
+          if (best_match_registers_ != nullptr) {
+            FreeRegisterArray(best_match_registers_);
+          }
+          best_match_registers_ = t.register_array_begin;
+
+          for (InterpreterThread s : active_threads_) {
+            FreeRegisterArray(s.register_array_begin);
+          }
+          active_threads_.Rewind(0);
+          return;
+        case RegExpInstruction::SET_REGISTER_TO_CP:
+          t.register_array_begin[inst.payload.register_index] = input_index_;
+          ++t.pc;
+          break;
+        case RegExpInstruction::CLEAR_REGISTER:
+          t.register_array_begin[inst.payload.register_index] =
+              kUndefinedRegisterValue;
+          ++t.pc;
+          break;
+      }
+    }
+  }
+
+  // Run each active thread until it can't continue without further input.
+  // `active_threads_` is empty afterwards. `blocked_threads_` are sorted from
+  // high to low priority.
+  void RunActiveThreads() {
+    while (!active_threads_.is_empty()) {
+      RunActiveThread(active_threads_.RemoveLast());
+    }
+  }
+
+  // Unblock all blocked_threads_ by feeding them an `input_char`. Should only
+  // be called with `input_index_` pointing to the character *after*
+  // `input_char` so that `pc_last_input_index_` is updated correctly.
+  void FlushBlockedThreads(uint16_t input_char) {
+    // The threads in blocked_threads_ are sorted from high to low priority,
+    // but active_threads_ needs to be sorted from low to high priority, so we
+    // need to activate blocked threads in reverse order.
+    for (int i = blocked_threads_.length() - 1; i >= 0; --i) {
+      InterpreterThread t = blocked_threads_[i];
+      RegExpInstruction::Uc16Range range =
+          bytecode_[t.pc].payload.consume_range;
+      if (input_char >= range.min && input_char <= range.max) {
+        ++t.pc;
+        active_threads_.Add(t, zone_);
+      } else {
+        DestroyThread(t);
+      }
+    }
+    blocked_threads_.Rewind(0);
+  }
+
+  Thread* const thread_;
+
+  const TypedData& bytecode_array_;
+  const RegExpInstruction* bytecode_ = nullptr;
+  const int bytecode_length_;
+
+  const String& input_string_;
+  base::Vector<const Character> input_;
+  int input_index_;
+
+  // pc_last_input_index_[k] records the value of input_index_ the last
+  // time a thread t such that t.pc == k was activated, i.e. put on
+  // active_threads_. Thus pc_last_input_index.size() == bytecode.size(). See
+  // also `RunActiveThread`.
+  int* const pc_last_input_index_;
+
+  // Active threads can potentially (but not necessarily) continue without
+  // input. Sorted from low to high priority.
+  ZoneList<InterpreterThread> active_threads_;
+
+  // The pc of a blocked thread points to an instruction that consumes a
+  // character. Sorted from high to low priority (so the opposite of
+  // `active_threads_`).
+  ZoneList<InterpreterThread> blocked_threads_;
+
+  // Register arrays of destroyed threads, for reuse by new threads.
+  ZoneList<int32_t*> free_register_arrays_;
+
+  // The register array of the best match found so far, or nullptr.
+  int32_t* best_match_registers_ = nullptr;
+
+  const int register_count_per_match_;
+
+  Zone* const zone_;
+};
+
+}  // namespace
+
+int ExperimentalRegExpInterpreter::FindMatch(Thread* thread,
+                                             const TypedData& bytecode,
+                                             int register_count_per_match,
+                                             const String& input,
+                                             int start_index,
+                                             int32_t* output_registers,
+                                             Zone* zone) {
+  if (input.IsOneByteString()) {
+    NfaInterpreter<uint8_t> interpreter(thread, bytecode,
+                                        register_count_per_match, input,
+                                        start_index, zone);
+    return interpreter.FindMatch(output_registers);
+  } else {
+    ASSERT(input.IsTwoByteString());
+    NfaInterpreter<uint16_t> interpreter(thread, bytecode,
+                                         register_count_per_match, input,
+                                         start_index, zone);
+    return interpreter.FindMatch(output_registers);
+  }
+}
+
+}  // namespace dart
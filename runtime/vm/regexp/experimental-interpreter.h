@@ -0,0 +1,33 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
+
+#include "vm/regexp/experimental-bytecode.h"
+#include "vm/regexp/regexp.h"
+
+namespace dart {
+
+class ExperimentalRegExpInterpreter final : public AllStatic {
+ public:
+  // Executes a bytecode program in breadth-first NFA mode, without
+  // backtracking, to find the first match of the regexp at or after
+  // `start_index` (only at `start_index` for sticky or anchored programs).
+  // On success, the capture registers (two per capture, including the
+  // implicit capture 0) are written to `output_registers`.
+  // Returns RE_SUCCESS, RE_FAILURE or RE_EXCEPTION. In the latter case the
+  // error is stored as the thread's sticky error.
+  static int FindMatch(Thread* thread,
+                       const TypedData& bytecode,
+                       int register_count_per_match,
+                       const String& input,
+                       int start_index,
+                       int32_t* output_registers,
+                       Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
@@ -0,0 +1,109 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/experimental.h"
+
+#include "vm/flags.h"
+#include "vm/regexp/experimental-compiler.h"
+#include "vm/regexp/experimental-interpreter.h"
+#include "vm/regexp/regexp-parser.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            enable_experimental_regexp_engine_on_excessive_backtracks,
+            true,
+            "Fall back to the linear-time regexp engine for patterns it "
+            "supports when the backtracking engine exceeds "
+            "--regexp_backtracks_before_fallback.");
+DEFINE_FLAG(int,
+            regexp_backtracks_before_fallback,
+            50000,
+            "Number of backtracks during a single match before falling back "
+            "to the linear-time regexp engine.");
+DEFINE_FLAG(bool,
+            experimental_regexp_engine_for_nested_quantifiers,
+            true,
+            "Use the linear-time regexp engine right away for supported "
+            "patterns with nested unbounded quantifiers, such as /(a+)+/.");
+DEFINE_FLAG(bool,
+            default_to_experimental_regexp_engine,
+            false,
+            "Use the linear-time regexp engine for all patterns it supports.");
+
+bool ExperimentalRegExp::CanBeHandled(RegExpTree* tree,
+                                      RegExpFlags flags,
+                                      int capture_count) {
+  return ExperimentalRegExpCompiler::CanBeHandled(tree, flags, capture_count);
+}
+
+bool ExperimentalRegExp::IsPreferred(RegExpTree* tree,
+                                     RegExpFlags flags,
+                                     int capture_count) {
+  if (!FLAG_default_to_experimental_regexp_engine &&
+      !FLAG_experimental_regexp_engine_for_nested_quantifiers) {
+    return false;
+  }
+  if (!CanBeHandled(tree, flags, capture_count)) return false;
+  // The backtracking interpreter is faster on most patterns, only patterns
+  // which risk exponential backtracking are worth the per-character overhead
+  // of the breadth-first engine.
+  return FLAG_default_to_experimental_regexp_engine ||
+         ExperimentalRegExpCompiler::HasNestedUnboundedQuantifiers(tree);
+}
+
+TypedDataPtr ExperimentalRegExp::Compile(RegExpTree* tree,
+                                         RegExpFlags flags,
+                                         Zone* zone) {
+  ZoneList<RegExpInstruction> bytecode =
+      ExperimentalRegExpCompiler::Compile(tree, flags, zone);
+  const intptr_t length_in_bytes =
+      bytecode.length() * sizeof(RegExpInstruction);
+  const TypedData& array = TypedData::Handle(
+      zone, TypedData::New(kBytecodeCid,
+                           length_in_bytes / TypedData::ElementSizeInBytes(
+                                                 kBytecodeCid)));
+  NoSafepointScope no_safepoint;
+  memcpy(array.DataAddr(0), bytecode.begin(), length_in_bytes);  // NOLINT
+  return array.ptr();
+}
+
+int ExperimentalRegExp::MatchForCallFromRuntime(Thread* thread,
+                                                const TypedData& bytecode,
+                                                int capture_count,
+                                                const String& subject,
+                                                int index,
+                                                int32_t* output_registers) {
+  ASSERT(IsExperimentalBytecode(bytecode));
+  return ExperimentalRegExpInterpreter::FindMatch(
+      thread, bytecode, JSRegExp::RegistersForCaptureCount(capture_count),
+      subject, index, output_registers, thread->zone());
+}
+
+int ExperimentalRegExp::OneshotExec(Thread* thread,
+                                    const RegExp& regexp,
+                                    const String& subject,
+                                    int index,
+                                    bool sticky,
+                                    int32_t* output_registers) {
+  Zone* zone = thread->zone();
+  RegExpFlags flags = regexp.flags();
+  if (sticky) {
+    flags |= RegExpFlag::kSticky;
+  }
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  RegExpCompileData compile_data;
+  if (!RegExpParser::ParseRegExpFromHeapString(thread->isolate(), zone, pattern,
+                                               flags, &compile_data)) {
+    // The pattern was parsed successfully when the regexp was created.
+    UNREACHABLE();
+  }
+  ASSERT(CanBeHandled(compile_data.tree, flags, compile_data.capture_count));
+  const TypedData& bytecode =
+      TypedData::Handle(zone, Compile(compile_data.tree, flags, zone));
+  return MatchForCallFromRuntime(thread, bytecode, compile_data.capture_count,
+                                 subject, index, output_registers);
+}
+
+}  // namespace dart
@@ -0,0 +1,74 @@
+// Copyright 2020 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
+
+#include "vm/regexp/regexp-flags.h"
+#include "vm/regexp/regexp.h"
+
+namespace dart {
+
+class ExperimentalRegExp final : public AllStatic {
+ public:
+  // Initialization & Compilation
+  // -------------------------------------------------------------------------
+  // Check whether a parsed regexp pattern can be compiled and executed by the
+  // EXPERIMENTAL engine.
+  // TODO(mbid, v8:10765): This walks the RegExpTree, but it could also be
+  // checked on the fly in the parser. Not done currently because walking the
+  // AST again is more flexible and less error prone (but less performant).
+  static bool CanBeHandled(RegExpTree* tree,
+                           RegExpFlags flags,
+                           int capture_count);
+
+  // Dart: Whether a pattern should be matched by the experimental engine
+  // right away rather than only after the backtracking engine exceeded its
+  // backtrack budget.
+  static bool IsPreferred(RegExpTree* tree,
+                          RegExpFlags flags,
+                          int capture_count);
+
+  // Compiles a pattern the experimental engine can handle into a bytecode
+  // array. Unlike irregexp bytecode, the result does not depend on whether
+  // the subject is one-byte or two-byte.
+  static TypedDataPtr Compile(RegExpTree* tree, RegExpFlags flags, Zone* zone);
+
+  // Whether `bytecode` was produced by `Compile` rather than by the irregexp
+  // bytecode generator.
+  static bool IsExperimentalBytecode(const TypedData& bytecode) {
+    return bytecode.GetClassId() == kBytecodeCid;
+  }
+
+  // Execution:
+  // Finds the first match of the compiled pattern in `subject` at or after
+  // `index` and stores the capture registers in `output_registers`, which
+  // must have room for RegistersForCaptureCount(capture_count) values.
+  static int MatchForCallFromRuntime(Thread* thread,
+                                     const TypedData& bytecode,
+                                     int capture_count,
+                                     const String& subject,
+                                     int index,
+                                     int32_t* output_registers);
+
+  // Compiles and runs the pattern of `regexp` without keeping the bytecode,
+  // for patterns the backtracking engine gave up on.
+  static int OneshotExec(Thread* thread,
+                         const RegExp& regexp,
+                         const String& subject,
+                         int index,
+                         bool sticky,
+                         int32_t* output_registers);
+
+  static constexpr bool kSupportsUnicode = false;
+
+ private:
+  // Distinguishes experimental bytecode from irregexp bytecode, which is
+  // stored in Uint8 arrays.
+  static constexpr intptr_t kBytecodeCid = kTypedDataInt32ArrayCid;
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_H_
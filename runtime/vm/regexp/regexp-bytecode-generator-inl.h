@@ -8,6 +8,8 @@
 #include "vm/regexp/regexp-bytecode-generator.h"
 // Include the non-inl header before the rest of the headers.
 
+#include <tuple>
+
 #include "vm/regexp/regexp-bytecodes-inl.h"
 
 namespace dart {
@@ -36,6 +38,37 @@ void RegExpBytecodeWriter::OverwriteValue(T value, int absolute_offset) {
   *reinterpret_cast<T*>(buffer_.data() + absolute_offset) = value;
 }
 
+template <RegExpBytecode bytecode, typename... Args>
+void RegExpBytecodeWriter::Emit(Args... args) {
+  using Operands = RegExpBytecodeOperands<bytecode>;
+  static_assert(sizeof...(Args) == Operands::kCount,
+                "Wrong number of operands");
+
+  auto arguments_tuple = std::make_tuple(args...);
+  EmitBytecode(bytecode);
+  Operands::ForEachOperandWithIndex([&]<auto op, size_t index>() {
+    constexpr RegExpBytecodeOperandType type = Operands::Type(op);
+    constexpr int offset = Operands::Offset(op);
+    auto value = std::get<index>(arguments_tuple);
+    EmitOperand<type>(value, offset);
+  });
+  Finalize(bytecode);
+}
+
+// Operand types without a direct C-type mapping, defined in
+// regexp-bytecode-generator.cc.
+template <>
+void RegExpBytecodeWriter::EmitOperand<ReBcOpType::kJumpTarget>(V8Label* label,
+                                                                int offset);
+template <>
+void RegExpBytecodeWriter::EmitOperand<ReBcOpType::kBitTable>(
+    const TypedData* table,
+    int offset);
+template <>
+void RegExpBytecodeWriter::EmitOperand<ReBcOpType::kBitTable>(
+    const uint8_t* src,
+    int offset);
+
 void RegExpBytecodeWriter::EmitBytecode(RegExpBytecode bc) {
   DCHECK_EQ(pc_, end_of_bc_);
   DCHECK_EQ(pc_within_bc_, end_of_bc_);
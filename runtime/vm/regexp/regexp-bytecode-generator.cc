@@ -8,13 +8,17 @@
 #include <tuple>
 #include <type_traits>
 
+#include "vm/flags.h"
 #include "vm/regexp/regexp-bytecode-generator-inl.h"
+#include "vm/regexp/regexp-bytecode-peephole.h"
 #include "vm/regexp/regexp-bytecodes-inl.h"
 #include "vm/regexp/regexp-macro-assembler.h"
 #include "vm/regexp/regexp.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, regexp_peephole_optimization);
+
 // Used to decide whether we use the `Char` or `4Chars` variant of a bytecode.
 static constexpr int kMaxSingleCharValue =
     RegExpOperandTypeTraits<RegExpBytecodeOperandType::kChar>::kMaxValue;
@@ -110,23 +114,6 @@ RegExpBytecodeGenerator::Implementation() {
   return kBytecodeImplementation;
 }
 
-template <RegExpBytecode bytecode, typename... Args>
-void RegExpBytecodeWriter::Emit(Args... args) {
-  using Operands = RegExpBytecodeOperands<bytecode>;
-  static_assert(sizeof...(Args) == Operands::kCount,
-                "Wrong number of operands");
-
-  auto arguments_tuple = std::make_tuple(args...);
-  EmitBytecode(bytecode);
-  Operands::ForEachOperandWithIndex([&]<auto op, size_t index>() {
-    constexpr RegExpBytecodeOperandType type = Operands::Type(op);
-    constexpr int offset = Operands::Offset(op);
-    auto value = std::get<index>(arguments_tuple);
-    EmitOperand<type>(value, offset);
-  });
-  Finalize(bytecode);
-}
-
 namespace {
 
 // Helper to get the underlying type of an enum, or the type itself if it isn't
@@ -250,6 +237,7 @@ void RegExpBytecodeGenerator::Emit(Args... args) {
 
 void RegExpBytecodeGenerator::Bind(V8Label* l) {
   ASSERT(!l->is_bound());
+  advance_current_end_ = kInvalidPC;
   if (l->is_linked()) {
     int pos = l->pos();
     while (pos != 0) {
@@ -322,7 +310,14 @@ void RegExpBytecodeGenerator::Backtrack() {
 }
 
 void RegExpBytecodeGenerator::GoTo(V8Label* label) {
-  Emit<RegExpBytecode::kGoTo>(label);
+  if (advance_current_end_ == pc_) {
+    // Combine advance current and goto.
+    ResetPc(advance_current_start_);
+    Emit<RegExpBytecode::kAdvanceCpAndGoto>(advance_current_offset_, label);
+    advance_current_end_ = kInvalidPC;
+  } else {
+    Emit<RegExpBytecode::kGoTo>(label);
+  }
 }
 
 void RegExpBytecodeGenerator::PushBacktrack(V8Label* label) {
@@ -339,7 +334,10 @@ void RegExpBytecodeGenerator::Fail() {
 }
 
 void RegExpBytecodeGenerator::AdvanceCurrentPosition(int by) {
+  advance_current_start_ = pc_;
+  advance_current_offset_ = by;
   Emit<RegExpBytecode::kAdvanceCurrentPosition>(by);
+  advance_current_end_ = pc_;
 }
 
 void RegExpBytecodeGenerator::CheckFixedLengthLoop(
@@ -622,10 +620,8 @@ ObjectPtr RegExpBytecodeGenerator::GetCode(const String& source,
   Backtrack();
 
   if (FLAG_regexp_peephole_optimization) {
-    UNIMPLEMENTED();
-    // return RegExpBytecodePeepholeOptimization::OptimizeBytecode(
-    //     isolate_, zone(), source, this);
-    return TypedData::null();
+    return RegExpBytecodePeepholeOptimization::OptimizeBytecode(zone(), source,
+                                                                this);
   } else {
     const TypedData& array =
         TypedData::Handle(TypedData::New(kTypedDataUint8ArrayCid, length()));
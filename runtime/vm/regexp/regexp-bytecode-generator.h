@@ -262,6 +262,13 @@ class RegExpBytecodeGenerator : public RegExpMacroAssembler,
 
   V8Label backtrack_;
 
+  // The last AdvanceCurrentPosition, fused with an immediately following GoTo
+  // into AdvanceCpAndGoto unless a label was bound in between.
+  static constexpr int kInvalidPC = -1;
+  int advance_current_start_ = kInvalidPC;
+  int advance_current_offset_ = 0;
+  int advance_current_end_ = kInvalidPC;
+
   Isolate* isolate_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(RegExpBytecodeGenerator);
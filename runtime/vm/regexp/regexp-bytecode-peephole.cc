@@ -0,0 +1,377 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/regexp-bytecode-peephole.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+#include "vm/flags.h"
+#include "vm/log.h"
+#include "vm/regexp/regexp-bytecode-generator-inl.h"
+#include "vm/regexp/regexp-bytecodes-inl.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            regexp_peephole_optimization,
+            true,
+            "Fuse common sequences of regexp bytecode into single bytecodes.");
+DEFINE_FLAG(bool,
+            trace_regexp_peephole_optimization,
+            false,
+            "Print regexp bytecode before and after peephole optimization.");
+
+namespace {
+
+using Bc = RegExpBytecode;
+
+// Reads operand `operand` of the `Name` bytecode at offset `pc`.
+#define OPERAND(Name, operand, pc)                                             \
+  (RegExpBytecodeOperands<Bc::k##Name>::Get<                                   \
+      detail::RegExpBytecodeOperandNames<Bc::k##Name>::operand>(At(pc),        \
+                                                                no_gc_))
+
+// Each fused sequence is a loop: it ends with an AdvanceCpAndGoto jumping
+// back to its first bytecode, and leaves the loop through the jump targets
+// of its loads and checks. The fused bytecodes are implemented in
+// regexp-interpreter.cc and the equivalent sequences in
+// RegExpMacroAssembler.
+class PeepholeOptimizer : public ValueObject {
+ public:
+  PeepholeOptimizer(Zone* zone, const RegExpBytecodeWriter* src)
+      : src_(src),
+        new_offsets_(src->length() / kBytecodeAlignment + 1, -1, zone),
+        jumps_by_target_(zone) {
+    for (const auto& [source, target] : src->jump_edges()) {
+      jumps_by_target_.push_back(std::make_pair(target, source));
+    }
+    std::sort(jumps_by_target_.begin(), jumps_by_target_.end());
+  }
+
+  void Run(RegExpBytecodeWriter* dst);
+
+ private:
+  static constexpr int kMaxSequenceLength = 6;
+
+  const uint8_t* At(int pc) const { return src_->buffer().data() + pc; }
+
+  // Loads the offsets of the bytecodes starting at `pc` into `window_`, and
+  // the offset following them into window_[bytecodes.size()]. Returns true
+  // if they are `bytecodes` and no jump targets any but the first, except
+  // the jumps from and to the window indices of `internal_jumps`. The
+  // caller checks that those jumps are part of the fused loop.
+  bool Matches(int pc,
+               std::initializer_list<Bc> bytecodes,
+               std::initializer_list<std::pair<intptr_t, intptr_t>>
+                   internal_jumps = {});
+
+  // The index of the bytecode of `window_` containing `pc`.
+  intptr_t WindowIndex(int pc, intptr_t count) const {
+    intptr_t index = 0;
+    while (index + 1 < count && window_[index + 1] <= pc) {
+      index++;
+    }
+    return index;
+  }
+
+  // Whether the AdvanceCpAndGoto at window_[index] loops back to window_[0].
+  bool LoopsToStart(intptr_t index) const {
+    return OPERAND(AdvanceCpAndGoto, on_goto, window_[index]) ==
+           static_cast<uint32_t>(window_[0]);
+  }
+
+  // Emits a single bytecode for the sequence at `pc` and sets `next` to the
+  // offset following the sequence. Returns false if there is none.
+  bool TryFuse(RegExpBytecodeWriter* dst, int pc, int* next);
+
+  const RegExpBytecodeWriter* const src_;
+  // Offset in the optimized bytecode of each bytecode of the source, indexed
+  // by offset / kBytecodeAlignment. -1 for bytecodes fused into their
+  // predecessors.
+  ZoneVector<int> new_offsets_;
+  // All jumps of the source as (target, source) pairs, sorted.
+  ZoneVector<std::pair<int, int>> jumps_by_target_;
+  int window_[kMaxSequenceLength + 1];
+  DisallowGarbageCollection no_gc_;
+};
+
+bool PeepholeOptimizer::Matches(
+    int pc,
+    std::initializer_list<Bc> bytecodes,
+    std::initializer_list<std::pair<intptr_t, intptr_t>> internal_jumps) {
+  ASSERT(bytecodes.size() <= kMaxSequenceLength);
+  intptr_t count = 0;
+  for (Bc bc : bytecodes) {
+    if (pc >= src_->length() || RegExpBytecodes::FromPtr(At(pc)) != bc) {
+      return false;
+    }
+    window_[count++] = pc;
+    pc += RegExpBytecodes::Size(bc);
+  }
+  window_[count] = pc;
+  const int start = window_[0];
+  const int end = window_[count];
+  auto it = std::upper_bound(jumps_by_target_.begin(), jumps_by_target_.end(),
+                             std::make_pair(start, INT32_MAX));
+  // The fused bytecode has no offset for the bytecodes after its first, so
+  // only the jumps it implements may target them.
+  for (; it != jumps_by_target_.end() && it->first < end; ++it) {
+    const int source = it->second;
+    if (source < start || source >= end) return false;
+    const std::pair<intptr_t, intptr_t> jump(WindowIndex(source, count),
+                                             WindowIndex(it->first, count));
+    if (window_[jump.second] != it->first ||
+        std::find(internal_jumps.begin(), internal_jumps.end(), jump) ==
+            internal_jumps.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PeepholeOptimizer::TryFuse(RegExpBytecodeWriter* dst, int pc, int* next) {
+  // LoadCurrentCharacter, CheckCharacterGT, CheckBitInTable, GoTo and
+  // AdvanceCpAndGoto.
+  if (Matches(pc,
+              {Bc::kLoadCurrentCharacter, Bc::kCheckCharacterGT,
+               Bc::kCheckBitInTable, Bc::kGoTo, Bc::kAdvanceCpAndGoto},
+              {{2, 4}}) &&
+      LoopsToStart(4) &&
+      OPERAND(CheckBitInTable, on_bit_set, window_[2]) ==
+          static_cast<uint32_t>(window_[4]) &&
+      OPERAND(GoTo, label, window_[3]) ==
+          OPERAND(CheckCharacterGT, on_greater, window_[1])) {
+    dst->Emit<Bc::kSkipUntilGtOrNotBitInTable>(
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(AdvanceCpAndGoto, by, window_[4]),
+        OPERAND(CheckCharacterGT, limit, window_[1]),
+        OPERAND(CheckBitInTable, table, window_[2]),
+        OPERAND(CheckCharacterGT, on_greater, window_[1]),
+        OPERAND(LoadCurrentCharacter, on_failure, window_[0]));
+    *next = window_[5];
+    return true;
+  }
+
+  // CheckPosition, Load4CurrentCharsUnchecked, AndCheck4Chars,
+  // AdvanceCpAndGoto, AndCheck4Chars and AndCheckNot4Chars, where the
+  // checks of masked characters that fit in 16 bits use the single character
+  // variants.
+  for (Bc both : {Bc::kAndCheck4Chars, Bc::kCheckCharacterAfterAnd}) {
+    for (Bc check1 : {Bc::kAndCheck4Chars, Bc::kCheckCharacterAfterAnd}) {
+      for (Bc check2 :
+           {Bc::kAndCheckNot4Chars, Bc::kCheckNotCharacterAfterAnd}) {
+        if (!Matches(pc,
+                     {Bc::kCheckPosition, Bc::kLoad4CurrentCharsUnchecked, both,
+                      Bc::kAdvanceCpAndGoto, check1, check2},
+                     {{2, 4}, {5, 3}}) ||
+            !LoopsToStart(3)) {
+          continue;
+        }
+        uint32_t both_chars, both_mask, found;
+        if (both == Bc::kAndCheck4Chars) {
+          both_chars = OPERAND(AndCheck4Chars, characters, window_[2]);
+          both_mask = OPERAND(AndCheck4Chars, mask, window_[2]);
+          found = OPERAND(AndCheck4Chars, on_equal, window_[2]);
+        } else {
+          both_chars = OPERAND(CheckCharacterAfterAnd, character, window_[2]);
+          both_mask = OPERAND(CheckCharacterAfterAnd, mask, window_[2]);
+          found = OPERAND(CheckCharacterAfterAnd, on_equal, window_[2]);
+        }
+        uint32_t chars1, mask1, on_match1;
+        if (check1 == Bc::kAndCheck4Chars) {
+          chars1 = OPERAND(AndCheck4Chars, characters, window_[4]);
+          mask1 = OPERAND(AndCheck4Chars, mask, window_[4]);
+          on_match1 = OPERAND(AndCheck4Chars, on_equal, window_[4]);
+        } else {
+          chars1 = OPERAND(CheckCharacterAfterAnd, character, window_[4]);
+          mask1 = OPERAND(CheckCharacterAfterAnd, mask, window_[4]);
+          on_match1 = OPERAND(CheckCharacterAfterAnd, on_equal, window_[4]);
+        }
+        uint32_t chars2, mask2, on_no_match2;
+        if (check2 == Bc::kAndCheckNot4Chars) {
+          chars2 = OPERAND(AndCheckNot4Chars, characters, window_[5]);
+          mask2 = OPERAND(AndCheckNot4Chars, mask, window_[5]);
+          on_no_match2 = OPERAND(AndCheckNot4Chars, on_not_equal, window_[5]);
+        } else {
+          chars2 = OPERAND(CheckNotCharacterAfterAnd, character, window_[5]);
+          mask2 = OPERAND(CheckNotCharacterAfterAnd, mask, window_[5]);
+          on_no_match2 =
+              OPERAND(CheckNotCharacterAfterAnd, on_not_equal, window_[5]);
+        }
+        // The first check jumps to the checks of the two alternatives, and a
+        // mismatch of the second alternative continues the loop.
+        if (found != static_cast<uint32_t>(window_[4]) ||
+            on_no_match2 != static_cast<uint32_t>(window_[3])) {
+          continue;
+        }
+        dst->Emit<Bc::kSkipUntilOneOfMasked>(
+            OPERAND(Load4CurrentCharsUnchecked, cp_offset, window_[1]),
+            OPERAND(AdvanceCpAndGoto, by, window_[3]), both_chars, both_mask,
+            OPERAND(CheckPosition, cp_offset, window_[0]), chars1, mask1,
+            chars2, mask2, on_match1, static_cast<uint32_t>(window_[6]),
+            OPERAND(CheckPosition, on_failure, window_[0]));
+        *next = window_[6];
+        return true;
+      }
+    }
+  }
+
+  // LoadCurrentCharacter, CheckCharacter, CheckCharacter and
+  // AdvanceCpAndGoto.
+  if (Matches(pc, {Bc::kLoadCurrentCharacter, Bc::kCheckCharacter,
+                   Bc::kCheckCharacter, Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(3) &&
+      OPERAND(CheckCharacter, on_equal, window_[1]) ==
+          OPERAND(CheckCharacter, on_equal, window_[2])) {
+    dst->Emit<Bc::kSkipUntilCharOrChar>(
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(AdvanceCpAndGoto, by, window_[3]),
+        OPERAND(CheckCharacter, character, window_[1]),
+        OPERAND(CheckCharacter, character, window_[2]),
+        OPERAND(CheckCharacter, on_equal, window_[1]),
+        OPERAND(LoadCurrentCharacter, on_failure, window_[0]));
+    *next = window_[4];
+    return true;
+  }
+
+  // LoadCurrentCharacter, CheckCharacter and AdvanceCpAndGoto.
+  if (Matches(pc, {Bc::kLoadCurrentCharacter, Bc::kCheckCharacter,
+                   Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(2)) {
+    dst->Emit<Bc::kSkipUntilChar>(
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(AdvanceCpAndGoto, by, window_[2]),
+        OPERAND(CheckCharacter, character, window_[1]),
+        OPERAND(CheckCharacter, on_equal, window_[1]),
+        OPERAND(LoadCurrentCharacter, on_failure, window_[0]));
+    *next = window_[3];
+    return true;
+  }
+
+  // LoadCurrentCharacter, CheckBitInTable and AdvanceCpAndGoto.
+  if (Matches(pc, {Bc::kLoadCurrentCharacter, Bc::kCheckBitInTable,
+                   Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(2)) {
+    dst->Emit<Bc::kSkipUntilBitInTable>(
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(AdvanceCpAndGoto, by, window_[2]),
+        OPERAND(CheckBitInTable, table, window_[1]),
+        OPERAND(CheckBitInTable, on_bit_set, window_[1]),
+        OPERAND(LoadCurrentCharacter, on_failure, window_[0]));
+    *next = window_[3];
+    return true;
+  }
+
+  // LoadCurrentCharacter, CheckCharacterAfterAnd and AdvanceCpAndGoto. The
+  // bounds check of the load is the check of SkipUntilCharAnd.
+  if (Matches(pc, {Bc::kLoadCurrentCharacter, Bc::kCheckCharacterAfterAnd,
+                   Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(2)) {
+    dst->Emit<Bc::kSkipUntilCharAnd>(
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(AdvanceCpAndGoto, by, window_[2]),
+        OPERAND(CheckCharacterAfterAnd, character, window_[1]),
+        OPERAND(CheckCharacterAfterAnd, mask, window_[1]),
+        OPERAND(LoadCurrentCharacter, cp_offset, window_[0]),
+        OPERAND(CheckCharacterAfterAnd, on_equal, window_[1]),
+        OPERAND(LoadCurrentCharacter, on_failure, window_[0]));
+    *next = window_[3];
+    return true;
+  }
+
+  // CheckPosition, LoadCurrentCharacterUnchecked, CheckCharacter and
+  // AdvanceCpAndGoto.
+  if (Matches(pc, {Bc::kCheckPosition, Bc::kLoadCurrentCharacterUnchecked,
+                   Bc::kCheckCharacter, Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(3)) {
+    dst->Emit<Bc::kSkipUntilCharPosChecked>(
+        OPERAND(LoadCurrentCharacterUnchecked, cp_offset, window_[1]),
+        OPERAND(AdvanceCpAndGoto, by, window_[3]),
+        OPERAND(CheckCharacter, character, window_[2]),
+        OPERAND(CheckPosition, cp_offset, window_[0]),
+        OPERAND(CheckCharacter, on_equal, window_[2]),
+        OPERAND(CheckPosition, on_failure, window_[0]));
+    *next = window_[4];
+    return true;
+  }
+
+  // CheckPosition, LoadCurrentCharacterUnchecked, CheckCharacterAfterAnd and
+  // AdvanceCpAndGoto.
+  if (Matches(pc, {Bc::kCheckPosition, Bc::kLoadCurrentCharacterUnchecked,
+                   Bc::kCheckCharacterAfterAnd, Bc::kAdvanceCpAndGoto}) &&
+      LoopsToStart(3)) {
+    dst->Emit<Bc::kSkipUntilCharAnd>(
+        OPERAND(LoadCurrentCharacterUnchecked, cp_offset, window_[1]),
+        OPERAND(AdvanceCpAndGoto, by, window_[3]),
+        OPERAND(CheckCharacterAfterAnd, character, window_[2]),
+        OPERAND(CheckCharacterAfterAnd, mask, window_[2]),
+        OPERAND(CheckPosition, cp_offset, window_[0]),
+        OPERAND(CheckCharacterAfterAnd, on_equal, window_[2]),
+        OPERAND(CheckPosition, on_failure, window_[0]));
+    *next = window_[4];
+    return true;
+  }
+
+  return false;
+}
+
+void PeepholeOptimizer::Run(RegExpBytecodeWriter* dst) {
+  const int length = src_->length();
+  int pc = 0;
+  while (pc < length) {
+    new_offsets_[pc / kBytecodeAlignment] = dst->pc();
+    int next;
+    if (!TryFuse(dst, pc, &next)) {
+      next = pc + RegExpBytecodes::Size(RegExpBytecodes::FromPtr(At(pc)));
+      // Copies the jumps of the bytecode with their source targets.
+      dst->EmitRawBytecodeStream(src_, pc, next - pc);
+    }
+    pc = next;
+  }
+  new_offsets_[length / kBytecodeAlignment] = dst->pc();
+
+  // Retarget all jumps, including those of the fused bytecodes.
+  ZoneVector<std::pair<int, int>> jumps(dst->jump_edges().begin(),
+                                        dst->jump_edges().end(),
+                                        new_offsets_.zone());
+  for (const auto& [source, target] : jumps) {
+    ASSERT(Utils::IsAligned(target, kBytecodeAlignment));
+    const int new_target = new_offsets_[target / kBytecodeAlignment];
+    ASSERT(new_target >= 0);
+    dst->PatchJump(new_target, source);
+  }
+}
+
+#undef OPERAND
+
+}  // namespace
+
+TypedDataPtr RegExpBytecodePeepholeOptimization::OptimizeBytecode(
+    Zone* zone,
+    const String& source,
+    const RegExpBytecodeWriter* writer) {
+  RegExpBytecodeWriter optimized(zone);
+  PeepholeOptimizer optimizer(zone, writer);
+  optimizer.Run(&optimized);
+
+  if (FLAG_trace_regexp_peephole_optimization) {
+    const char* pattern = source.ToCString();
+    RegExpBytecodeDisassemble(writer->buffer().data(), writer->length(),
+                              pattern);
+    THR_Print("[optimized: %d -> %d bytes]\n", writer->length(),
+              optimized.length());
+    RegExpBytecodeDisassemble(optimized.buffer().data(), optimized.length(),
+                              pattern);
+  }
+
+  const TypedData& array = TypedData::Handle(
+      TypedData::New(kTypedDataUint8ArrayCid, optimized.length()));
+  NoSafepointScope no_safepoint;
+  optimized.CopyBufferTo(reinterpret_cast<uint8_t*>(array.DataAddr(0)));
+  return array.ptr();
+}
+
+}  // namespace dart
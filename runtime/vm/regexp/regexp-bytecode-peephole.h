@@ -0,0 +1,31 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
+#define V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
+
+#include "vm/object.h"
+
+namespace dart {
+
+class RegExpBytecodeWriter;
+class Zone;
+
+// Peephole optimization for regexp interpreter bytecode.
+// Pre-defined bytecode sequences occurring in the bytecode generated by the
+// RegExpBytecodeGenerator can be replaced with a single bytecode, the
+// interpreter then dispatches once per loop iteration rather than once per
+// bytecode of the sequence.
+class RegExpBytecodePeepholeOptimization : public AllStatic {
+ public:
+  // Performs peephole optimization on the bytecode emitted by `writer` and
+  // returns the optimized bytecode array.
+  static TypedDataPtr OptimizeBytecode(Zone* zone,
+                                       const String& source,
+                                       const RegExpBytecodeWriter* writer);
+};
+
+}  // namespace dart
+
+#endif  // V8_REGEXP_REGEXP_BYTECODE_PEEPHOLE_H_
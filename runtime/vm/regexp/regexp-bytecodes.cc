@@ -0,0 +1,52 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vm/regexp/regexp-bytecodes.h"
+
+#include "vm/log.h"
+#include "vm/regexp/regexp-bytecodes-inl.h"
+
+namespace dart {
+
+void RegExpBytecodeDisassembleSingle(const uint8_t* code_base,
+                                     const uint8_t* pc) {
+  const RegExpBytecode bytecode = RegExpBytecodes::FromPtr(pc);
+  THR_Print("%04" Pd ": %s", static_cast<intptr_t>(pc - code_base),
+            RegExpBytecodes::Name(bytecode));
+  RegExpBytecodes::DispatchOnBytecode(bytecode, [&]<RegExpBytecode bc>() {
+    using Operands = RegExpBytecodeOperands<bc>;
+    DisallowGarbageCollection no_gc;
+    Operands::ForEachOperand([&]<auto op>() {
+      const std::string_view name = Operands::Name(op);
+      THR_Print(" %.*s=", static_cast<int>(name.size()), name.data());
+      constexpr RegExpBytecodeOperandType type = Operands::Type(op);
+      if constexpr (type == RegExpBytecodeOperandType::kBitTable) {
+        const uint8_t* table = Operands::template Get<op>(pc, no_gc);
+        for (intptr_t i = 0; i < Operands::Size(op); i++) {
+          THR_Print("%02x", table[i]);
+        }
+      } else if constexpr (type == RegExpBytecodeOperandType::kJumpTarget) {
+        THR_Print("@%04" Pd, static_cast<intptr_t>(
+                                 Operands::template Get<op>(pc, no_gc)));
+      } else {
+        THR_Print("%" Pd64, static_cast<int64_t>(
+                                Operands::template Get<op>(pc, no_gc)));
+      }
+    });
+  });
+  THR_Print("\n");
+}
+
+void RegExpBytecodeDisassemble(const uint8_t* code_base,
+                               int length,
+                               const char* pattern) {
+  THR_Print("[generated bytecode for regexp pattern: '%s']\n", pattern);
+  const uint8_t* pc = code_base;
+  while (pc < code_base + length) {
+    RegExpBytecodeDisassembleSingle(code_base, pc);
+    pc += RegExpBytecodes::Size(RegExpBytecodes::FromPtr(pc));
+  }
+}
+
+}  // namespace dart
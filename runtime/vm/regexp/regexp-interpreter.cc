@@ -9,6 +9,7 @@
 #include <limits>
 
 #include "vm/exceptions.h"
+#include "vm/flags.h"
 #include "vm/regexp/regexp-bytecodes-inl.h"
 #include "vm/regexp/regexp-bytecodes.h"
 #include "vm/regexp/regexp-macro-assembler.h"
@@ -28,6 +29,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, enable_experimental_regexp_engine_on_excessive_backtracks);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 namespace {
 
 bool BackRefMatchesNoCase(Thread* thread,
@@ -576,7 +580,10 @@ IrregexpInterpreter::Result RawMatch(Thread* thread,
     }
     BYTECODE(Backtrack, return_code) {
       static_assert(JSRegExp::kNoBacktrackLimit == 0);
-      if (++backtrack_count == backtrack_limit) {
+      // Dart: The limit is global, only bytecode compiled for patterns the
+      // experimental engine can handle gives up when reaching it.
+      if (++backtrack_count == backtrack_limit &&
+          return_code == RegExpStatics::RE_FALLBACK_TO_EXPERIMENTAL) {
         return static_cast<IrregexpInterpreter::Result>(return_code);
       }
 
@@ -1132,6 +1139,9 @@ int IrregexpInterpreter::Match(Thread* thread,
   // output_register_count / registers_per_match;
 
   int backtrack_limit = JSRegExp::kNoBacktrackLimit;
+  if (FLAG_enable_experimental_regexp_engine_on_excessive_backtracks) {
+    backtrack_limit = FLAG_regexp_backtracks_before_fallback;
+  }
 
 #ifdef ENABLE_DISASSEMBLER
   if (v8_flags.trace_regexp_bytecodes) {
@@ -9,6 +9,10 @@
 #include <memory>
 #include <utility>
 
+#include "vm/canonical_tables.h"
+#include "vm/flags.h"
+#include "vm/object_store.h"
+#include "vm/regexp/experimental.h"
 #include "vm/regexp/regexp-bytecode-generator.h"
 #include "vm/regexp/regexp-bytecodes.h"
 #include "vm/regexp/regexp-compiler.h"
@@ -19,6 +23,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, enable_experimental_regexp_engine_on_excessive_backtracks);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 using namespace regexp_compiler_constants;  // NOLINT(build/namespaces)
 
 class RegExpImpl final : public AllStatic {
@@ -79,10 +86,25 @@ class RegExpImpl final : public AllStatic {
       bool is_one_byte,
       bool sticky,
       RegExpCompilationTarget compilation_target);
+  // As CompileIrregexpFromSource, but returns the error instead of throwing
+  // it, for callers without a Dart caller such as the precompiler.
+  static RegExpError TryCompileIrregexpFromSource(
+      Thread* thread,
+      const RegExp& re_data,
+      const String& sample_subject,
+      bool is_one_byte,
+      bool sticky,
+      RegExpCompilationTarget compilation_target);
   static bool CompileIrregexpFromBytecode(Isolate* isolate,
                                           const RegExp& re_data,
                                           const String& sample_subject,
                                           bool is_one_byte);
+  // Publishes the result of a successful compilation on the regexp.
+  static void SetCompiledBytecode(Thread* thread,
+                                  const RegExp& re_data,
+                                  RegExpCompileData* compile_data,
+                                  bool is_one_byte,
+                                  bool sticky);
   static inline bool EnsureCompiledIrregexp(Thread* thread,
                                             const RegExp& re_data,
                                             const String& sample_subject,
@@ -188,6 +210,148 @@ bool RegExpImpl::EnsureCompiledIrregexp(Thread* thread,
 
 namespace {
 
+// Appends the code units `tree` starts with to `prefix`. Returns true if all
+// of `tree` is a literal, so that the caller can keep appending the
+// following terms.
+bool AppendLiteralPrefix(RegExpTree* tree,
+                         RegExpFlags flags,
+                         ZoneGrowableArray<uint16_t>* prefix) {
+  if (tree->IsAtom()) {
+    for (uint16_t c : tree->AsAtom()->data()) {
+      prefix->Add(c);
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    for (const TextElement& element : *tree->AsText()->elements()) {
+      if (element.text_type() != TextElement::ATOM) return false;
+      if (!AppendLiteralPrefix(element.atom(), flags, prefix)) return false;
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    for (RegExpTree* node : *tree->AsAlternative()->nodes()) {
+      if (!AppendLiteralPrefix(node, flags, prefix)) return false;
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return AppendLiteralPrefix(tree->AsCapture()->body(), flags, prefix);
+  }
+  // Modifier groups such as (?i:...) change how their atoms match.
+  if (tree->IsGroup() && tree->AsGroup()->flags() == flags) {
+    return AppendLiteralPrefix(tree->AsGroup()->body(), flags, prefix);
+  }
+  return false;
+}
+
+// Returns the code units every match of `tree` starts with, or null if there
+// are none. `is_atom` is set if the pattern matches exactly these code units.
+TypedDataPtr LiteralPrefix(RegExpTree* tree, RegExpFlags flags, bool* is_atom) {
+  *is_atom = false;
+  // Case-insensitive atoms match more than their code units, and in unicode
+  // mode a lone surrogate must not match half of a surrogate pair.
+  if (IsIgnoreCase(flags) || IsEitherUnicode(flags)) return TypedData::null();
+  auto* prefix = new ZoneGrowableArray<uint16_t>();
+  const bool is_literal = AppendLiteralPrefix(tree, flags, prefix);
+  if (prefix->is_empty()) return TypedData::null();
+  *is_atom = is_literal;
+  const TypedData& result = TypedData::Handle(
+      TypedData::New(kTypedDataUint16ArrayCid, prefix->length()));
+  NoSafepointScope no_safepoint;
+  memcpy(result.DataAddr(0), prefix->data(),  // NOLINT
+         prefix->length() * sizeof(uint16_t));
+  return result.ptr();
+}
+
+// Prefixes at least this long are searched for with Boyer-Moore-Horspool in
+// subjects at least kMinBoyerMooreHorspoolSubjectLength long. Otherwise the
+// search scans for the first code unit, with memchr for one-byte subjects.
+static constexpr intptr_t kMinBoyerMooreHorspoolPrefixLength = 4;
+static constexpr intptr_t kMinBoyerMooreHorspoolSubjectLength = 256;
+
+template <typename SubjectChar>
+intptr_t FindFirstCharacter(const SubjectChar* subject,
+                            intptr_t length,
+                            intptr_t start,
+                            const uint16_t* prefix,
+                            intptr_t prefix_length) {
+  const SubjectChar first = static_cast<SubjectChar>(prefix[0]);
+  const intptr_t last_start = length - prefix_length;
+  for (intptr_t i = start; i <= last_start; i++) {
+    if (sizeof(SubjectChar) == 1) {
+      const void* found = memchr(subject + i, first, last_start - i + 1);
+      if (found == nullptr) return -1;
+      i = static_cast<const SubjectChar*>(found) - subject;
+    } else if (subject[i] != first) {
+      continue;
+    }
+    intptr_t j = 1;
+    while (j < prefix_length && subject[i + j] == prefix[j]) {
+      j++;
+    }
+    if (j == prefix_length) return i;
+  }
+  return -1;
+}
+
+template <typename SubjectChar>
+intptr_t FindBoyerMooreHorspool(const SubjectChar* subject,
+                                intptr_t length,
+                                intptr_t start,
+                                const uint16_t* prefix,
+                                intptr_t prefix_length) {
+  // Indexed by the low byte of the code unit, which only makes the shifts of
+  // two-byte code units sharing a low byte more conservative.
+  intptr_t shifts[256];
+  for (intptr_t i = 0; i < 256; i++) {
+    shifts[i] = prefix_length;
+  }
+  const intptr_t last = prefix_length - 1;
+  for (intptr_t i = 0; i < last; i++) {
+    shifts[prefix[i] & 0xFF] = last - i;
+  }
+  for (intptr_t i = start; i + last < length;) {
+    const SubjectChar c = subject[i + last];
+    if (c == prefix[last]) {
+      intptr_t j = 0;
+      while (j < last && subject[i + j] == prefix[j]) {
+        j++;
+      }
+      if (j == last) return i;
+    }
+    i += shifts[c & 0xFF];
+  }
+  return -1;
+}
+
+template <typename SubjectChar>
+intptr_t FindLiteral(const SubjectChar* subject,
+                     intptr_t length,
+                     intptr_t start,
+                     bool sticky,
+                     const uint16_t* prefix,
+                     intptr_t prefix_length) {
+  if (start + prefix_length > length) return -1;
+  if (sizeof(SubjectChar) == 1) {
+    for (intptr_t i = 0; i < prefix_length; i++) {
+      if (prefix[i] > 0xFF) return -1;
+    }
+  }
+  if (sticky) {
+    for (intptr_t i = 0; i < prefix_length; i++) {
+      if (subject[start + i] != prefix[i]) return -1;
+    }
+    return start;
+  }
+  if (prefix_length >= kMinBoyerMooreHorspoolPrefixLength &&
+      length - start >= kMinBoyerMooreHorspoolSubjectLength) {
+    return FindBoyerMooreHorspool(subject, length, start, prefix,
+                                  prefix_length);
+  }
+  return FindFirstCharacter(subject, length, start, prefix, prefix_length);
+}
+
 struct RegExpCaptureIndexLess {
   bool operator()(const RegExpCapture* lhs, const RegExpCapture* rhs) const {
     DCHECK_NOT_NULL(lhs);
@@ -235,13 +399,27 @@ bool RegExpImpl::CompileIrregexpFromSource(
     bool is_one_byte,
     bool sticky,
     RegExpCompilationTarget compilation_target) {
+  const RegExpError error = TryCompileIrregexpFromSource(
+      thread, re_data, sample_subject, is_one_byte, sticky, compilation_target);
+  if (error != RegExpError::kNone) {
+    RegExpStatics::ThrowRegExpException(thread->isolate(), re_data, error);
+    return false;
+  }
+  return true;
+}
+
+RegExpError RegExpImpl::TryCompileIrregexpFromSource(
+    Thread* thread,
+    const RegExp& re_data,
+    const String& sample_subject,
+    bool is_one_byte,
+    bool sticky,
+    RegExpCompilationTarget compilation_target) {
   // Since we can't abort gracefully during compilation, check for sufficient
   // stack space (including the additional gap as used for Turbofan
   // compilation) here in advance.
   if (!OSThread::Current()->HasStackHeadroom()) {
-    RegExpStatics::ThrowRegExpException(thread->isolate(), re_data,
-                                        RegExpError::kAnalysisStackOverflow);
-    return false;
+    return RegExpError::kAnalysisStackOverflow;
   }
 
   // Compile the RegExp.
@@ -260,52 +438,84 @@ bool RegExpImpl::CompileIrregexpFromSource(
   RegExpCompileData compile_data;
   if (!RegExpParser::ParseRegExpFromHeapString(thread->isolate(), zone, pattern,
                                                flags, &compile_data)) {
-    // Throw an exception if we fail to parse the pattern.
     // THIS SHOULD NOT HAPPEN. We already pre-parsed it successfully once.
-    USE(RegExpStatics::ThrowRegExpException(thread->isolate(), flags, pattern,
-                                            compile_data.error));
-    return false;
+    return compile_data.error;
   }
   compile_data.compilation_target = compilation_target;
+  bool is_atom = false;
+  TypedData& literal_prefix = TypedData::Handle(
+      zone, LiteralPrefix(compile_data.tree, flags, &is_atom));
+  if (is_atom && compile_data.capture_count == 0) {
+    // Pure literals are matched by a string search, without bytecode.
+    compile_data.code = &literal_prefix;
+    compile_data.register_count = JSRegExp::RegistersForCaptureCount(0);
+    SetCompiledBytecode(thread, re_data, &compile_data, is_one_byte, sticky);
+    return RegExpError::kNone;
+  }
+  re_data.set_literal_prefix(literal_prefix);
+  if (ExperimentalRegExp::IsPreferred(compile_data.tree, flags,
+                                      compile_data.capture_count)) {
+    compile_data.code = &TypedData::Handle(
+        zone, ExperimentalRegExp::Compile(compile_data.tree, flags, zone));
+    compile_data.register_count =
+        JSRegExp::RegistersForCaptureCount(compile_data.capture_count);
+    SetCompiledBytecode(thread, re_data, &compile_data, is_one_byte, sticky);
+    return RegExpError::kNone;
+  }
   const bool compilation_succeeded =
       Compile(thread->isolate(), zone, &compile_data, flags, pattern,
               sample_subject, re_data, is_one_byte);
   if (!compilation_succeeded) {
     ASSERT(compile_data.error != RegExpError::kNone);
-    RegExpStatics::ThrowRegExpException(thread->isolate(), re_data,
-                                        compile_data.error);
-    return false;
+    return compile_data.error;
   }
 
+  DCHECK_EQ(compile_data.compilation_target,
+            RegExpCompilationTarget::kBytecode);
+  SetCompiledBytecode(thread, re_data, &compile_data, is_one_byte, sticky);
+  return RegExpError::kNone;
+}
+
+void RegExpImpl::SetCompiledBytecode(Thread* thread,
+                                     const RegExp& re_data,
+                                     RegExpCompileData* compile_data,
+                                     bool is_one_byte,
+                                     bool sticky) {
   // Set num_bracket_expression after setting capture_name_map.
   // RegExp_getGroupNameMap will read num_bracket_expression first and assume
   // capture_name_map is available if the count is not -1.
-  const Array& capture_name_map =
-      Array::Handle(zone, RegExpStatics::CreateCaptureNameMap(
-                              thread->isolate(), compile_data.named_captures));
+  const Array& capture_name_map = Array::Handle(
+      thread->zone(), RegExpStatics::CreateCaptureNameMap(
+                          thread->isolate(), compile_data->named_captures));
   re_data.set_capture_name_map(capture_name_map);
   re_data.set_num_bracket_expressions<std::memory_order_release>(
-      compile_data.capture_count);
+      compile_data->capture_count);
 
   // Set bytecode after setting num_registers. RegExpStatics::Interpret will
   // read bytecode first and assume num_register is available if bytecode is not
   // null.
-  re_data.set_num_registers(is_one_byte, compile_data.register_count);
-  DCHECK_EQ(compile_data.compilation_target,
-            RegExpCompilationTarget::kBytecode);
+  re_data.set_num_registers(is_one_byte, compile_data->register_count);
   re_data.set_bytecode(is_one_byte, sticky,
-                       TypedData::Cast(*compile_data.code));
-
-  return true;
+                       TypedData::Cast(*compile_data->code));
 }
 
 namespace {
 
 void SetBacktrackAndExperimentalFallback(RegExpMacroAssembler* macro_assembler,
-                                         const RegExp& re_data) {
+                                         RegExpCompileData* data,
+                                         RegExpFlags flags) {
+  // Dart has no user-specified backtrack limit, so the bytecode only returns
+  // RE_FALLBACK_TO_EXPERIMENTAL when it can fall back, see
+  // IrregexpInterpreter::Match.
+  const bool can_fallback =
+      FLAG_enable_experimental_regexp_engine_on_excessive_backtracks &&
+      ExperimentalRegExp::CanBeHandled(data->tree, flags, data->capture_count);
   uint32_t backtrack_limit = JSRegExp::kNoBacktrackLimit;
+  if (can_fallback) {
+    backtrack_limit = FLAG_regexp_backtracks_before_fallback;
+  }
   macro_assembler->set_backtrack_limit(backtrack_limit);
-  macro_assembler->set_can_fallback(false);
+  macro_assembler->set_can_fallback(can_fallback);
 }
 
 }  // namespace
@@ -417,7 +627,7 @@ bool RegExpImpl::Compile(Isolate* isolate,
   }
 
   macro_assembler->set_slow_safe(TooMuchRegExpCode(isolate, pattern));
-  SetBacktrackAndExperimentalFallback(macro_assembler.get(), re_data);
+  SetBacktrackAndExperimentalFallback(macro_assembler.get(), data, flags);
 
   // Inserted here, instead of in Assembler, because it depends on information
   // in the AST that isn't replicated in the Node structure.
@@ -481,6 +691,21 @@ bool RegExpImpl::Compile(Isolate* isolate,
   return result.Succeeded();
 }
 
+intptr_t RegExpStatics::AtomExecRaw(const TypedData& atom,
+                                    const String& subject,
+                                    intptr_t index,
+                                    bool sticky) {
+  ASSERT(atom.GetClassId() == kTypedDataUint16ArrayCid);
+  NoSafepointScope no_safepoint;
+  const uint16_t* prefix = reinterpret_cast<const uint16_t*>(atom.DataAddr(0));
+  if (subject.IsOneByteString()) {
+    return FindLiteral(OneByteString::DataStart(subject), subject.Length(),
+                       index, sticky, prefix, atom.Length());
+  }
+  return FindLiteral(TwoByteString::DataStart(subject), subject.Length(), index,
+                     sticky, prefix, atom.Length());
+}
+
 std::ostream& operator<<(std::ostream& os, RegExpFlags flags) {
 #define V(Lower, Camel, LowerCamel, Char, Bit)                                 \
   if (flags & RegExpFlag::k##Camel) os << Char;
@@ -489,11 +714,58 @@ std::ostream& operator<<(std::ostream& os, RegExpFlags flags) {
   return os;
 }
 
-ObjectPtr RegExpStatics::Interpret(Thread* thread,
-                                   const RegExp& regexp,
-                                   const String& subject,
-                                   int start_index,
-                                   bool sticky) {
+RegExpFlags RegExpStatics::FlagsFor(bool multi_line,
+                                   bool case_sensitive,
+                                   bool unicode,
+                                   bool dot_all) {
+  RegExpFlags flags;
+  flags |= RegExpFlag::kGlobal;  // All dart regexps are global.
+  if (!case_sensitive) flags |= RegExpFlag::kIgnoreCase;
+  if (multi_line) flags |= RegExpFlag::kMultiline;
+  if (unicode) flags |= RegExpFlag::kUnicode;
+  if (dot_all) flags |= RegExpFlag::kDotAll;
+  return flags;
+}
+
+RegExpPtr RegExpStatics::Canonicalize(Thread* thread,
+                                      const String& pattern,
+                                      RegExpFlags flags) {
+  Zone* zone = thread->zone();
+  RegExpKey lookup_symbol_key(
+      String::Handle(zone, Symbols::New(thread, pattern)), flags);
+  RegExp& regexp = RegExp::Handle(zone);
+  SafepointMutexLocker ml(thread->isolate_group()->symbols_mutex());
+  CanonicalRegExpSet table(
+      zone, thread->isolate_group()->object_store()->regexp_table());
+  regexp ^= table.InsertNewOrGet(lookup_symbol_key);
+  thread->isolate_group()->object_store()->set_regexp_table(table.Release());
+  return regexp.ptr();
+}
+
+bool RegExpStatics::CompileAheadOfTime(Thread* thread, const RegExp& regexp) {
+  // The sample subject only guides heuristics of the compiler.
+  const String& sample_subject = Symbols::Empty();
+  for (const bool sticky : {false, true}) {
+    for (const bool is_one_byte : {true, false}) {
+      if (regexp.bytecode(is_one_byte, sticky) != TypedData::null()) {
+        continue;
+      }
+      if (RegExpImpl::TryCompileIrregexpFromSource(
+              thread, regexp, sample_subject, is_one_byte, sticky,
+              RegExpCompilationTarget::kBytecode) != RegExpError::kNone) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compiles `regexp` for the representation of `subject` if it has no
+// bytecode for it yet.
+static void EnsureCompiled(Thread* thread,
+                           const RegExp& regexp,
+                           const String& subject,
+                           bool sticky) {
   bool is_one_byte = subject.IsOneByteString();
   if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
     if (!RegExpImpl::CompileIrregexpFromSource(
@@ -503,51 +775,151 @@ ObjectPtr RegExpStatics::Interpret(Thread* thread,
       UNREACHABLE();
     }
   }
+}
 
-  int register_count = regexp.num_registers(is_one_byte);
-  ASSERT(register_count >= 2);
-  int32_t* registers = thread->zone()->Alloc<int32_t>(register_count);
-
+// Runs a single match of the compiled `regexp` against `subject`, starting at
+// `start_index`. On success the capture offsets are in `registers`.
+static int ExecRaw(Thread* thread,
+                   const RegExp& regexp,
+                   const String& subject,
+                   int start_index,
+                   bool sticky,
+                   int32_t* registers,
+                   int register_count) {
+  bool is_one_byte = subject.IsOneByteString();
   for (intptr_t i = 0; i < register_count; i++) {
     registers[i] = -1;
   }
 
-  int r = IrregexpInterpreter::MatchForCallFromRuntime(
-      thread, regexp, subject, registers, register_count, start_index, sticky);
-  if (r == IrregexpInterpreter::SUCCESS) {
-    const TypedData& result = TypedData::Handle(
-        thread->zone(),
-        TypedData::New(kTypedDataInt32ArrayCid, register_count));
-    {
-#ifdef DEBUG
-      // These indices will be used with substring operations that don't check
-      // bounds, so sanity check them here.
+  const TypedData& bytecode =
+      TypedData::Handle(thread->zone(), regexp.bytecode(is_one_byte, sticky));
+  // Loaded after the bytecode, which is published after the prefix.
+  const TypedData& literal_prefix =
+      TypedData::Handle(thread->zone(), regexp.literal_prefix());
+  if (!literal_prefix.IsNull()) {
+    // No match can start before the next occurrence of the prefix.
+    const intptr_t index = RegExpStatics::AtomExecRaw(literal_prefix, subject,
+                                                      start_index, sticky);
+    if (index < 0) return IrregexpInterpreter::FAILURE;
+    start_index = index;
+  }
+  int r;
+  if (bytecode.GetClassId() == kTypedDataUint16ArrayCid) {
+    // The pattern is a literal, see CompileIrregexpFromSource.
+    const intptr_t index =
+        RegExpStatics::AtomExecRaw(bytecode, subject, start_index, sticky);
+    if (index < 0) return IrregexpInterpreter::FAILURE;
+    registers[0] = index;
+    registers[1] = index + bytecode.Length();
+    r = IrregexpInterpreter::SUCCESS;
+  } else if (ExperimentalRegExp::IsExperimentalBytecode(bytecode)) {
+    r = ExperimentalRegExp::MatchForCallFromRuntime(
+        thread, bytecode, regexp.num_bracket_expressions(), subject,
+        start_index, registers);
+  } else {
+    r = IrregexpInterpreter::MatchForCallFromRuntime(
+        thread, regexp, subject, registers, register_count, start_index,
+        sticky);
+    if (r == IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL) {
+      // The backtracking engine exceeded its backtrack budget. The pattern is
+      // recompiled for every fallback rather than replacing the bytecode, as
+      // other mutators may be running the irregexp bytecode.
       for (intptr_t i = 0; i < register_count; i++) {
-        int32_t val = registers[i];
-        ASSERT(val == -1 || (val >= 0 && val <= subject.Length()));
+        registers[i] = -1;
       }
-#endif
-
-      NoSafepointScope no_safepoint(thread);
-      memcpy(result.DataAddr(0), registers,
-             register_count * sizeof(int32_t));  // NOLINT
+      r = ExperimentalRegExp::OneshotExec(thread, regexp, subject, start_index,
+                                          sticky, registers);
     }
-
-    return result.ptr();
-  } else if (r == IrregexpInterpreter::FAILURE) {
-    return Instance::null();
-  } else if (r == IrregexpInterpreter::EXCEPTION) {
+  }
+  if (r == IrregexpInterpreter::EXCEPTION) {
     const Error& error = Error::Handle(thread->StealStickyError());
     Exceptions::PropagateError(error);
     UNREACHABLE();
   } else if (r == IrregexpInterpreter::RETRY) {
     UNREACHABLE();  // No tier up in Dart.
-  } else if (r == IrregexpInterpreter::FALLBACK_TO_EXPERIMENTAL) {
-    UNREACHABLE();  // No alt implementation for Dart.
-  } else {
-    UNREACHABLE();
   }
-  return Instance::null();
+  ASSERT(r == IrregexpInterpreter::SUCCESS ||
+         r == IrregexpInterpreter::FAILURE);
+#ifdef DEBUG
+  if (r == IrregexpInterpreter::SUCCESS) {
+    // These indices will be used with substring operations that don't check
+    // bounds, so sanity check them here.
+    for (intptr_t i = 0; i < register_count; i++) {
+      int32_t val = registers[i];
+      ASSERT(val == -1 || (val >= 0 && val <= subject.Length()));
+    }
+  }
+#endif
+  return r;
+}
+
+ObjectPtr RegExpStatics::Interpret(Thread* thread,
+                                   const RegExp& regexp,
+                                   const String& subject,
+                                   int start_index,
+                                   bool sticky) {
+  EnsureCompiled(thread, regexp, subject, sticky);
+
+  int register_count = regexp.num_registers(subject.IsOneByteString());
+  ASSERT(register_count >= 2);
+  int32_t* registers = thread->zone()->Alloc<int32_t>(register_count);
+  if (ExecRaw(thread, regexp, subject, start_index, sticky, registers,
+              register_count) == IrregexpInterpreter::FAILURE) {
+    return Instance::null();
+  }
+
+  const TypedData& result = TypedData::Handle(
+      thread->zone(), TypedData::New(kTypedDataInt32ArrayCid, register_count));
+  NoSafepointScope no_safepoint(thread);
+  memcpy(result.DataAddr(0), registers,
+         register_count * sizeof(int32_t));  // NOLINT
+  return result.ptr();
+}
+
+intptr_t RegExpStatics::InterpretGlobal(Thread* thread,
+                                        const RegExp& regexp,
+                                        const String& subject,
+                                        int start_index,
+                                        const TypedData& matches) {
+  ASSERT(matches.GetClassId() == kTypedDataInt32ArrayCid);
+  EnsureCompiled(thread, regexp, subject, /*sticky=*/false);
+
+  const int register_count = regexp.num_registers(subject.IsOneByteString());
+  ASSERT(register_count >= 2);
+  int32_t* registers = thread->zone()->Alloc<int32_t>(register_count);
+  const intptr_t capture_registers =
+      (regexp.num_bracket_expressions() + 1) * 2;
+  ASSERT(capture_registers <= register_count);
+  const intptr_t max_matches = matches.Length() / capture_registers;
+  const intptr_t length = subject.Length();
+  const bool is_unicode = IsUnicode(regexp.flags());
+
+  intptr_t count = 0;
+  intptr_t index = start_index;
+  while (count < max_matches && index <= length) {
+    if (ExecRaw(thread, regexp, subject, index, /*sticky=*/false, registers,
+                register_count) == IrregexpInterpreter::FAILURE) {
+      break;
+    }
+    {
+      NoSafepointScope no_safepoint(thread);
+      memcpy(matches.DataAddr(count * capture_registers * sizeof(int32_t)),
+             registers, capture_registers * sizeof(int32_t));  // NOLINT
+    }
+    count++;
+    // Continue after the match, or after the character at an empty match.
+    // A surrogate pair is a single character in unicode mode.
+    index = registers[1];
+    if (index == registers[0]) {
+      if (is_unicode && index + 1 < length &&
+          Utf16::IsLeadSurrogate(subject.CharAt(index)) &&
+          Utf16::IsTrailSurrogate(subject.CharAt(index + 1))) {
+        index++;
+      }
+      index++;
+    }
+  }
+  return count;
 }
 
 }  // namespace dart
@@ -132,13 +132,13 @@ class RegExpStatics final : public AllStatic {
       int32_t* result_offsets_vector,
       uint32_t result_offsets_vector_length);
 
-  // Called directly from generated code through ExternalReference.
-  static intptr_t AtomExecRaw(Isolate* isolate,
-                              uword /* AtomRegExpData */ data_address,
-                              uword /* String */ subject_address,
-                              int32_t index,
-                              int32_t* result_offsets_vector,
-                              int32_t result_offsets_vector_length);
+  // Returns the index of the first occurrence of the Uint16 code units of
+  // `atom` in `subject` at or after `index`, or -1. If `sticky`, only an
+  // occurrence at `index` is considered.
+  static intptr_t AtomExecRaw(const TypedData& atom,
+                              const String& subject,
+                              intptr_t index,
+                              bool sticky);
 
   // Integral return values used throughout regexp code layers.
   static constexpr int kInternalRegExpFailure = 0;
@@ -192,11 +192,40 @@ class RegExpStatics final : public AllStatic {
       Isolate* isolate,
       ZoneVector<RegExpCapture*>* named_captures);
 
+  // The flags of a Dart RegExp created with the given constructor arguments.
+  static RegExpFlags FlagsFor(bool multi_line,
+                              bool case_sensitive,
+                              bool unicode,
+                              bool dot_all);
+
+  // Returns the RegExp for `pattern` and `flags` from the isolate group's
+  // table of canonical regexps, adding a new one if there is none. The
+  // pattern must parse successfully.
+  static RegExpPtr Canonicalize(Thread* thread,
+                                const String& pattern,
+                                RegExpFlags flags);
+
+  // Compiles the bytecode of `regexp` for all kinds of subjects ahead of
+  // its first match, e.g. to include it in an AOT snapshot. Returns false
+  // without throwing if the pattern cannot be compiled; the error is then
+  // thrown by its first match.
+  static bool CompileAheadOfTime(Thread* thread, const RegExp& regexp);
+
   static ObjectPtr Interpret(Thread* thread,
                              const RegExp& regexp,
                              const String& subject,
                              int start_index,
                              bool sticky);
+
+  // Finds successive matches of `regexp` in `subject` from `start_index`,
+  // continuing after each match the way RegExp.allMatches does. The capture
+  // offsets of each match are stored in the Int32List `matches` until it is
+  // full. Returns the number of matches stored.
+  static intptr_t InterpretGlobal(Thread* thread,
+                                  const RegExp& regexp,
+                                  const String& subject,
+                                  int start_index,
+                                  const TypedData& matches);
 };
 
 }  // namespace dart
@@ -6,12 +6,19 @@
 
 #include "vm/isolate.h"
 #include "vm/object.h"
+#include "vm/regexp/experimental.h"
+#include "vm/regexp/regexp-bytecodes-inl.h"
 #include "vm/regexp/regexp.h"
 #include "vm/symbols.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, enable_experimental_regexp_engine_on_excessive_backtracks);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+DECLARE_FLAG(bool, experimental_regexp_engine_for_nested_quantifiers);
+DECLARE_FLAG(bool, regexp_peephole_optimization);
+
 static ObjectPtr Match(const String& pattern, const String& subject) {
   const RegExp& regexp = RegExp::Handle(RegExp::New(pattern, RegExpFlags()));
   return RegExpStatics::Interpret(Thread::Current(), regexp, subject, 0,
@@ -48,4 +55,262 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, res.GetInt32(1 * sizeof(int32_t)));
 }
 
+ISOLATE_UNIT_TEST_CASE(RegExp_Atom) {
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New("needle\\."))));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+
+  // Long enough for a Boyer-Moore-Horspool search.
+  const String& haystack = String::Handle(String::New(
+      "needle needl needle! eedle. needle needle needle needle needle needle "
+      "needle needle needle needle needle needle needle needle needle needle "
+      "needle needle needle needle needle needle needle needle needle needle "
+      "needle needle needle needle needle needle needle needle needle needle "
+      "needle. needle."));
+  const intptr_t expected = haystack.Length() - 15;
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, haystack, 0,
+                                  /*sticky=*/false);
+  EXPECT_EQ(2, res.Length());
+  EXPECT_EQ(expected, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(expected + 7, res.GetInt32(1 * sizeof(int32_t)));
+  const TypedData& bytecode = TypedData::Handle(
+      regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false));
+  EXPECT_EQ(kTypedDataUint16ArrayCid, bytecode.GetClassId());
+
+  res ^= RegExpStatics::Interpret(thread, regexp, haystack, expected + 1,
+                                  /*sticky=*/false);
+  EXPECT_EQ(expected + 8, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, haystack, expected + 9,
+                                  /*sticky=*/false) == Instance::null());
+
+  EXPECT(RegExpStatics::Interpret(thread, regexp, haystack, 0,
+                                  /*sticky=*/true) == Instance::null());
+  res ^= RegExpStatics::Interpret(thread, regexp, haystack, expected,
+                                  /*sticky=*/true);
+  EXPECT_EQ(expected, res.GetInt32(0 * sizeof(int32_t)));
+
+  uint16_t chars[] = {0x3b1, 'n', 'e', 'e', 'd', 'l', 'e', '.'};
+  const String& two_byte = String::Handle(
+      TwoByteString::New(chars, ARRAY_SIZE(chars), Heap::kNew));
+  res ^= RegExpStatics::Interpret(thread, regexp, two_byte, 0,
+                                  /*sticky=*/false);
+  EXPECT_EQ(1, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(8, res.GetInt32(1 * sizeof(int32_t)));
+
+  // Case-insensitive patterns are not matched as atoms.
+  const RegExp& regexp_i = RegExp::Handle(
+      RegExp::New(pat, RegExpFlags(RegExpFlag::kIgnoreCase)));
+  const String& upper = String::Handle(String::New("NEEDLE."));
+  res ^= RegExpStatics::Interpret(thread, regexp_i, upper, 0,
+                                  /*sticky=*/false);
+  EXPECT_EQ(0, res.GetInt32(0 * sizeof(int32_t)));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LiteralPrefix) {
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New("foo(\\d+)"))));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+
+  const String& str = String::Handle(String::New("xx foo foo12"));
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, str, 0, /*sticky=*/false);
+  EXPECT_LE(4, res.Length());
+  EXPECT_EQ(7, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(12, res.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(10, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(12, res.GetInt32(3 * sizeof(int32_t)));
+  const TypedData& prefix = TypedData::Handle(regexp.literal_prefix());
+  EXPECT_EQ(3, prefix.Length());
+
+  const String& str2 = String::Handle(String::New("xx fo12 foo"));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, str2, 0, /*sticky=*/false) ==
+         Instance::null());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_ExperimentalNestedQuantifiers) {
+  SetFlagScope<bool> sfs(&FLAG_experimental_regexp_engine_for_nested_quantifiers,
+                         true);
+
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New("(a+)+b"))));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+
+  // Exponential in the length of the subject for a backtracking engine.
+  const String& str = String::Handle(
+      String::New("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac"));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, str, 0, /*sticky=*/false) ==
+         Instance::null());
+  const TypedData& bytecode = TypedData::Handle(
+      regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false));
+  EXPECT(ExperimentalRegExp::IsExperimentalBytecode(bytecode));
+
+  const String& str2 = String::Handle(String::New("xaabx"));
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, str2, 0, /*sticky=*/false);
+  EXPECT_LE(4, res.Length());
+  EXPECT_EQ(1, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(4, res.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(1, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(3, res.GetInt32(3 * sizeof(int32_t)));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_ExperimentalFallback) {
+  SetFlagScope<bool> sfs(&FLAG_experimental_regexp_engine_for_nested_quantifiers,
+                         false);
+  SetFlagScope<bool> sfs_fallback(
+      &FLAG_enable_experimental_regexp_engine_on_excessive_backtracks, true);
+  SetFlagScope<int> sfs_limit(&FLAG_regexp_backtracks_before_fallback, 100);
+
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New("(a+)+b"))));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+
+  // The failed attempts at the start of the subject exceed the backtrack
+  // limit, the match is then found by the linear-time engine.
+  const String& str =
+      String::Handle(String::New("aaaaaaaaaaaaaaaaaaaaaaaaaaaac aab"));
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, str, 0, /*sticky=*/false);
+  EXPECT_LE(4, res.Length());
+  EXPECT_EQ(30, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(33, res.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(30, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(32, res.GetInt32(3 * sizeof(int32_t)));
+  const TypedData& bytecode = TypedData::Handle(
+      regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false));
+  EXPECT(!ExperimentalRegExp::IsExperimentalBytecode(bytecode));
+
+  const String& str2 = String::Handle(String::New("aaaaaaaaaaaaaaaaaaaaaaaac"));
+  EXPECT(RegExpStatics::Interpret(thread, regexp, str2, 0, /*sticky=*/false) ==
+         Instance::null());
+}
+
+// Whether [bytecode] contains one of the SkipUntil* bytecodes emitted by the
+// peephole optimizer.
+static bool ContainsSkipUntil(const TypedData& bytecode) {
+  if (bytecode.IsNull() ||
+      ExperimentalRegExp::IsExperimentalBytecode(bytecode)) {
+    return false;
+  }
+  NoSafepointScope no_safepoint;
+  const uint8_t* code = reinterpret_cast<const uint8_t*>(bytecode.DataAddr(0));
+  for (intptr_t pc = 0; pc < bytecode.LengthInBytes();) {
+    const RegExpBytecode bc = RegExpBytecodes::FromPtr(code + pc);
+    if (strncmp(RegExpBytecodes::Name(bc), "SkipUntil", 9) == 0) {
+      return true;
+    }
+    pc += RegExpBytecodes::Size(bc);
+  }
+  return false;
+}
+
+// Returns whether the optimized bytecode contains a SkipUntil* bytecode.
+static bool ExpectSameMatch(const char* pattern, const String& subject) {
+  Thread* thread = Thread::Current();
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New(pattern))));
+  Object& expected = Object::Handle();
+  Object& actual = Object::Handle();
+  {
+    SetFlagScope<bool> sfs(&FLAG_regexp_peephole_optimization, false);
+    expected = Match(pat, subject);
+  }
+  bool fused;
+  {
+    SetFlagScope<bool> sfs(&FLAG_regexp_peephole_optimization, true);
+    const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+    actual = RegExpStatics::Interpret(thread, regexp, subject, 0,
+                                      /*sticky=*/false);
+    fused = ContainsSkipUntil(TypedData::Handle(regexp.bytecode(
+        subject.IsOneByteString(), /*sticky=*/false)));
+  }
+  EXPECT_EQ(expected.IsNull(), actual.IsNull());
+  if (expected.IsNull() || actual.IsNull()) return fused;
+  const TypedData& expected_registers = TypedData::Cast(expected);
+  const TypedData& actual_registers = TypedData::Cast(actual);
+  EXPECT_EQ(expected_registers.Length(), actual_registers.Length());
+  for (intptr_t i = 0; i < expected_registers.Length(); i++) {
+    EXPECT_EQ(expected_registers.GetInt32(i * sizeof(int32_t)),
+              actual_registers.GetInt32(i * sizeof(int32_t)));
+  }
+  return fused;
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_PeepholeOptimization) {
+  // Patterns whose scanning loops are fused into SkipUntil* bytecodes.
+  const char* const patterns[] = {
+      "[a-c]x", "ab|cd", "x[0-9]+", "(a|b)c", "[^a-y]z", "[Aa]bcd|[Dd]efg",
+  };
+  const uint16_t two_byte[] = {0x100, 'a', 'b', 0x101, 'c', 'd', 'z', 'z',
+                               'x', '1', '2', 'D', 'e', 'f', 'g', 'b', 'c'};
+  const String* const subjects[] = {
+      &String::Handle(String::New("")),
+      &String::Handle(String::New("qqqqqqqq")),
+      &String::Handle(String::New("qqqbxqqcd x12 zzbc Defg")),
+      &String::Handle(String::FromUTF16(two_byte, ARRAY_SIZE(two_byte))),
+  };
+  intptr_t fused = 0;
+  for (const char* pattern : patterns) {
+    for (const String* subject : subjects) {
+      if (ExpectSameMatch(pattern, *subject)) {
+        fused++;
+      }
+    }
+  }
+  // The optimization was not a no-op.
+  EXPECT_LT(0, fused);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_InterpretGlobal) {
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New("(a)*"))));
+  const RegExp& regexp = RegExp::Handle(RegExp::New(pat, RegExpFlags()));
+  const String& str = String::Handle(String::New("baab"));
+
+  // Empty matches continue after the next character.
+  TypedData& matches =
+      TypedData::Handle(TypedData::New(kTypedDataInt32ArrayCid, 5 * 4));
+  EXPECT_EQ(4, RegExpStatics::InterpretGlobal(thread, regexp, str, 0, matches));
+  const int32_t expected[] = {0, 0, -1, -1, 1, 3, 2, 3,
+                              3, 3, -1, -1, 4, 4, -1, -1};
+  for (size_t i = 0; i < ARRAY_SIZE(expected); i++) {
+    EXPECT_EQ(expected[i], matches.GetInt32(i * sizeof(int32_t)));
+  }
+
+  // Stops once the matches are full.
+  matches = TypedData::New(kTypedDataInt32ArrayCid, 2 * 4 + 3);
+  EXPECT_EQ(2, RegExpStatics::InterpretGlobal(thread, regexp, str, 1, matches));
+  EXPECT_EQ(1, matches.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(3, matches.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(3, matches.GetInt32(4 * sizeof(int32_t)));
+  EXPECT_EQ(3, matches.GetInt32(5 * sizeof(int32_t)));
+
+  EXPECT_EQ(0, RegExpStatics::InterpretGlobal(thread, regexp, str, 5, matches));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_CompileAheadOfTime) {
+  const String& pat = String::Handle(String::New("(a|b)+c"));
+  const RegExpFlags flags = RegExpStatics::FlagsFor(
+      /*multi_line=*/false, /*case_sensitive=*/true, /*unicode=*/false,
+      /*dot_all=*/false);
+  const RegExp& regexp =
+      RegExp::Handle(RegExpStatics::Canonicalize(thread, pat, flags));
+  EXPECT_EQ(regexp.ptr(), RegExpStatics::Canonicalize(thread, pat, flags));
+
+  EXPECT(RegExpStatics::CompileAheadOfTime(thread, regexp));
+  for (const bool sticky : {false, true}) {
+    for (const bool is_one_byte : {true, false}) {
+      EXPECT(regexp.bytecode(is_one_byte, sticky) != TypedData::null());
+    }
+  }
+  EXPECT_EQ(1, regexp.num_bracket_expressions());
+
+  const String& str = String::Handle(String::New("xxabac"));
+  TypedData& res = TypedData::Handle();
+  res ^= RegExpStatics::Interpret(thread, regexp, str, 0, /*sticky=*/false);
+  EXPECT_EQ(2, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(6, res.GetInt32(1 * sizeof(int32_t)));
+}
+
 }  // namespace dart
@@ -83,6 +83,7 @@ DEFINE_FLAG(bool,
 DECLARE_FLAG(int, max_deoptimization_counter_threshold);
 DECLARE_FLAG(bool, trace_compiler);
 DECLARE_FLAG(bool, trace_optimizing_compiler);
+DECLARE_FLAG(bool, background_osr);
 DECLARE_FLAG(int, max_polymorphic_checks);
 
 DEFINE_FLAG(bool, trace_osr, false, "Trace attempts at on-stack replacement.");
@@ -4672,6 +4673,10 @@ static void HandleStackOverflowTestCases(Thread* thread) {
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+// Number of loop iterations between checks for a finished background OSR
+// compilation.
+static constexpr int32_t kBackgroundOsrPollIterations = 1000;
+
 static void HandleOSRRequest(Thread* thread) {
   auto isolate_group = thread->isolate_group();
   ASSERT(isolate_group->use_osr());
@@ -4713,11 +4718,29 @@ static void HandleOSRRequest(Thread* thread) {
                  function.usage_counter());
   }
 
+  Object& result = Object::Handle();
+  if (FLAG_background_compilation && FLAG_background_osr) {
+    BackgroundCompiler* background_compiler =
+        isolate_group->background_compiler();
+    result = background_compiler->TakeOsrCode(function, osr_id);
+    if (result.IsNull()) {
+      if (background_compiler->EnqueueCompilation(function, osr_id)) {
+        // Keep running the unoptimized code, but only come back to check
+        // for the result after a number of further iterations.
+        function.SetUsageCounter(function.usage_counter() -
+                                 kBackgroundOsrPollIterations);
+        return;
+      }
+      // Background compiler is disabled, compile in the foreground.
+    }
+  }
+
   // Since the code is referenced from the frame and the ZoneHandle,
   // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  ThrowIfError(result);
+  if (result.IsNull()) {
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    ThrowIfError(result);
+  }
 
   if (!result.IsNull()) {
     const Code& code = Code::Cast(result);
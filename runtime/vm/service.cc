@@ -24,11 +24,13 @@
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
+#include "vm/event_loop_stats.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/kernel.h"
 #include "vm/kernel_isolate.h"
+#include "vm/lock_profiler.h"
 #include "vm/lockers.h"
 #include "vm/message.h"
 #include "vm/message_handler.h"
@@ -5311,6 +5313,36 @@ static void GetPortsPrivate(Thread* thread, JSONStream* js) {
   PortMap::PrintPortsForMessageHandler(message_handler, js);
 }
 
+static const MethodParameter* const get_lock_contention_profile_params[] = {
+    NO_ISOLATE_PARAMETER,
+    new BoolParameter("reset", /*required=*/false),
+    nullptr,
+};
+
+static void GetLockContentionProfile(Thread* thread, JSONStream* js) {
+  LockProfiler::PrintJSON(js);
+  if (BoolParameter::Parse(js->LookupParam("reset"), false)) {
+    LockProfiler::Clear();
+  }
+}
+
+static const MethodParameter* const get_event_loop_latency_params[] = {
+    ISOLATE_PARAMETER,
+    nullptr,
+};
+
+static void GetEventLoopLatency(Thread* thread, JSONStream* js) {
+  EventLoopStats* stats =
+      thread->isolate()->message_handler()->event_loop_stats();
+  if (stats == nullptr) {
+    js->PrintError(kFeatureDisabled,
+                   "_getEventLoopLatency is only available when the VM is "
+                   "started with the flag --record-event-loop-latency.");
+    return;
+  }
+  stats->PrintJSON(js);
+}
+
 static void RespondWithMalformedJson(Thread* thread, JSONStream* js) {
   JSONObject jsobj(js);
   jsobj.AddProperty("a", "a");
@@ -6412,6 +6444,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_class_list_params },
   { "getCpuSamples", GetCpuSamples,
     get_cpu_samples_params },
+  { "_getEventLoopLatency", GetEventLoopLatency,
+    get_event_loop_latency_params },
   { "getFlagList", GetFlagList,
     get_flag_list_params },
   { "_getHeapMap", GetHeapMap,
@@ -6448,6 +6482,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_isolate_metric_list_params },
   { "getIsolatePauseEvent", GetIsolatePauseEvent,
     get_isolate_pause_event_params },
+  { "_getLockContentionProfile", GetLockContentionProfile,
+    get_lock_contention_profile_params },
   { "getObject", GetObject,
     get_object_params },
   { "_getObjectStore", GetObjectStore,
@@ -22,6 +22,10 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, record_snapshot_load_report);
+DECLARE_FLAG(int, snapshot_fill_tasks);
+DECLARE_FLAG(int, snapshot_parallel_fill_min_bytes);
+
 // Check if serialized and deserialized objects are equal.
 static bool Equals(const Object& expected, const Object& actual) {
   if (expected.IsNull()) {
@@ -791,6 +795,225 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
   free(isolate_snapshot_data_buffer);
 }
 
+VM_UNIT_TEST_CASE(FullSnapshotLoadReport) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  final int x = 42;\n"
+      "}\n";
+
+  uint8_t* isolate_snapshot_data_buffer;
+  {
+    TestIsolateScope __test_isolate__;
+    TestCase::LoadTestScript(kScriptChars, nullptr);
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+
+    MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+    FullSnapshotWriter writer(Snapshot::kFull, &isolate_snapshot_data,
+                              /*image_writer=*/nullptr);
+    writer.WriteFullSnapshot();
+    intptr_t unused;
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&unused);
+  }
+
+  SetFlagScope<bool> sfs(&FLAG_record_snapshot_load_report, true);
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  Dart_ShutdownIsolate();
+  free(isolate_snapshot_data_buffer);
+
+  char* report = Dart_GetSnapshotLoadReport();
+  EXPECT_NOTNULL(report);
+  EXPECT_SUBSTRING("\"type\":\"SnapshotLoadReport\"", report);
+  EXPECT_SUBSTRING("\"kind\":\"full\"", report);
+  EXPECT_SUBSTRING("\"name\":\"Class\"", report);
+  EXPECT_SUBSTRING("\"heapBytes\":", report);
+  EXPECT_SUBSTRING("\"loadMicros\":", report);
+  free(report);
+}
+
+// Loads an isolate from [snapshot] and returns the result of calling
+// [function], which must return a string.
+static char* LoadSnapshotAndInvoke(uint8_t* snapshot, const char* function) {
+  TestCase::CreateTestIsolateFromSnapshot(snapshot);
+  Dart_EnterScope();
+  Dart_Handle result =
+      Dart_Invoke(TestCase::lib(), NewString(function), 0, nullptr);
+  EXPECT_VALID(result);
+  const char* value = nullptr;
+  EXPECT_VALID(Dart_StringToCString(result, &value));
+  char* copy = Utils::StrDup(value);
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+  return copy;
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotParallelFill) {
+  const char* kScriptChars = R"(
+    class Point {
+      final int x;
+      final double y;
+      const Point(this.x, this.y);
+      String toString() => 'Point($x, $y)';
+    }
+
+    const data = <Object?>[
+      'one', 'two', 'thrée', '\u{1F600}',
+      1, -2, 0x7fffffffffffffff, 1.5, -0.25, double.infinity,
+      null, true, false,
+      <int>[1, 2, 3], <String, int>{'a': 1, 'b': 2},
+      Point(3, 4.5), Point(-1, 0.0),
+      (1, 'record'), #symbol,
+    ];
+
+    @pragma('vm:entry-point', 'call')
+    String summary() {
+      final buffer = StringBuffer();
+      for (final value in data) {
+        buffer.write('$value;');
+      }
+      buffer.write(identical(data[15], const Point(3, 4.5)));
+      return buffer.toString();
+    }
+  )";
+
+  uint8_t* isolate_snapshot_data_buffer;
+  char* expected;
+  {
+    TestIsolateScope __test_isolate__;
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+    {
+      Dart_EnterScope();
+      Dart_Handle result = Dart_Invoke(lib, NewString("summary"), 0, nullptr);
+      EXPECT_VALID(result);
+      const char* value = nullptr;
+      EXPECT_VALID(Dart_StringToCString(result, &value));
+      expected = Utils::StrDup(value);
+      Dart_ExitScope();
+    }
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+
+    MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+    FullSnapshotWriter writer(Snapshot::kFull, &isolate_snapshot_data,
+                              /*image_writer=*/nullptr);
+    writer.WriteFullSnapshot();
+    intptr_t unused;
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&unused);
+  }
+
+  char* sequential;
+  {
+    SetFlagScope<int> tasks(&FLAG_snapshot_fill_tasks, 0);
+    sequential = LoadSnapshotAndInvoke(isolate_snapshot_data_buffer, "summary");
+  }
+  char* parallel;
+  {
+    // Every cluster that can be filled in parallel is.
+    SetFlagScope<int> tasks(&FLAG_snapshot_fill_tasks, 4);
+    SetFlagScope<int> min_bytes(&FLAG_snapshot_parallel_fill_min_bytes, 0);
+    parallel = LoadSnapshotAndInvoke(isolate_snapshot_data_buffer, "summary");
+  }
+  EXPECT_STREQ(expected, sequential);
+  EXPECT_STREQ(expected, parallel);
+
+  free(expected);
+  free(sequential);
+  free(parallel);
+  free(isolate_snapshot_data_buffer);
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotRegExp) {
+  const char* kScriptChars = R"(
+    RegExp? re;
+
+    @pragma('vm:entry-point', 'call')
+    void init() {
+      re = RegExp(r'(a)(b)?(c)');
+      re!.firstMatch('xabc');
+    }
+
+    @pragma('vm:entry-point', 'call')
+    int groupCount() => re!.groupCount;
+
+    @pragma('vm:entry-point', 'call')
+    String? secondGroup() => re!.firstMatch('xxabc')!.group(2);
+  )";
+
+  uint8_t* isolate_snapshot_data_buffer;
+  {
+    TestIsolateScope __test_isolate__;
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+    EXPECT_VALID(Dart_Invoke(lib, NewString("init"), 0, nullptr));
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+
+    // The regexp has bytecode, so its group count is not recomputed when it
+    // is used after loading.
+    const auto& library =
+        Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+    const auto& field = Field::Handle(
+        library.LookupFieldAllowPrivate(String::Handle(String::New("re"))));
+    const auto& regexp = RegExp::Handle(RegExp::RawCast(field.StaticValue()));
+    EXPECT_EQ(3, regexp.num_bracket_expressions());
+    EXPECT(regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false) !=
+           TypedData::null());
+    // Full snapshots contain the initial values of static fields only.
+    thread->isolate_group()->initial_field_table()->SetAt(field.field_id(),
+                                                          regexp.ptr());
+
+    MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+    FullSnapshotWriter writer(Snapshot::kFull, &isolate_snapshot_data,
+                              /*image_writer=*/nullptr);
+    writer.WriteFullSnapshot();
+    intptr_t unused;
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&unused);
+  }
+
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  {
+    Dart_EnterScope();
+    Dart_Handle result =
+        Dart_Invoke(TestCase::lib(), NewString("groupCount"), 0, nullptr);
+    EXPECT_VALID(result);
+    int64_t group_count = 0;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &group_count));
+    EXPECT_EQ(3, group_count);
+
+    result = Dart_Invoke(TestCase::lib(), NewString("secondGroup"), 0, nullptr);
+    EXPECT_VALID(result);
+    const char* second_group = nullptr;
+    EXPECT_VALID(Dart_StringToCString(result, &second_group));
+    EXPECT_STREQ("b", second_group);
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(isolate_snapshot_data_buffer);
+}
+
 // Helper function to call a top level Dart function and serialize the result.
 static std::unique_ptr<Message> GetSerialized(Dart_Handle lib,
                                               const char* dart_function) {
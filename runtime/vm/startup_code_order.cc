@@ -0,0 +1,150 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/startup_code_order.h"
+
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/hash_map.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+DEFINE_FLAG(charp,
+            write_startup_code_order_to,
+            nullptr,
+            "Write the names of functions in the order of their first "
+            "execution to the given file, for use with --startup_code_order.");
+
+static Mutex* startup_order_mutex = new Mutex();
+static void* startup_order_file = nullptr;
+static bool startup_order_file_failed = false;
+
+bool StartupCodeOrder::IsRecording() {
+  return FLAG_write_startup_code_order_to != nullptr;
+}
+
+const char* StartupCodeOrder::KeyOf(const Function& function) {
+  return OS::SCreate(Thread::Current()->zone(), "%s %s %" Pd32,
+                     function.ToFullyQualifiedCString(),
+                     Function::KindToCString(function.kind()),
+                     function.token_pos().Serialize());
+}
+
+void StartupCodeOrder::RecordFirstExecution(const Function& function) {
+  if (!IsRecording()) return;
+  const char* name = KeyOf(function);
+
+  MutexLocker ml(startup_order_mutex);
+  if (startup_order_file_failed) return;
+  auto file_write = Dart::file_write_callback();
+  if (startup_order_file == nullptr) {
+    auto file_open = Dart::file_open_callback();
+    if (file_open != nullptr && file_write != nullptr) {
+      startup_order_file = file_open(FLAG_write_startup_code_order_to,
+                                     /*write=*/true);
+    }
+    if (startup_order_file == nullptr) {
+      OS::PrintErr("warning: Failed to write startup code order: %s\n",
+                   FLAG_write_startup_code_order_to);
+      startup_order_file_failed = true;
+      return;
+    }
+  }
+  // Written as functions are encountered, so the order is preserved even if
+  // the training run exits without shutting down the VM.
+  file_write(name, strlen(name), startup_order_file);
+  file_write("\n", 1, startup_order_file);
+}
+
+#else
+
+bool StartupCodeOrder::IsRecording() {
+  return false;
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if defined(DART_PRECOMPILER)
+
+DEFINE_FLAG(charp,
+            startup_code_order,
+            nullptr,
+            "Place the instructions of the functions listed in the given file "
+            "(see --write_startup_code_order_to) at the start of the text "
+            "section, in the order they are listed.");
+DEFINE_FLAG(bool,
+            trace_startup_code_order,
+            false,
+            "Print how many bytes at the start of the text section hold the "
+            "code listed in --startup_code_order, the value to pass to "
+            "--prefetch_snapshot_text.");
+
+using StartupRanks = MallocDirectChainedHashMap<CStringIntMapKeyValueTrait>;
+
+static StartupRanks* LoadStartupRanks() {
+  static StartupRanks* ranks = nullptr;
+  if (ranks != nullptr) return ranks;
+  ranks = new StartupRanks();
+
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return ranks;
+  }
+  void* file = file_open(FLAG_startup_code_order, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read startup code order: %s\n",
+                 FLAG_startup_code_order);
+    return ranks;
+  }
+  uint8_t* buffer = nullptr;
+  intptr_t length = 0;
+  file_read(&buffer, &length, file);
+  file_close(file);
+  if (buffer == nullptr) return ranks;
+
+  intptr_t rank = 0;
+  const char* const end = reinterpret_cast<const char*>(buffer) + length;
+  for (const char* line = reinterpret_cast<const char*>(buffer); line < end;) {
+    const char* line_end =
+        reinterpret_cast<const char*>(memchr(line, '\n', end - line));
+    if (line_end == nullptr) line_end = end;
+    if (line_end > line) {
+      char* name = Utils::StrNDup(line, line_end - line);
+      // Keep the first occurrence if a function was recorded more than once.
+      if (ranks->LookupValue(name) == CStringIntMapKeyValueTrait::kNoValue) {
+        ranks->Insert({name, rank++});
+      } else {
+        free(name);
+      }
+    }
+    line = line_end + 1;
+  }
+  free(buffer);
+  return ranks;
+}
+
+bool StartupCodeOrder::IsEnabled() {
+  return FLAG_startup_code_order != nullptr;
+}
+
+intptr_t StartupCodeOrder::RankOf(const Function& function) {
+  if (!IsEnabled()) return kNotInStartupOrder;
+  const intptr_t rank =
+      LoadStartupRanks()->LookupValue(KeyOf(function));
+  return rank == CStringIntMapKeyValueTrait::kNoValue ? kNotInStartupOrder
+                                                      : rank;
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -0,0 +1,56 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_STARTUP_CODE_ORDER_H_
+#define RUNTIME_VM_STARTUP_CODE_ORDER_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class Function;
+
+// Order in which functions are executed for the first time during startup.
+//
+// A training run in JIT mode with --write_startup_code_order_to=<file> appends
+// the key of every function when it is compiled for the first time. Functions
+// are compiled lazily on their first call, so the file lists functions in the
+// order of their first execution. Code loaded from an app-jit snapshot is not
+// used during training, so those functions are compiled and recorded as well.
+//
+// gen_snapshot --startup_code_order=<file> places the instructions of the
+// listed functions at the start of the text section in that order, so the
+// code executed during startup occupies a dense prefix of the image instead of
+// being scattered over all of it.
+class StartupCodeOrder : public AllStatic {
+ public:
+  static constexpr intptr_t kNotInStartupOrder = kIntptrMax;
+
+  // Whether a training run records the order (--write_startup_code_order_to).
+  static bool IsRecording();
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Records [function], which is about to be compiled for the first time.
+  static void RecordFirstExecution(const Function& function);
+
+  // The key identifying [function] in the order file: its fully qualified
+  // name, kind and source position, which tell apart closures within the
+  // same function and are the same in JIT and AOT compilations of a program.
+  static const char* KeyOf(const Function& function);
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if defined(DART_PRECOMPILER)
+  // Whether an order was given with --startup_code_order.
+  static bool IsEnabled();
+
+  // Returns the position of [function] in the startup order, or
+  // kNotInStartupOrder if it was not executed during the training run.
+  static intptr_t RankOf(const Function& function);
+#endif  // defined(DART_PRECOMPILER)
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_STARTUP_CODE_ORDER_H_
@@ -452,6 +452,7 @@ namespace dart {
   V(_handleException, "_handleException")                                      \
   V(_handleFinalizerMessage, "_handleFinalizerMessage")                        \
   V(_handleMessage, "_handleMessage")                                          \
+  V(_handleMessageWithoutMicrotasks, "_handleMessageWithoutMicrotasks")        \
   V(_handleNativeFinalizerMessage, "_handleNativeFinalizerMessage")            \
   V(_hasValue, "_hasValue")                                                    \
   V(_initAsync, "_initAsync")                                                  \
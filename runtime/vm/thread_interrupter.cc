@@ -38,8 +38,23 @@ namespace dart {
 // The ThreadInterrupter has a single monitor (monitor_). This monitor is used
 // to synchronize startup, shutdown, and waking up from a deep sleep.
 //
+// With --profiler_cpu_time_timers on Linux there is no interrupter thread.
+// Instead every thread gets a timer which sends it SIGPROF each time it has
+// consumed an interrupt period of CPU time, so idle threads are never
+// interrupted and busy threads are sampled in proportion to the CPU they use.
+// The timer is created when the thread first enables interrupts while the
+// profiler is running, and deleted when the profiler stops or the thread
+// exits.
+//
 
 DEFINE_FLAG(bool, trace_thread_interrupter, false, "Trace thread interrupter");
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+DEFINE_FLAG(bool,
+            profiler_cpu_time_timers,
+            false,
+            "Interrupt threads for sampling with per-thread CPU time timers "
+            "instead of a central interrupter thread.");
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
 
 bool ThreadInterrupter::initialized_ = false;
 bool ThreadInterrupter::shutdown_ = false;
@@ -50,6 +65,9 @@ ThreadJoinId ThreadInterrupter::interrupter_thread_id_ =
 Monitor* ThreadInterrupter::monitor_ = nullptr;
 intptr_t ThreadInterrupter::interrupt_period_ = 1000;
 intptr_t ThreadInterrupter::current_wait_time_ = Monitor::kNoTimeout;
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+bool ThreadInterrupter::use_cpu_time_timers_ = false;
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
 
 void ThreadInterrupter::Init() {
   ASSERT(!initialized_);
@@ -74,6 +92,24 @@ void ThreadInterrupter::Startup() {
   {
     MonitorLocker startup_ml(monitor_);
     shutdown_ = false;
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+    use_cpu_time_timers_ = FLAG_profiler_cpu_time_timers;
+    if (use_cpu_time_timers_) {
+      InstallSignalHandler();
+      // Threads enabling interrupts later start their timers in |WakeUp|.
+      OSThreadIterator it;
+      while (it.HasNext()) {
+        OSThread* thread = it.Next();
+        if (thread->ThreadInterruptsEnabled()) {
+          StartCpuTimeTimer(thread);
+        }
+      }
+      if (FLAG_trace_thread_interrupter) {
+        OS::PrintErr("ThreadInterrupter running with CPU time timers.\n");
+      }
+      return;
+    }
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
     OSThread::Start("Dart Profiler ThreadInterrupter", ThreadMain, 0);
     while (!thread_running_) {
       startup_ml.Wait();
@@ -93,6 +129,19 @@ void ThreadInterrupter::Shutdown() {
       return;
     }
     shutdown_ = true;
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+    if (use_cpu_time_timers_) {
+      OSThreadIterator it;
+      while (it.HasNext()) {
+        StopCpuTimeTimer(it.Next());
+      }
+      RemoveSignalHandler();
+      if (FLAG_trace_thread_interrupter) {
+        OS::PrintErr("ThreadInterrupter shut down.\n");
+      }
+      return;
+    }
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
     // Notify.
     shutdown_ml.Notify();
     ASSERT(initialized_);
@@ -119,7 +168,23 @@ void ThreadInterrupter::SetInterruptPeriod(intptr_t period) {
     return;
   }
   MonitorLocker ml(monitor_);
+  if (interrupt_period_ == period) {
+    return;
+  }
   interrupt_period_ = period;
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+  if (use_cpu_time_timers_ && !shutdown_) {
+    // Recreate the running timers with the new period.
+    OSThreadIterator it;
+    while (it.HasNext()) {
+      OSThread* thread = it.Next();
+      if (thread->has_cpu_time_timer_) {
+        StopCpuTimeTimer(thread);
+        StartCpuTimeTimer(thread);
+      }
+    }
+  }
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
 }
 
 void ThreadInterrupter::WakeUp() {
@@ -137,6 +202,13 @@ void ThreadInterrupter::WakeUp() {
       // Early call.
       return;
     }
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+    if (use_cpu_time_timers_) {
+      // Called by a thread which just enabled interrupts.
+      StartCpuTimeTimer(OSThread::Current());
+      return;
+    }
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
     woken_up_ = true;
     if (!InDeepSleep()) {
       // No need to notify, regularly waking up.
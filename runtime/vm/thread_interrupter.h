@@ -40,12 +40,22 @@ class ThreadInterrupter : public AllStatic {
   // |ThreadInterrupter::initialized_| is false.
   static void SetInterruptPeriod(intptr_t period);
 
-  // Wake up the thread interrupter thread.
+  // Wake up the thread interrupter thread. Called by a thread which just
+  // enabled interrupts.
   static void WakeUp();
 
   // Interrupt a thread.
   static void InterruptThread(OSThread* thread);
 
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+  // Whether threads are interrupted by timers measuring their own CPU time
+  // instead of by the interrupter thread.
+  static bool UsesCpuTimeTimers() { return use_cpu_time_timers_; }
+
+  // Deletes the CPU time timer of |thread|, if any.
+  static void StopCpuTimeTimer(OSThread* thread);
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
+
  private:
   static constexpr intptr_t kMaxThreads = 4096;
   static bool initialized_;
@@ -63,6 +73,14 @@ class ThreadInterrupter : public AllStatic {
 
   static void ThreadMain(uword parameters);
 
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+  static bool use_cpu_time_timers_;
+
+  // Creates the timer interrupting |thread| every |interrupt_period_| of CPU
+  // time it consumes, unless it already has one.
+  static void StartCpuTimeTimer(OSThread* thread);
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
+
   static void InstallSignalHandler();
 
   static void RemoveSignalHandler();
@@ -5,7 +5,9 @@
 #include "platform/globals.h"
 #if defined(DART_HOST_OS_LINUX)
 
-#include <errno.h>  // NOLINT
+#include <errno.h>   // NOLINT
+#include <signal.h>  // NOLINT
+#include <time.h>    // NOLINT
 
 #include "vm/flags.h"
 #include "vm/os.h"
@@ -112,6 +114,56 @@ void ThreadInterrupter::InterruptThread(OSThread* thread) {
   ASSERT((result == 0) || (result == ESRCH));
 }
 
+#if defined(DART_SUPPORT_CPU_TIME_TIMERS)
+// Older C libraries do not name the target thread of SIGEV_THREAD_ID.
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+void ThreadInterrupter::StartCpuTimeTimer(OSThread* thread) {
+  ASSERT(monitor_->IsOwnedByCurrentThread());
+  if (thread->has_cpu_time_timer_) {
+    return;
+  }
+  clockid_t clock;
+  if (pthread_getcpuclockid(thread->id(), &clock) != 0) {
+    return;
+  }
+  struct sigevent event = {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = thread->trace_id();
+  if (timer_create(clock, &event, &thread->cpu_time_timer_) != 0) {
+    if (FLAG_trace_thread_interrupter) {
+      OS::PrintErr("ThreadInterrupter failed to create timer for %p: %d\n",
+                   reinterpret_cast<void*>(thread->id()), errno);
+    }
+    return;
+  }
+  struct itimerspec period = {};
+  period.it_interval.tv_sec = interrupt_period_ / kMicrosecondsPerSecond;
+  period.it_interval.tv_nsec =
+      (interrupt_period_ % kMicrosecondsPerSecond) * kNanosecondsPerMicrosecond;
+  period.it_value = period.it_interval;
+  int result = timer_settime(thread->cpu_time_timer_, 0, &period, nullptr);
+  ASSERT(result == 0);
+  thread->has_cpu_time_timer_ = true;
+  if (FLAG_trace_thread_interrupter) {
+    OS::PrintErr("ThreadInterrupter started timer for %p\n",
+                 reinterpret_cast<void*>(thread->id()));
+  }
+}
+
+void ThreadInterrupter::StopCpuTimeTimer(OSThread* thread) {
+  if (!thread->has_cpu_time_timer_) {
+    return;
+  }
+  int result = timer_delete(thread->cpu_time_timer_);
+  ASSERT(result == 0);
+  thread->has_cpu_time_timer_ = false;
+}
+#endif  // defined(DART_SUPPORT_CPU_TIME_TIMERS)
+
 void ThreadInterrupter::InstallSignalHandler() {
   SignalHandler::Install(&ThreadInterrupterLinux::ThreadInterruptSignalHandler);
   SignalState::Enable();
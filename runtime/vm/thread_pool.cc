@@ -35,7 +35,9 @@ static int64_t ComputeTimeout(int64_t idle_start) {
 }
 
 ThreadPool::ThreadPool(uintptr_t max_pool_size)
-    : all_workers_dead_(false), max_pool_size_(max_pool_size) {}
+    : pool_mutex_("ThreadPool::pool_mutex_"),
+      all_workers_dead_(false),
+      max_pool_size_(max_pool_size) {}
 
 ThreadPool::~ThreadPool() {
   Shutdown();
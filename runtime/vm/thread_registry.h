@@ -23,7 +23,7 @@ class JSONArray;
 class ThreadRegistry {
  public:
   ThreadRegistry()
-      : threads_lock_(),
+      : threads_lock_("ThreadRegistry::threads_lock_"),
         active_list_(nullptr),
         free_list_(nullptr),
         active_isolates_count_(0) {}
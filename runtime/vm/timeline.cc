@@ -1419,24 +1419,44 @@ TimelineEvent* TimelineEventRecorder::ThreadBlockStartEvent() {
   // Grab the current thread.
   OSThread* thread = OSThread::Current();
   ASSERT(thread != nullptr);
+  Mutex* thread_block_lock = thread->timeline_block_lock();
+  ASSERT(thread_block_lock != nullptr);
+#if defined(DEBUG)
+  Thread* T = Thread::Current();
+#endif  // defined(DEBUG)
+
+  // Fast path: the thread has a block with space left. Only the thread's own
+  // block lock is needed, because other threads take it before taking the
+  // block away from this thread, so events are recorded without contention.
+  thread_block_lock->Lock();
+  TimelineEventBlock* thread_block = thread->TimelineBlockLocked();
+  if ((thread_block != nullptr) && !thread_block->IsFull()) {
+#if defined(DEBUG)
+    if (T != nullptr) {
+      T->IncrementNoSafepointScopeDepth();
+    }
+#endif  // defined(DEBUG)
+    // NOTE: We are exiting this function with the thread's block lock held.
+    return thread_block->StartEventLocked();
+  }
+  thread_block_lock->Unlock();
+
   // Acquire the recorder lock in case we need to call |GetNewBlockLocked|. We
   // acquire the lock here and not directly before calls to |GetNewBlockLocked|
   // due to locking order restrictions.
   Mutex& recorder_lock = lock_;
   recorder_lock.Lock();
-  Mutex* thread_block_lock = thread->timeline_block_lock();
-  ASSERT(thread_block_lock != nullptr);
   // We are accessing the thread's timeline block- so take the lock here.
   // This lock will be held until the call to |CompleteEvent| is made.
   thread_block_lock->Lock();
 #if defined(DEBUG)
-  Thread* T = Thread::Current();
   if (T != nullptr) {
     T->IncrementNoSafepointScopeDepth();
   }
 #endif  // defined(DEBUG)
 
-  TimelineEventBlock* thread_block = thread->TimelineBlockLocked();
+  // The block may have changed while no lock was held.
+  thread_block = thread->TimelineBlockLocked();
 
   if ((thread_block != nullptr) && thread_block->IsFull()) {
     // Thread has a block and it is full:
@@ -2154,9 +2174,7 @@ void TimelineEventFileRecorderBase::DrainBlockChain(TimelineEventBlock* block) {
     auto next_block = block->next();
     block->set_next(nullptr);
 
-    for (intptr_t i = 0, length = block->length(); i < length; i++) {
-      DrainImpl(*block->At(i));
-    }
+    DrainBlockImpl(*block);
     block->Reset();
 
     // Place block for reuse.
@@ -2169,6 +2187,13 @@ void TimelineEventFileRecorderBase::DrainBlockChain(TimelineEventBlock* block) {
   }
 }
 
+void TimelineEventFileRecorderBase::DrainBlockImpl(
+    const TimelineEventBlock& block) {
+  for (intptr_t i = 0, length = block.length(); i < length; i++) {
+    DrainImpl(*block.At(i));
+  }
+}
+
 void TimelineEventFileRecorderBase::FlushBuffer() {
   if (buffer_pos_ != 0) {
     WriteToFile(buffer_.get(), buffer_pos_);
@@ -2341,6 +2366,7 @@ class TimelineEventPerfettoFileRecorder
  private:
   void WritePacket(
       protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>* packet);
+  void DrainBlockImpl(const TimelineEventBlock& block) final;
   void DrainImpl(const TimelineEvent& event) final;
 
   void EmitModuleSymbolsFor(IsolateGroup* isolate_group);
@@ -2566,6 +2592,24 @@ void TimelineEventPerfettoFileRecorder::WritePacket(
   }
 }
 
+void TimelineEventPerfettoFileRecorder::DrainBlockImpl(
+    const TimelineEventBlock& block) {
+  // Take |writer_mutex_| once per block rather than once per event.
+  {
+    MutexLocker lock(&writer_mutex_);
+    for (intptr_t i = 0, length = block.length(); i < length; i++) {
+      writer_.WriteEvent(*block.At(i));
+    }
+  }
+  for (intptr_t i = 0, length = block.length(); i < length; i++) {
+    const TimelineEvent& event = *block.At(i);
+    if (event.event_type() == TimelineEvent::kAsyncBegin ||
+        event.event_type() == TimelineEvent::kAsyncInstant) {
+      AddAsyncTrackMetadataBasedOnEvent(event);
+    }
+  }
+}
+
 void TimelineEventPerfettoFileRecorder::DrainImpl(const TimelineEvent& event) {
   {
     MutexLocker lock(&writer_mutex_);
@@ -1389,6 +1389,8 @@ class TimelineEventFileRecorderBase : public TimelineEventRecorder {
 
   void DrainBlockChain(TimelineEventBlock* block);
 
+  // Writes all events of |block|. By default calls |DrainImpl| for each event.
+  virtual void DrainBlockImpl(const TimelineEventBlock& block);
   virtual void DrainImpl(const TimelineEvent& event) = 0;
 
   Monitor monitor_;
@@ -446,6 +446,85 @@ TEST_CASE(TimelineRingRecorderRace) {
   OSThread::Join(report_events_2_arguments.join_id);
 }
 
+TEST_CASE(TimelineRecorderFastPathWithoutRecorderLock) {
+  struct HoldRecorderLockArguments {
+    Monitor& synchronization_monitor;
+    Mutex& recorder_lock;
+    bool locked = false;
+    bool recorded = false;
+    bool timed_out = false;
+    ThreadJoinId join_id = OSThread::kInvalidThreadJoinId;
+  };
+
+  TimelineEventRingRecorder* recorder =
+      new TimelineEventRingRecorder(2 * TimelineEventBlock::kBlockSize);
+  TimelineRecorderOverride<TimelineEventRingRecorder> override(recorder);
+  // Start without a block cached on this thread.
+  Timeline::Clear();
+
+  // The first event takes a block from the recorder.
+  TimelineTestHelper::FakeDuration(recorder, "first", /*start=*/0, /*end=*/1);
+
+  // The next event goes into that block while another thread holds the
+  // recorder lock. If recording it took the lock, it would only be recorded
+  // once the other thread gives up waiting for it.
+  Monitor synchronization_monitor;
+  HoldRecorderLockArguments arguments{
+      synchronization_monitor, TimelineTestHelper::GetRecorderLock(*recorder)};
+  OSThread::Start(
+      "HoldRecorderLock",
+      [](uword arguments_ptr) {
+        HoldRecorderLockArguments& arguments =
+            *reinterpret_cast<HoldRecorderLockArguments*>(arguments_ptr);
+        arguments.recorder_lock.Lock();
+        {
+          MonitorLocker ml(&arguments.synchronization_monitor);
+          arguments.locked = true;
+          ml.Notify();
+          const int64_t deadline = OS::GetCurrentMonotonicMicros() +
+                                   10 * kMicrosecondsPerSecond;
+          while (!arguments.recorded) {
+            const int64_t remaining =
+                deadline - OS::GetCurrentMonotonicMicros();
+            if ((remaining <= 0) ||
+                (ml.WaitMicros(remaining) == Monitor::kTimedOut)) {
+              arguments.timed_out = !arguments.recorded;
+              break;
+            }
+          }
+        }
+        arguments.recorder_lock.Unlock();
+        MonitorLocker ml(&arguments.synchronization_monitor);
+        arguments.join_id =
+            OSThread::GetCurrentThreadJoinId(OSThread::Current());
+        ml.Notify();
+      },
+      reinterpret_cast<uword>(&arguments));
+  {
+    MonitorLocker ml(&synchronization_monitor);
+    while (!arguments.locked) {
+      ml.Wait();
+    }
+  }
+  TimelineTestHelper::FakeDuration(recorder, "second", /*start=*/1, /*end=*/2);
+  {
+    MonitorLocker ml(&synchronization_monitor);
+    arguments.recorded = true;
+    ml.Notify();
+    while (arguments.join_id == OSThread::kInvalidThreadJoinId) {
+      ml.Wait();
+    }
+  }
+  OSThread::Join(arguments.join_id);
+  EXPECT(!arguments.timed_out);
+
+  JSONStream js;
+  TimelineEventFilter filter;
+  recorder->PrintJSON(&js, &filter);
+  EXPECT_SUBSTRING("\"first\"", js.ToCString());
+  EXPECT_SUBSTRING("\"second\"", js.ToCString());
+}
+
 // |OSThread::Start()| takes in a function pointer, and only lambdas that don't
 // capture can be converted to function pointers. So, we use these macros to
 // avoid needing to capture.
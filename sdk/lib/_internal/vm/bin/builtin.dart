@@ -597,6 +597,9 @@ _setupHooks() {
   VMLibraryHooks.resolvePackageUriSync = _resolvePackageUriSync;
 }
 
+// Embedder Entrypoint (see --incremental-snapshot):
+// Returns the resolved packages config, if any.
+@pragma("vm:entry-point")
 Uri? _getPackageConfigSync() {
   if (_traceLoading) {
     _log("Request for package config from user code.");
@@ -194,6 +194,18 @@ final class _RawReceivePort implements RawReceivePort {
     return handler;
   }
 
+  // Called from the VM to dispatch a message when it drains the microtask
+  // queue itself, to time the draining separately.
+  @pragma("vm:entry-point", "call")
+  static _handleMessageWithoutMicrotasks(int id, message) {
+    final Function? handler = _portMap[id]?._handler;
+    if (handler == null) {
+      return null;
+    }
+    handler(message);
+    return handler;
+  }
+
   // Call into the VM to close the VM maintained mappings.
   @pragma("vm:external-name", "RawReceivePort_closeInternal")
   external int _closeInternal();
@@ -80,17 +80,17 @@ class RegExp {
 }
 
 class _RegExpMatch implements RegExpMatch {
-  _RegExpMatch._(this._regexp, this.input, this._match);
+  _RegExpMatch._(this._regexp, this.input, this._match, [this._offset = 0]);
 
   int get start => _start(0);
   int get end => _end(0);
 
   int _start(int groupIdx) {
-    return _match[(groupIdx * _MATCH_PAIR)];
+    return _match[_offset + (groupIdx * _MATCH_PAIR)];
   }
 
   int _end(int groupIdx) {
-    return _match[(groupIdx * _MATCH_PAIR) + 1];
+    return _match[_offset + (groupIdx * _MATCH_PAIR) + 1];
   }
 
   String? group(int groupIdx) {
@@ -160,6 +160,9 @@ class _RegExpMatch implements RegExpMatch {
   final RegExp _regexp;
   final String input;
   final Int32List _match;
+  // Index of this match's offsets in [_match], which may hold several matches
+  // found by [_RegExp._ExecuteMatchGlobal].
+  final int _offset;
   static const int _MATCH_PAIR = 2;
 }
 
@@ -244,6 +247,19 @@ class _RegExp implements RegExp {
 
   @pragma("vm:external-name", "RegExp_ExecuteMatchSticky")
   external Int32List? _ExecuteMatchSticky(String str, int start_index);
+
+  /// Finds successive matches in [str] from [start_index], continuing after
+  /// each match like [_AllMatchesIterator] does, and stores the group offsets
+  /// of each into [matches] until it is full.
+  ///
+  /// Returns the number of matches stored. Each match takes
+  /// `(_groupCount + 1) * 2` elements of [matches].
+  @pragma("vm:external-name", "RegExp_ExecuteMatchGlobal")
+  external int _ExecuteMatchGlobal(
+    String str,
+    int start_index,
+    Int32List matches,
+  );
 }
 
 class _AllMatchesIterable extends Iterable<RegExpMatch> {
@@ -262,6 +278,20 @@ class _AllMatchesIterator implements Iterator<RegExpMatch> {
   _RegExp? _re;
   RegExpMatch? _current;
 
+  // Matches found ahead of [_nextIndex] by the last batch search. The batch
+  // is not reused, as the returned matches refer to it.
+  Int32List? _batch;
+  int _batchStride = 0;
+  int _batchOffset = 0;
+  int _batchRemaining = 0;
+  // Number of matches to search for in the next batch, 0 before the first
+  // match. Doubles up to [_maxBatchSize] so that callers which stop early
+  // don't search much further than they need.
+  int _batchSize = 0;
+
+  static const int _initialBatchSize = 2;
+  static const int _maxBatchSize = 64;
+
   _AllMatchesIterator(this._re, this._str, this._nextIndex);
 
   RegExpMatch get current => _current as RegExpMatch;
@@ -278,9 +308,8 @@ class _AllMatchesIterator implements Iterator<RegExpMatch> {
     final re = _re;
     if (re == null) return false; // Cleared after a failed match.
     if (_nextIndex <= _str.length) {
-      final match = re._ExecuteMatch(_str, _nextIndex);
-      if (match != null) {
-        var current = _RegExpMatch._(re, _str, match);
+      final current = _nextMatch(re);
+      if (current != null) {
         _current = current;
         _nextIndex = current.end;
         if (_nextIndex == current.start) {
@@ -300,6 +329,33 @@ class _AllMatchesIterator implements Iterator<RegExpMatch> {
     }
     _current = null;
     _re = null;
+    _batch = null;
     return false;
   }
+
+  _RegExpMatch? _nextMatch(_RegExp re) {
+    if (_batchRemaining > 0) {
+      final match = _RegExpMatch._(re, _str, _batch!, _batchOffset);
+      _batchOffset += _batchStride;
+      _batchRemaining--;
+      return match;
+    }
+    if (_batchSize == 0) {
+      // Most callers only look at the first match, which also compiles the
+      // regexp and determines its group count.
+      _batchSize = _initialBatchSize;
+      final match = re._ExecuteMatch(_str, _nextIndex);
+      return (match == null) ? null : _RegExpMatch._(re, _str, match);
+    }
+    final stride = (re._groupCount + 1) * _RegExpMatch._MATCH_PAIR;
+    final matches = Int32List(_batchSize * stride);
+    final count = re._ExecuteMatchGlobal(_str, _nextIndex, matches);
+    if (_batchSize < _maxBatchSize) _batchSize *= 2;
+    if (count == 0) return null;
+    _batch = matches;
+    _batchStride = stride;
+    _batchOffset = stride;
+    _batchRemaining = count - 1;
+    return _RegExpMatch._(re, _str, matches);
+  }
 }